@@ -0,0 +1,43 @@
+#ifndef LINALG_BENCH_BENCH_H
+#define LINALG_BENCH_BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define BENCH_MAX_REPETITIONS 1000UL
+#define BENCH_MAX_NAME 64UL
+
+typedef struct {
+    char name[BENCH_MAX_NAME];
+    size_t size;
+    size_t iterations;
+    size_t repetitions;
+    double samples[BENCH_MAX_REPETITIONS];
+    double median_ns;
+    double p99_ns;
+    double min_ns;
+    double gflops;
+    double gbps;
+} bench_result_t;
+
+bool bench_baseline_load(char const* path,
+                         bench_result_t** baseline,
+                         size_t* baseline_num);
+
+double bench_median(double const* samples, size_t samples_num);
+
+double bench_mann_whitney(double const* samples1,
+                          size_t samples1_num,
+                          double const* samples2,
+                          size_t samples2_num);
+
+bool bench_compare(FILE* file,
+                   bench_result_t const* baseline,
+                   size_t baseline_num,
+                   bench_result_t const* results,
+                   size_t results_num,
+                   double threshold,
+                   double alpha);
+
+#endif // LINALG_BENCH_BENCH_H
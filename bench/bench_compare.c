@@ -0,0 +1,347 @@
+#include "bench.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    double value;
+    size_t group;
+} bench_rank_t;
+
+static int bench_compare_ranks(void const* left, void const* right)
+{
+    double a = ((bench_rank_t const*)left)->value;
+    double b = ((bench_rank_t const*)right)->value;
+
+    return (a > b) - (a < b);
+}
+
+static int bench_compare_doubles(void const* left, void const* right)
+{
+    double a = *(double const*)left;
+    double b = *(double const*)right;
+
+    return (a > b) - (a < b);
+}
+
+static char* bench_read_file(char const* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    if (fseek(file, 0L, SEEK_END) != 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    long length = ftell(file);
+    if (length < 0L || fseek(file, 0L, SEEK_SET) != 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    char* text = malloc((size_t)length + 1UL);
+    if (text == NULL) {
+        fclose(file);
+        return NULL;
+    }
+
+    size_t read = fread(text, 1UL, (size_t)length, file);
+    fclose(file);
+
+    text[read] = '\0';
+
+    return text;
+}
+
+static char const* bench_parse_name(char const* cursor,
+                                    char (*name)[BENCH_MAX_NAME])
+{
+    cursor = strstr(cursor, "\"name\": \"");
+    if (cursor == NULL) {
+        return NULL;
+    }
+
+    cursor += strlen("\"name\": \"");
+
+    char const* end = strchr(cursor, '"');
+    if (end == NULL || (size_t)(end - cursor) >= BENCH_MAX_NAME) {
+        return NULL;
+    }
+
+    memcpy(*name, cursor, (size_t)(end - cursor));
+    (*name)[end - cursor] = '\0';
+
+    return end + 1;
+}
+
+static char const* bench_parse_size(char const* cursor,
+                                    char const* key,
+                                    size_t* value)
+{
+    cursor = strstr(cursor, key);
+    if (cursor == NULL) {
+        return NULL;
+    }
+
+    char* end;
+    *value = strtoul(cursor + strlen(key), &end, 10);
+
+    return end;
+}
+
+static char const* bench_parse_samples(char const* cursor,
+                                       bench_result_t* result)
+{
+    cursor = strstr(cursor, "\"samples_ns\": [");
+    if (cursor == NULL) {
+        return NULL;
+    }
+
+    cursor += strlen("\"samples_ns\": [");
+    result->repetitions = 0UL;
+
+    while (*cursor != ']' && *cursor != '\0') {
+        char* end;
+        double sample = strtod(cursor, &end);
+        if (end == cursor) {
+            return NULL;
+        }
+
+        if (result->repetitions < BENCH_MAX_REPETITIONS) {
+            result->samples[result->repetitions++] = sample;
+        }
+
+        cursor = end;
+        while (*cursor == ',' || *cursor == ' ') {
+            ++cursor;
+        }
+    }
+
+    return *cursor == ']' ? cursor + 1 : NULL;
+}
+
+bool bench_baseline_load(char const* path,
+                         bench_result_t** baseline,
+                         size_t* baseline_num)
+{
+    char* text = bench_read_file(path);
+    if (text == NULL) {
+        return false;
+    }
+
+    size_t capacity = 0UL;
+    for (char const* cursor = strstr(text, "\"name\""); cursor != NULL;
+         cursor = strstr(cursor + 1, "\"name\"")) {
+        ++capacity;
+    }
+
+    *baseline = calloc(capacity == 0UL ? 1UL : capacity, sizeof(**baseline));
+    *baseline_num = 0UL;
+    if (*baseline == NULL) {
+        free(text);
+        return false;
+    }
+
+    char const* cursor = text;
+    while (*baseline_num < capacity) {
+        bench_result_t* result = &(*baseline)[*baseline_num];
+
+        cursor = bench_parse_name(cursor, &result->name);
+        if (cursor == NULL) {
+            break;
+        }
+
+        cursor = bench_parse_size(cursor, "\"size\": ", &result->size);
+        if (cursor == NULL) {
+            break;
+        }
+
+        cursor = bench_parse_samples(cursor, result);
+        if (cursor == NULL || result->repetitions == 0UL) {
+            break;
+        }
+
+        result->median_ns =
+            bench_median(result->samples, result->repetitions);
+        ++*baseline_num;
+    }
+
+    free(text);
+
+    if (*baseline_num != capacity) {
+        free(*baseline);
+        *baseline = NULL;
+        *baseline_num = 0UL;
+        return false;
+    }
+
+    return true;
+}
+
+double bench_median(double const* samples, size_t samples_num)
+{
+    double sorted[BENCH_MAX_REPETITIONS];
+    memcpy(sorted, samples, sizeof(double) * samples_num);
+    qsort(sorted, samples_num, sizeof(double), bench_compare_doubles);
+
+    if (samples_num & 1UL) {
+        return sorted[samples_num / 2UL];
+    }
+
+    return 0.5 * (sorted[samples_num / 2UL - 1UL] + sorted[samples_num / 2UL]);
+}
+
+double bench_mann_whitney(double const* samples1,
+                          size_t samples1_num,
+                          double const* samples2,
+                          size_t samples2_num)
+{
+    size_t total = samples1_num + samples2_num;
+    if (samples1_num == 0UL || samples2_num == 0UL) {
+        return 1.0;
+    }
+
+    bench_rank_t* ranks = malloc(sizeof(*ranks) * total);
+    if (ranks == NULL) {
+        return 1.0;
+    }
+
+    for (size_t index = 0UL; index < samples1_num; ++index) {
+        ranks[index] = (bench_rank_t){samples1[index], 0UL};
+    }
+
+    for (size_t index = 0UL; index < samples2_num; ++index) {
+        ranks[samples1_num + index] = (bench_rank_t){samples2[index], 1UL};
+    }
+
+    qsort(ranks, total, sizeof(*ranks), bench_compare_ranks);
+
+    double rank_sum = 0.0;
+    double ties = 0.0;
+    for (size_t first = 0UL; first < total;) {
+        size_t last = first;
+        while (last + 1UL < total &&
+               ranks[last + 1UL].value == ranks[first].value) {
+            ++last;
+        }
+
+        double tied = (double)(last - first + 1UL);
+        double rank = 0.5 * (double)(first + last) + 1.0;
+        ties += tied * tied * tied - tied;
+
+        for (size_t index = first; index <= last; ++index) {
+            if (ranks[index].group == 0UL) {
+                rank_sum += rank;
+            }
+        }
+
+        first = last + 1UL;
+    }
+
+    free(ranks);
+
+    double n1 = (double)samples1_num;
+    double n2 = (double)samples2_num;
+    double n = (double)total;
+
+    double u = rank_sum - n1 * (n1 + 1.0) / 2.0;
+    double mean = n1 * n2 / 2.0;
+    double variance =
+        n1 * n2 / 12.0 * ((n + 1.0) - ties / (n * (n - 1.0)));
+    if (variance <= 0.0) {
+        return 1.0;
+    }
+
+    double z = (fabs(u - mean) - 0.5) / sqrt(variance);
+    if (z < 0.0) {
+        z = 0.0;
+    }
+
+    return erfc(z / sqrt(2.0));
+}
+
+bool bench_compare(FILE* file,
+                   bench_result_t const* baseline,
+                   size_t baseline_num,
+                   bench_result_t const* results,
+                   size_t results_num,
+                   double threshold,
+                   double alpha)
+{
+    size_t regressions = 0UL;
+    size_t missing = 0UL;
+
+    fprintf(file,
+            "%-44s %6s %12s %12s %9s %9s  %s\n",
+            "name",
+            "size",
+            "base [ns]",
+            "new [ns]",
+            "delta",
+            "p-value",
+            "status");
+
+    for (size_t index = 0UL; index < baseline_num; ++index) {
+        bench_result_t const* base = &baseline[index];
+        bench_result_t const* result = NULL;
+
+        for (size_t candidate = 0UL; candidate < results_num; ++candidate) {
+            if (results[candidate].size == base->size &&
+                strcmp(results[candidate].name, base->name) == 0) {
+                result = &results[candidate];
+                break;
+            }
+        }
+
+        if (result == NULL) {
+            fprintf(file,
+                    "%-44s %6zu %12.1f %12s %9s %9s  missing\n",
+                    base->name,
+                    base->size,
+                    base->median_ns,
+                    "-",
+                    "-",
+                    "-");
+            ++missing;
+            continue;
+        }
+
+        double delta = (result->median_ns - base->median_ns) / base->median_ns;
+        double p_value = bench_mann_whitney(base->samples,
+                                            base->repetitions,
+                                            result->samples,
+                                            result->repetitions);
+
+        char const* status = "ok";
+        if (p_value < alpha && delta > threshold) {
+            status = "REGRESSION";
+            ++regressions;
+        } else if (p_value < alpha && delta < -threshold) {
+            status = "improved";
+        }
+
+        fprintf(file,
+                "%-44s %6zu %12.1f %12.1f %+8.1f%% %9.4f  %s\n",
+                base->name,
+                base->size,
+                base->median_ns,
+                result->median_ns,
+                delta * 100.0,
+                p_value,
+                status);
+    }
+
+    fprintf(file,
+            "%zu of %zu cases regressed by more than %.1f%% (alpha %.4f), "
+            "%zu missing\n",
+            regressions,
+            baseline_num,
+            threshold * 100.0,
+            alpha,
+            missing);
+
+    return regressions == 0UL && missing == 0UL;
+}
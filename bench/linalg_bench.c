@@ -0,0 +1,2179 @@
+#define _GNU_SOURCE
+
+#include "bench.h"
+#include "linalg.h"
+#include <fcntl.h>
+#include <math.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_MAX_SIZES 16UL
+#define BENCH_MAX_FILTERS 16UL
+#define BENCH_FACTORIAL_MAX_SIZE 6UL
+#define BENCH_POWER_EXPONENT 4UL
+// The hand-written filter inverts the innovation covariance with
+// matrix_inverse, whose cost is factorial in the measurement size.
+#define BENCH_KF_NAIVE_MAX_SIZE (2UL * BENCH_FACTORIAL_MAX_SIZE)
+
+// Shape of the matrices in the batched cases, whose size is the batch count.
+#define BENCH_BATCH_SIZE 8UL
+
+typedef struct {
+    matrix_t a;
+    matrix_t b;
+    matrix_t spd;
+    matrix_t lower;
+    matrix_t column;
+    matrix_t out;
+    matrix_t scratch;
+    matrix_sym_t sym;
+    matrix_tri_t tri;
+    matrix_batch_t batch_a;
+    matrix_batch_t batch_b;
+    matrix_batch_t batch_out;
+    matrix_data_t* array;
+
+    vector_t va;
+    vector_t vb;
+    vector_t vout;
+    vector_t vscratch;
+    vector_t cross_a;
+    vector_t cross_b;
+    vector_t cross_out;
+
+    matrix3_t m3a;
+    matrix3_t m3b;
+    matrix3_t m3spd;
+    matrix3_t m3out;
+    matrix3_t* m3_batch;
+    matrix3_t* m3_batch_out;
+
+    vector3_t v3a;
+    vector3_t v3b;
+    vector3_t v3out;
+    vector3_t* v3_batch;
+    vector3_t* v3_batch_out;
+
+    quaternion3_t qa;
+    quaternion3_t qb;
+    quaternion3_t qout;
+    quaternion3_t* q_batch;
+    quaternion3_t* q_batch_out;
+
+    transform3_t ta;
+    transform3_t tb;
+    transform3_t tout;
+    transform3_t* t_batch;
+    transform3_t* t_batch_out;
+
+    transform3_packed_t pa;
+    transform3_packed_t pb;
+    transform3_packed_t pout;
+
+    linalg_kf_t kf;
+    matrix_t kf_transition;
+    matrix_t kf_process_noise;
+    matrix_t kf_observation;
+    matrix_t kf_measurement_noise;
+    matrix_t kf_measurement;
+    matrix_t kf_state;
+    matrix_t kf_covariance;
+
+    linalg_rls_t rls;
+    linalg_rls_t rls_root;
+
+    matrix_csr_t laplacian;
+    linalg_preconditioner_t ic0;
+    linalg_operator_t laplacian_op;
+    linalg_operator_t ic0_op;
+    linalg_krylov_t cg;
+    vector_t krylov_rhs;
+    vector_t krylov_solution;
+
+    size_t size;
+    size_t toggle;
+    float scalar;
+    size_t count;
+} bench_state_t;
+
+typedef void (*bench_run_t)(bench_state_t*);
+
+typedef struct {
+    char const* name;
+    bench_run_t run;
+    bool fixed;
+    size_t max_size;
+    double flops[4U];
+    double bytes[4U];
+} bench_case_t;
+
+typedef struct {
+    char const* filters[BENCH_MAX_FILTERS];
+    size_t filters_num;
+    size_t sizes[BENCH_MAX_SIZES];
+    size_t sizes_num;
+    size_t repetitions;
+    size_t warmup;
+    double min_time_ns;
+    int cpu;
+    char const* json_path;
+    char const* baseline_path;
+    double threshold;
+    double alpha;
+    bool list;
+} bench_options_t;
+
+static matrix_data_t* bench_matrix_allocate(void* user, matrix_size_t size)
+{
+    (void)user;
+
+    return malloc(size);
+}
+
+static void bench_matrix_deallocate(void* user, matrix_data_t* data)
+{
+    (void)user;
+
+    free(data);
+}
+
+static vector_data_t* bench_vector_allocate(void* user, vector_size_t size)
+{
+    (void)user;
+
+    return malloc(size);
+}
+
+static void bench_vector_deallocate(void* user, vector_data_t* data)
+{
+    (void)user;
+
+    free(data);
+}
+
+static matrix_allocator_t const bench_matrix_allocator = {
+    .user = NULL,
+    .allocate = bench_matrix_allocate,
+    .deallocate = bench_matrix_deallocate,
+};
+
+static vector_allocator_t const bench_vector_allocator = {
+    .user = NULL,
+    .allocate = bench_vector_allocate,
+    .deallocate = bench_vector_deallocate,
+};
+
+static uint32_t bench_random_state = 0x12345678U;
+
+static float bench_random(void)
+{
+    bench_random_state = bench_random_state * 1664525U + 1013904223U;
+
+    return (float)(bench_random_state >> 8U) / (float)(1U << 24U) - 0.5F;
+}
+
+static double bench_now_ns(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (double)time.tv_sec * 1E9 + (double)time.tv_nsec;
+}
+
+static void bench_fill_matrix(matrix_t* matrix, size_t rows, size_t columns)
+{
+    matrix_initialize(matrix, &bench_matrix_allocator);
+    matrix_create(matrix, rows, columns);
+
+    for (size_t row = 0UL; row < rows; ++row) {
+        for (size_t column = 0UL; column < columns; ++column) {
+            MATRIX_INDEX(matrix, row, column) = bench_random();
+        }
+
+        if (rows == columns) {
+            MATRIX_INDEX(matrix, row, row) += (float)rows;
+        }
+    }
+}
+
+static void bench_fill_vector(vector_t* vector, size_t size)
+{
+    vector_initialize(vector, &bench_vector_allocator);
+    vector_create(vector, size);
+
+    for (size_t index = 0UL; index < size; ++index) {
+        VECTOR_INDEX(vector, index) = bench_random();
+    }
+}
+
+static void bench_fill_matrix3(matrix3_t* matrix)
+{
+    for (size_t row = 0UL; row < 3UL; ++row) {
+        for (size_t column = 0UL; column < 3UL; ++column) {
+            matrix->data[row][column] = bench_random();
+        }
+
+        matrix->data[row][row] += 3.0F;
+    }
+}
+
+static void bench_fill_vector3(vector3_t* vector)
+{
+    for (size_t index = 0UL; index < 3UL; ++index) {
+        vector->data[index] = bench_random();
+    }
+}
+
+static void bench_fill_quaternion3(quaternion3_t* quaternion)
+{
+    quaternion3_fill_with_elements(quaternion,
+                                   bench_random() + 1.0F,
+                                   bench_random(),
+                                   bench_random(),
+                                   bench_random());
+}
+
+static void bench_fill_rotation(transform3_t* transform)
+{
+    float angle = bench_random() * 3.0F;
+    float c = cosf(angle);
+    float s = sinf(angle);
+
+    matrix3_data_t const rotation[3U][3U] = {
+        {c, -s, 0.0F},
+        {s, c, 0.0F},
+        {0.0F, 0.0F, 1.0F},
+    };
+
+    matrix3_fill_with_array(&transform->rotation, &rotation);
+    bench_fill_vector3(&transform->translation);
+}
+
+static void bench_fill_batch(matrix_batch_t* batch, size_t count)
+{
+    matrix_batch_initialize(batch, &bench_matrix_allocator);
+    if (matrix_batch_create(batch, count, BENCH_BATCH_SIZE, BENCH_BATCH_SIZE) !=
+        MATRIX_ERR_OK) {
+        return;
+    }
+
+    for (size_t index = 0UL; index < count; ++index) {
+        for (size_t row = 0UL; row < BENCH_BATCH_SIZE; ++row) {
+            for (size_t column = 0UL; column < BENCH_BATCH_SIZE; ++column) {
+                MATRIX_BATCH_INDEX(batch, index, row, column) =
+                    bench_random();
+            }
+        }
+    }
+}
+
+static void bench_create_matrix(matrix_t* matrix, size_t rows, size_t columns)
+{
+    matrix_initialize(matrix, &bench_matrix_allocator);
+    matrix_create_with_zeros(matrix, rows, columns);
+}
+
+// 5-point Laplacian on a size x size grid, so the sparse cases solve systems
+// of size^2 unknowns.
+static bool bench_fill_krylov(bench_state_t* state, size_t size)
+{
+    size_t n = size * size;
+
+    matrix_csr_initialize(&state->laplacian, &bench_matrix_allocator);
+    vector_initialize(&state->krylov_rhs, &bench_vector_allocator);
+    vector_initialize(&state->krylov_solution, &bench_vector_allocator);
+
+    if (matrix_csr_create(&state->laplacian, n, n, 5UL * n) !=
+            MATRIX_ERR_OK ||
+        vector_create(&state->krylov_rhs, n) != VECTOR_ERR_OK ||
+        vector_create_with_zeros(&state->krylov_solution, n) !=
+            VECTOR_ERR_OK) {
+        return false;
+    }
+
+    matrix_csr_t* a = &state->laplacian;
+    size_t entry = 0UL;
+
+    for (size_t row = 0UL; row < n; ++row) {
+        size_t const neighbors[5U] = {
+            row >= size ? row - size : SIZE_MAX,
+            row % size > 0UL ? row - 1UL : SIZE_MAX,
+            row,
+            row % size + 1UL < size ? row + 1UL : SIZE_MAX,
+            row + size < n ? row + size : SIZE_MAX,
+        };
+
+        a->row_offsets[row] = entry;
+
+        for (size_t index = 0UL; index < 5U; ++index) {
+            if (neighbors[index] != SIZE_MAX) {
+                a->column_indices[entry] = neighbors[index];
+                a->data[entry] = neighbors[index] == row ? 4.0F : -1.0F;
+                ++entry;
+            }
+        }
+
+        state->krylov_rhs.data[row] = bench_random();
+    }
+
+    a->row_offsets[n] = entry;
+
+    return linalg_operator_from_csr(&state->laplacian_op, a) ==
+               LINALG_KRYLOV_ERR_OK &&
+           linalg_preconditioner_initialize(&state->ic0,
+                                            LINALG_PRECONDITIONER_IC0,
+                                            a,
+                                            &bench_matrix_allocator) ==
+               LINALG_KRYLOV_ERR_OK &&
+           linalg_preconditioner_operator(&state->ic0, &state->ic0_op) ==
+               LINALG_KRYLOV_ERR_OK &&
+           linalg_krylov_initialize(&state->cg,
+                                    LINALG_KRYLOV_CG,
+                                    n,
+                                    10UL * size,
+                                    0UL,
+                                    &bench_vector_allocator) ==
+               LINALG_KRYLOV_ERR_OK;
+}
+
+// A stable random model with size states and half as many measurements, so
+// repeated steps converge instead of overflowing.
+static bool bench_fill_kf(bench_state_t* state, size_t size)
+{
+    size_t measurement_size = (size + 1UL) / 2UL;
+
+    if (linalg_kf_initialize(&state->kf,
+                             size,
+                             measurement_size,
+                             &bench_matrix_allocator) != LINALG_KF_ERR_OK) {
+        return false;
+    }
+
+    bench_create_matrix(&state->kf_transition, size, size);
+    bench_create_matrix(&state->kf_process_noise, size, size);
+    bench_create_matrix(&state->kf_observation, measurement_size, size);
+    bench_create_matrix(&state->kf_measurement_noise,
+                        measurement_size,
+                        measurement_size);
+    bench_create_matrix(&state->kf_measurement, measurement_size, 1UL);
+    bench_create_matrix(&state->kf_state, size, 1UL);
+    bench_create_matrix(&state->kf_covariance, size, size);
+
+    if (state->kf_transition.data == NULL ||
+        state->kf_process_noise.data == NULL ||
+        state->kf_observation.data == NULL ||
+        state->kf_measurement_noise.data == NULL ||
+        state->kf_measurement.data == NULL || state->kf_state.data == NULL ||
+        state->kf_covariance.data == NULL) {
+        return false;
+    }
+
+    for (size_t row = 0UL; row < size; ++row) {
+        for (size_t column = 0UL; column < size; ++column) {
+            MATRIX_INDEX(&state->kf_transition, row, column) =
+                bench_random() * 0.1F / (float)size;
+        }
+
+        MATRIX_INDEX(&state->kf_transition, row, row) += 0.9F;
+        MATRIX_INDEX(&state->kf_process_noise, row, row) = 0.01F;
+        MATRIX_INDEX(&state->kf_covariance, row, row) = 1.0F;
+        MATRIX_INDEX(&state->kf.covariance, row, row) = 1.0F;
+    }
+
+    for (size_t row = 0UL; row < measurement_size; ++row) {
+        for (size_t column = 0UL; column < size; ++column) {
+            MATRIX_INDEX(&state->kf_observation, row, column) = bench_random();
+        }
+
+        MATRIX_INDEX(&state->kf_measurement_noise, row, row) = 1.0F;
+        MATRIX_INDEX(&state->kf_measurement, row, 0UL) = bench_random();
+    }
+
+    return true;
+}
+
+static bool bench_state_create(bench_state_t* state, size_t size)
+{
+    memset(state, 0, sizeof(*state));
+
+    state->size = size;
+    state->count = size;
+    state->scalar = 1.5F;
+
+    bench_fill_matrix(&state->a, size, size);
+    bench_fill_matrix(&state->b, size, size);
+    bench_fill_matrix(&state->spd, size, size);
+    bench_fill_matrix(&state->lower, size, size);
+    bench_fill_matrix(&state->column, size, 1UL);
+    matrix_initialize(&state->out, &bench_matrix_allocator);
+    matrix_initialize(&state->scratch, &bench_matrix_allocator);
+    matrix_sym_initialize(&state->sym, &bench_matrix_allocator);
+    matrix_tri_initialize(&state->tri, &bench_matrix_allocator);
+    bench_fill_batch(&state->batch_a, size);
+    bench_fill_batch(&state->batch_b, size);
+    matrix_batch_initialize(&state->batch_out, &bench_matrix_allocator);
+
+    for (size_t row = 0UL; row < size; ++row) {
+        for (size_t column = 0UL; column < row; ++column) {
+            MATRIX_INDEX(&state->spd, row, column) =
+                MATRIX_INDEX(&state->spd, column, row);
+        }
+    }
+
+    state->array = malloc(sizeof(matrix_data_t) * size * size);
+
+    bench_fill_vector(&state->va, size);
+    bench_fill_vector(&state->vb, size);
+    vector_initialize(&state->vout, &bench_vector_allocator);
+    vector_initialize(&state->vscratch, &bench_vector_allocator);
+    bench_fill_vector(&state->cross_a, 3UL);
+    bench_fill_vector(&state->cross_b, 3UL);
+    vector_initialize(&state->cross_out, &bench_vector_allocator);
+
+    bench_fill_matrix3(&state->m3a);
+    bench_fill_matrix3(&state->m3b);
+    matrix3_transpose(&state->m3a, &state->m3out);
+    matrix3_product(&state->m3a, &state->m3out, &state->m3spd);
+
+    bench_fill_vector3(&state->v3a);
+    bench_fill_vector3(&state->v3b);
+    bench_fill_quaternion3(&state->qa);
+    bench_fill_quaternion3(&state->qb);
+    bench_fill_rotation(&state->ta);
+    bench_fill_rotation(&state->tb);
+    transform3_packed_from_transform(&state->ta, &state->pa);
+    transform3_packed_from_transform(&state->tb, &state->pb);
+
+    state->m3_batch = malloc(sizeof(matrix3_t) * size);
+    state->m3_batch_out = malloc(sizeof(matrix3_t) * size);
+    state->v3_batch = malloc(sizeof(vector3_t) * size);
+    state->v3_batch_out = malloc(sizeof(vector3_t) * size);
+    state->q_batch = malloc(sizeof(quaternion3_t) * size);
+    state->q_batch_out = malloc(sizeof(quaternion3_t) * size);
+    state->t_batch = malloc(sizeof(transform3_t) * size);
+    state->t_batch_out = malloc(sizeof(transform3_t) * size);
+
+    if (state->a.data == NULL || state->b.data == NULL ||
+        state->spd.data == NULL || state->lower.data == NULL ||
+        state->column.data == NULL || state->array == NULL ||
+        state->batch_a.data == NULL || state->batch_b.data == NULL ||
+        state->va.data == NULL || state->vb.data == NULL ||
+        state->m3_batch == NULL || state->m3_batch_out == NULL ||
+        state->v3_batch == NULL || state->v3_batch_out == NULL ||
+        state->q_batch == NULL || state->q_batch_out == NULL ||
+        state->t_batch == NULL || state->t_batch_out == NULL) {
+        return false;
+    }
+
+    memcpy(state->array, state->a.data, sizeof(matrix_data_t) * size * size);
+
+    for (size_t index = 0UL; index < size; ++index) {
+        bench_fill_matrix3(&state->m3_batch[index]);
+        bench_fill_vector3(&state->v3_batch[index]);
+        bench_fill_quaternion3(&state->q_batch[index]);
+        bench_fill_rotation(&state->t_batch[index]);
+    }
+
+    if (matrix_sym_from_matrix(&state->spd, &state->sym) != MATRIX_ERR_OK ||
+        matrix_tri_from_matrix(&state->a, &state->tri) != MATRIX_ERR_OK) {
+        return false;
+    }
+
+    for (size_t row = 0UL; row < size; ++row) {
+        MATRIX_PACKED_INDEX(&state->tri, row, row) = (float)size;
+
+        for (size_t column = row + 1UL; column < size; ++column) {
+            MATRIX_INDEX(&state->lower, row, column) = 0.0F;
+        }
+    }
+
+    if (linalg_rls_initialize(&state->rls,
+                              size,
+                              LINALG_RLS_FORM_COVARIANCE,
+                              0.99F,
+                              100.0F,
+                              &bench_matrix_allocator) != LINALG_RLS_ERR_OK ||
+        linalg_rls_initialize(&state->rls_root,
+                              size,
+                              LINALG_RLS_FORM_SQUARE_ROOT,
+                              0.99F,
+                              100.0F,
+                              &bench_matrix_allocator) != LINALG_RLS_ERR_OK) {
+        return false;
+    }
+
+    return bench_fill_krylov(state, size) && bench_fill_kf(state, size);
+}
+
+static void bench_state_delete(bench_state_t* state)
+{
+    matrix_delete(&state->a);
+    matrix_delete(&state->b);
+    matrix_delete(&state->spd);
+    matrix_delete(&state->lower);
+    matrix_delete(&state->column);
+    matrix_delete(&state->out);
+    matrix_delete(&state->scratch);
+    matrix_sym_delete(&state->sym);
+    matrix_tri_delete(&state->tri);
+    matrix_batch_delete(&state->batch_a);
+    matrix_batch_delete(&state->batch_b);
+    matrix_batch_delete(&state->batch_out);
+    free(state->array);
+
+    vector_delete(&state->va);
+    vector_delete(&state->vb);
+    vector_delete(&state->vout);
+    vector_delete(&state->vscratch);
+    vector_delete(&state->cross_a);
+    vector_delete(&state->cross_b);
+    vector_delete(&state->cross_out);
+
+    free(state->m3_batch);
+    free(state->m3_batch_out);
+    free(state->v3_batch);
+    free(state->v3_batch_out);
+    free(state->q_batch);
+    free(state->q_batch_out);
+    free(state->t_batch);
+    free(state->t_batch_out);
+
+    linalg_kf_deinitialize(&state->kf);
+    matrix_delete(&state->kf_transition);
+    matrix_delete(&state->kf_process_noise);
+    matrix_delete(&state->kf_observation);
+    matrix_delete(&state->kf_measurement_noise);
+    matrix_delete(&state->kf_measurement);
+    matrix_delete(&state->kf_state);
+    matrix_delete(&state->kf_covariance);
+
+    linalg_rls_deinitialize(&state->rls);
+    linalg_rls_deinitialize(&state->rls_root);
+
+    matrix_csr_delete(&state->laplacian);
+    linalg_preconditioner_deinitialize(&state->ic0);
+    linalg_krylov_deinitialize(&state->cg);
+    vector_delete(&state->krylov_rhs);
+    vector_delete(&state->krylov_solution);
+}
+
+static void bench_matrix_initialize(bench_state_t* state)
+{
+    matrix_initialize(&state->scratch, &bench_matrix_allocator);
+}
+
+static void bench_matrix_deinitialize(bench_state_t* state)
+{
+    matrix_deinitialize(&state->scratch);
+    matrix_initialize(&state->scratch, &bench_matrix_allocator);
+}
+
+static void bench_matrix_create(bench_state_t* state)
+{
+    matrix_create(&state->scratch, state->size, state->size);
+    matrix_delete(&state->scratch);
+}
+
+static void bench_matrix_create_with_zeros(bench_state_t* state)
+{
+    matrix_create_with_zeros(&state->scratch, state->size, state->size);
+    matrix_delete(&state->scratch);
+}
+
+static void bench_matrix_create_with_array(bench_state_t* state)
+{
+    matrix_create_with_array(&state->scratch,
+                             state->size,
+                             state->size,
+                             (void const*)state->array);
+    matrix_delete(&state->scratch);
+}
+
+static void bench_matrix_delete(bench_state_t* state)
+{
+    matrix_create(&state->scratch, state->size, state->size);
+    matrix_delete(&state->scratch);
+}
+
+static void bench_matrix_resize(bench_state_t* state)
+{
+    state->toggle ^= 1UL;
+    matrix_resize(&state->scratch, state->size, state->size + state->toggle);
+}
+
+static void bench_matrix_resize_with_zeros(bench_state_t* state)
+{
+    state->toggle ^= 1UL;
+    matrix_resize_with_zeros(&state->scratch,
+                             state->size,
+                             state->size + state->toggle);
+}
+
+static void bench_matrix_resize_with_array(bench_state_t* state)
+{
+    state->toggle ^= 1UL;
+    matrix_resize_with_array(&state->scratch,
+                             state->size - state->toggle,
+                             state->size,
+                             (void const*)state->array);
+}
+
+static void bench_matrix_fill_with_zeros(bench_state_t* state)
+{
+    matrix_copy(&state->a, &state->out);
+    matrix_fill_with_zeros(&state->out);
+}
+
+static void bench_matrix_fill_with_array(bench_state_t* state)
+{
+    matrix_copy(&state->a, &state->out);
+    matrix_fill_with_array(&state->out, (void const*)state->array);
+}
+
+static void bench_matrix_copy(bench_state_t* state)
+{
+    matrix_copy(&state->a, &state->out);
+}
+
+static void bench_matrix_move(bench_state_t* state)
+{
+    matrix_move(&state->a, &state->scratch);
+    matrix_move(&state->scratch, &state->a);
+}
+
+static void bench_matrix_minor(bench_state_t* state)
+{
+    matrix_minor(&state->a, 0UL, 0UL, &state->out);
+}
+
+static void bench_matrix_complement(bench_state_t* state)
+{
+    matrix_complement(&state->a, &state->out);
+}
+
+static void bench_matrix_adjoint(bench_state_t* state)
+{
+    matrix_adjoint(&state->a, &state->out);
+}
+
+static void bench_matrix_transpose(bench_state_t* state)
+{
+    matrix_transpose(&state->a, &state->out);
+}
+
+static void bench_matrix_transpose_in_place(bench_state_t* state)
+{
+    matrix_transpose_in_place(&state->a);
+}
+
+static void bench_matrix_det(bench_state_t* state)
+{
+    matrix_det(&state->a, &state->scalar);
+}
+
+static void bench_matrix_inverse(bench_state_t* state)
+{
+    matrix_inverse(&state->a, &state->out);
+}
+
+static void bench_matrix_upper_triangular(bench_state_t* state)
+{
+    matrix_upper_triangular(&state->spd, &state->out);
+}
+
+static void bench_matrix_lower_triangular(bench_state_t* state)
+{
+    matrix_lower_triangular(&state->spd, &state->out);
+}
+
+static void bench_matrix_row_echelon_form(bench_state_t* state)
+{
+    matrix_row_echelon_form(&state->a, &state->out);
+}
+
+static void bench_matrix_sum(bench_state_t* state)
+{
+    matrix_sum(&state->a, &state->b, &state->out);
+}
+
+static void bench_matrix_difference(bench_state_t* state)
+{
+    matrix_difference(&state->a, &state->b, &state->out);
+}
+
+static void bench_matrix_scale(bench_state_t* state)
+{
+    matrix_scale(&state->a, 1.5F, &state->out);
+}
+
+static void bench_matrix_product(bench_state_t* state)
+{
+    matrix_product(&state->a, &state->b, &state->out);
+}
+
+static void bench_matrix_product_transposed(bench_state_t* state)
+{
+    matrix_product_transposed(&state->a,
+                              MATRIX_OP_TRANSPOSE,
+                              &state->b,
+                              MATRIX_OP_NONE,
+                              &state->out);
+}
+
+static void bench_matrix_gram(bench_state_t* state)
+{
+    matrix_gram(&state->a, MATRIX_OP_TRANSPOSE, &state->out);
+}
+
+static void bench_matrix_sym_product(bench_state_t* state)
+{
+    matrix_sym_product(&state->sym, &state->b, &state->out);
+}
+
+static void bench_matrix_sym_rank_update(bench_state_t* state)
+{
+    matrix_sym_rank_update(&state->sym, 1E-3F, &state->a, MATRIX_OP_NONE);
+}
+
+// Solves from a fresh copy each time so repeated solves do not drive the
+// data towards denormals.
+static void bench_matrix_tri_solve(bench_state_t* state)
+{
+    matrix_copy(&state->b, &state->out);
+    matrix_tri_solve(&state->tri, MATRIX_OP_NONE, &state->out);
+}
+
+// Paired with the matching downdate so the factor does not drift over the
+// repetitions.
+static void bench_matrix_cholesky_update(bench_state_t* state)
+{
+    matrix_cholesky_update(&state->lower, &state->column);
+    matrix_cholesky_downdate(&state->lower, &state->column);
+}
+
+static void bench_matrix_batch_product(bench_state_t* state)
+{
+    matrix_batch_product(&state->batch_a,
+                         &state->batch_b,
+                         &state->batch_out,
+                         1UL);
+}
+
+static void bench_matrix_batch_sum(bench_state_t* state)
+{
+    matrix_batch_sum(&state->batch_a,
+                     &state->batch_b,
+                     &state->batch_out,
+                     1UL);
+}
+
+static void bench_matrix_division(bench_state_t* state)
+{
+    matrix_division(&state->a, &state->b, &state->out);
+}
+
+static void bench_matrix_power(bench_state_t* state)
+{
+    matrix_power(&state->a, BENCH_POWER_EXPONENT, &state->out);
+}
+
+static void bench_matrix_trace(bench_state_t* state)
+{
+    matrix_trace(&state->a, &state->scalar);
+}
+
+static void bench_matrix_rank(bench_state_t* state)
+{
+    matrix_rank(&state->a, &state->count);
+}
+
+static void bench_matrix_eigvals(bench_state_t* state)
+{
+    matrix_data_t* eigvals = NULL;
+    matrix_eigvals(&state->a, &eigvals, &state->count);
+}
+
+static void bench_matrix_print(bench_state_t* state)
+{
+    matrix_print(&state->a, "\n");
+}
+
+static void bench_vector_initialize(bench_state_t* state)
+{
+    vector_initialize(&state->vscratch, &bench_vector_allocator);
+}
+
+static void bench_vector_deinitialize(bench_state_t* state)
+{
+    vector_deinitialize(&state->vscratch);
+    vector_initialize(&state->vscratch, &bench_vector_allocator);
+}
+
+static void bench_vector_create(bench_state_t* state)
+{
+    vector_create(&state->vscratch, state->size);
+    vector_delete(&state->vscratch);
+}
+
+static void bench_vector_create_with_zeros(bench_state_t* state)
+{
+    vector_create_with_zeros(&state->vscratch, state->size);
+    vector_delete(&state->vscratch);
+}
+
+static void bench_vector_create_with_array(bench_state_t* state)
+{
+    vector_create_with_array(&state->vscratch,
+                             state->size,
+                             (void const*)state->array);
+    vector_delete(&state->vscratch);
+}
+
+static void bench_vector_delete(bench_state_t* state)
+{
+    vector_create(&state->vscratch, state->size);
+    vector_delete(&state->vscratch);
+}
+
+static void bench_vector_resize(bench_state_t* state)
+{
+    state->toggle ^= 1UL;
+    vector_resize(&state->vscratch, state->size + state->toggle);
+}
+
+static void bench_vector_resize_with_zeros(bench_state_t* state)
+{
+    state->toggle ^= 1UL;
+    vector_resize_with_zeros(&state->vscratch, state->size + state->toggle);
+}
+
+static void bench_vector_resize_with_array(bench_state_t* state)
+{
+    state->toggle ^= 1UL;
+    vector_resize_with_array(&state->vscratch,
+                             state->size - state->toggle,
+                             (void const*)state->array);
+}
+
+static void bench_vector_fill_with_zeros(bench_state_t* state)
+{
+    vector_copy(&state->va, &state->vout);
+    vector_fill_with_zeros(&state->vout);
+}
+
+static void bench_vector_fill_with_array(bench_state_t* state)
+{
+    vector_copy(&state->va, &state->vout);
+    vector_fill_with_array(&state->vout, (void const*)state->array);
+}
+
+static void bench_vector_copy(bench_state_t* state)
+{
+    vector_copy(&state->va, &state->vout);
+}
+
+static void bench_vector_move(bench_state_t* state)
+{
+    vector_move(&state->va, &state->vscratch);
+    vector_move(&state->vscratch, &state->va);
+}
+
+static void bench_vector_sum(bench_state_t* state)
+{
+    vector_sum(&state->va, &state->vb, &state->vout);
+}
+
+static void bench_vector_difference(bench_state_t* state)
+{
+    vector_difference(&state->va, &state->vb, &state->vout);
+}
+
+static void bench_vector_scale(bench_state_t* state)
+{
+    vector_scale(&state->va, 1.5F, &state->vout);
+}
+
+static void bench_vector_dot(bench_state_t* state)
+{
+    vector_dot(&state->va, &state->vb, &state->scalar);
+}
+
+static void bench_vector_dot_reduced_pairwise(bench_state_t* state)
+{
+    vector_dot_reduced(&state->va,
+                       &state->vb,
+                       LINALG_REDUCTION_PAIRWISE,
+                       1UL,
+                       &state->scalar);
+}
+
+static void bench_vector_dot_reduced_compensated(bench_state_t* state)
+{
+    vector_dot_reduced(&state->va,
+                       &state->vb,
+                       LINALG_REDUCTION_COMPENSATED,
+                       1UL,
+                       &state->scalar);
+}
+
+static void bench_vector_cross(bench_state_t* state)
+{
+    vector_cross(&state->cross_a, &state->cross_b, &state->cross_out);
+}
+
+static void bench_vector_print(bench_state_t* state)
+{
+    vector_print(&state->va, "\n");
+}
+
+static void bench_matrix3_fill_with_zeros(bench_state_t* state)
+{
+    matrix3_fill_with_zeros(&state->m3out);
+}
+
+static void bench_matrix3_fill_with_array(bench_state_t* state)
+{
+    matrix3_fill_with_array(&state->m3out, (void const*)state->array);
+}
+
+static void bench_matrix3_minor(bench_state_t* state)
+{
+    matrix3_minor(&state->m3a, 1UL, 1UL, &state->m3out);
+}
+
+static void bench_matrix3_complement(bench_state_t* state)
+{
+    matrix3_complement(&state->m3a, &state->m3out);
+}
+
+static void bench_matrix3_adjoint(bench_state_t* state)
+{
+    matrix3_adjoint(&state->m3a, &state->m3out);
+}
+
+static void bench_matrix3_transpose(bench_state_t* state)
+{
+    matrix3_transpose(&state->m3a, &state->m3out);
+}
+
+static void bench_matrix3_det(bench_state_t* state)
+{
+    matrix3_det(&state->m3a, &state->scalar);
+}
+
+static void bench_matrix3_inverse(bench_state_t* state)
+{
+    matrix3_inverse(&state->m3a, &state->m3out);
+}
+
+static void bench_matrix3_inverse_batch(bench_state_t* state)
+{
+    matrix3_inverse_batch(
+        state->m3_batch, state->m3_batch_out, state->size, NULL);
+}
+
+static void bench_matrix3_upper_triangular(bench_state_t* state)
+{
+    matrix3_upper_triangular(&state->m3spd, &state->m3out);
+}
+
+static void bench_matrix3_lower_triangular(bench_state_t* state)
+{
+    matrix3_lower_triangular(&state->m3spd, &state->m3out);
+}
+
+static void bench_matrix3_row_echelon_form(bench_state_t* state)
+{
+    matrix3_row_echelon_form(&state->m3a, &state->m3out);
+}
+
+static void bench_matrix3_sum(bench_state_t* state)
+{
+    matrix3_sum(&state->m3a, &state->m3b, &state->m3out);
+}
+
+static void bench_matrix3_difference(bench_state_t* state)
+{
+    matrix3_difference(&state->m3a, &state->m3b, &state->m3out);
+}
+
+static void bench_matrix3_scale(bench_state_t* state)
+{
+    matrix3_scale(&state->m3a, 1.5F, &state->m3out);
+}
+
+static void bench_matrix3_product(bench_state_t* state)
+{
+    matrix3_product(&state->m3a, &state->m3b, &state->m3out);
+}
+
+static void bench_matrix3_division(bench_state_t* state)
+{
+    matrix3_division(&state->m3a, &state->m3b, &state->m3out);
+}
+
+static void bench_matrix3_power(bench_state_t* state)
+{
+    matrix3_power(&state->m3a, BENCH_POWER_EXPONENT, &state->m3out);
+}
+
+static void bench_matrix3_trace(bench_state_t* state)
+{
+    matrix3_trace(&state->m3a, &state->scalar);
+}
+
+static void bench_matrix3_rank(bench_state_t* state)
+{
+    matrix3_rank(&state->m3a, &state->count);
+}
+
+static void bench_matrix3_eigvals(bench_state_t* state)
+{
+    matrix3_data_t eigvals[3U];
+    matrix3_eigvals(&state->m3a, &eigvals);
+}
+
+static void bench_matrix3_vector_product(bench_state_t* state)
+{
+    matrix3_vector_product(&state->m3a, &state->v3a, &state->v3out);
+}
+
+static void bench_matrix3_print(bench_state_t* state)
+{
+    matrix3_print(&state->m3a, "\n");
+}
+
+static void bench_vector3_fill_with_zeros(bench_state_t* state)
+{
+    vector3_fill_with_zeros(&state->v3out);
+}
+
+static void bench_vector3_fill_with_array(bench_state_t* state)
+{
+    vector3_fill_with_array(&state->v3out, (void const*)state->array);
+}
+
+static void bench_vector3_sum(bench_state_t* state)
+{
+    vector3_sum(&state->v3a, &state->v3b, &state->v3out);
+}
+
+static void bench_vector3_difference(bench_state_t* state)
+{
+    vector3_difference(&state->v3a, &state->v3b, &state->v3out);
+}
+
+static void bench_vector3_scale(bench_state_t* state)
+{
+    vector3_scale(&state->v3a, 1.5F, &state->v3out);
+}
+
+static void bench_vector3_dot(bench_state_t* state)
+{
+    vector3_dot(&state->v3a, &state->v3b, &state->scalar);
+}
+
+static void bench_vector3_cross(bench_state_t* state)
+{
+    vector3_cross(&state->v3a, &state->v3b, &state->v3out);
+}
+
+static void bench_vector3_normalized(bench_state_t* state)
+{
+    vector3_normalized(&state->v3a, &state->v3out);
+}
+
+static void bench_vector3_normalized_fast(bench_state_t* state)
+{
+    vector3_normalized_fast(&state->v3a, &state->v3out);
+}
+
+static void bench_vector3_normalized_fast_batch(bench_state_t* state)
+{
+    vector3_normalized_fast_batch(state->v3_batch,
+                                  state->v3_batch_out,
+                                  state->size);
+}
+
+static void bench_vector3_magnitude(bench_state_t* state)
+{
+    vector3_magnitude(&state->v3a, &state->scalar);
+}
+
+static void bench_vector3_negated(bench_state_t* state)
+{
+    vector3_negated(&state->v3a, &state->v3out);
+}
+
+static void bench_vector3_print(bench_state_t* state)
+{
+    vector3_print(&state->v3a, "\n");
+}
+
+static void bench_quaternion3_fill_with_zeros(bench_state_t* state)
+{
+    quaternion3_fill_with_zeros(&state->qout);
+}
+
+static void bench_quaternion3_fill_with_elements(bench_state_t* state)
+{
+    quaternion3_fill_with_elements(&state->qout, 1.0F, 0.0F, 0.0F, 0.0F);
+}
+
+static void bench_quaternion3_sum(bench_state_t* state)
+{
+    quaternion3_sum(&state->qa, &state->qb, &state->qout);
+}
+
+static void bench_quaternion3_difference(bench_state_t* state)
+{
+    quaternion3_difference(&state->qa, &state->qb, &state->qout);
+}
+
+static void bench_quaternion3_hamilton(bench_state_t* state)
+{
+    quaternion3_hamilton(&state->qa, &state->qb, &state->qout);
+}
+
+static void bench_quaternion3_scale(bench_state_t* state)
+{
+    quaternion3_scale(&state->qa, 1.5F, &state->qout);
+}
+
+static void bench_quaternion3_conjugate(bench_state_t* state)
+{
+    quaternion3_conjugate(&state->qa, &state->qout);
+}
+
+static void bench_quaternion3_inverse(bench_state_t* state)
+{
+    quaternion3_inverse(&state->qa, &state->qout);
+}
+
+static void bench_quaternion3_normalized(bench_state_t* state)
+{
+    quaternion3_normalized(&state->qa, &state->qout);
+}
+
+static void bench_quaternion3_normalized_fast(bench_state_t* state)
+{
+    quaternion3_normalized_fast(&state->qa, &state->qout);
+}
+
+static void bench_quaternion3_normalized_fast_batch(bench_state_t* state)
+{
+    quaternion3_normalized_fast_batch(state->q_batch,
+                                      state->q_batch_out,
+                                      state->size);
+}
+
+static void bench_quaternion3_magnitude(bench_state_t* state)
+{
+    quaternion3_magnitude(&state->qa, &state->scalar);
+}
+
+static void bench_quaternion3_dot(bench_state_t* state)
+{
+    quaternion3_dot(&state->qa, &state->qb, &state->scalar);
+}
+
+static void bench_transform3_fill_with_arrays(bench_state_t* state)
+{
+    transform3_fill_with_arrays(&state->tout,
+                                (void const*)state->array,
+                                (void const*)state->array);
+}
+
+static void bench_transform3_fill_with_zeros(bench_state_t* state)
+{
+    transform3_fill_with_zeros(&state->tout);
+}
+
+static void bench_transform3_compose(bench_state_t* state)
+{
+    transform3_compose(&state->ta, &state->tb, &state->tout);
+}
+
+static void bench_transform3_inverse(bench_state_t* state)
+{
+    transform3_inverse(&state->ta, &state->tout);
+}
+
+static void bench_transform3_rigid_inverse(bench_state_t* state)
+{
+    transform3_rigid_inverse(&state->ta, &state->tout);
+}
+
+static void bench_transform3_rigid_inverse_batch(bench_state_t* state)
+{
+    transform3_rigid_inverse_batch(state->t_batch,
+                                   state->t_batch_out,
+                                   state->size);
+}
+
+static void bench_transform3_vector_transformation(bench_state_t* state)
+{
+    transform3_vector_transformation(&state->ta, &state->v3a, &state->v3out);
+}
+
+static void bench_transform3_print(bench_state_t* state)
+{
+    transform3_print(&state->ta, "\n");
+}
+
+static void bench_transform3_packed_from_transform(bench_state_t* state)
+{
+    transform3_packed_from_transform(&state->ta, &state->pout);
+}
+
+static void bench_transform3_packed_to_transform(bench_state_t* state)
+{
+    transform3_packed_to_transform(&state->pa, &state->tout);
+}
+
+static void bench_transform3_packed_compose(bench_state_t* state)
+{
+    transform3_packed_compose(&state->pa, &state->pb, &state->pout);
+}
+
+static void bench_transform3_packed_inverse(bench_state_t* state)
+{
+    transform3_packed_inverse(&state->pa, &state->pout);
+}
+
+static void bench_transform3_packed_rigid_inverse(bench_state_t* state)
+{
+    transform3_packed_rigid_inverse(&state->pa, &state->pout);
+}
+
+static void bench_transform3_packed_vector_transformation(
+    bench_state_t* state)
+{
+    transform3_packed_vector_transformation(&state->pa,
+                                            &state->v3a,
+                                            &state->v3out);
+}
+
+static void bench_linalg_kf_step(bench_state_t* state)
+{
+    linalg_kf_predict(&state->kf,
+                      &state->kf_transition,
+                      &state->kf_process_noise);
+    linalg_kf_update(&state->kf,
+                     &state->kf_measurement,
+                     &state->kf_observation,
+                     &state->kf_measurement_noise);
+}
+
+// One block of size samples, the rows of a, against the observations in
+// column.
+static void bench_linalg_rls_update_batch(bench_state_t* state)
+{
+    linalg_rls_update_batch(&state->rls, &state->a, &state->column, NULL);
+}
+
+static void bench_linalg_rls_update_batch_square_root(bench_state_t* state)
+{
+    linalg_rls_update_batch(&state->rls_root,
+                            &state->a,
+                            &state->column,
+                            NULL);
+}
+
+static void bench_matrix_csr_vector_product(bench_state_t* state)
+{
+    matrix_csr_vector_product(&state->laplacian,
+                              &state->krylov_rhs,
+                              &state->krylov_solution);
+}
+
+// IC(0)-preconditioned CG from a zero guess each time.
+static void bench_linalg_krylov_cg(bench_state_t* state)
+{
+    vector_fill_with_zeros(&state->krylov_solution);
+    linalg_krylov_solve(&state->cg,
+                        &state->laplacian_op,
+                        &state->ic0_op,
+                        &state->krylov_rhs,
+                        &state->krylov_solution);
+}
+
+// The same predict and update written directly against the matrix_t API, with
+// explicit inversion and per-step temporaries, as a baseline for
+// bench_linalg_kf_step.
+static void bench_linalg_kf_step_naive(bench_state_t* state)
+{
+    matrix_t transition_t;
+    matrix_t predicted_state;
+    matrix_t fp;
+    matrix_t fpft;
+    matrix_t hx;
+    matrix_t innovation;
+    matrix_t observation_t;
+    matrix_t pht;
+    matrix_t hpht;
+    matrix_t innovation_covariance;
+    matrix_t innovation_covariance_inv;
+    matrix_t gain;
+    matrix_t correction;
+    matrix_t kh;
+    matrix_t identity;
+    matrix_t ikh;
+    matrix_t covariance;
+
+    matrix_t* const temporaries[] = {
+        &transition_t, &predicted_state, &fp, &fpft, &hx, &innovation,
+        &observation_t, &pht, &hpht, &innovation_covariance,
+        &innovation_covariance_inv, &gain, &correction, &kh, &identity,
+        &ikh, &covariance,
+    };
+    size_t const temporaries_num = sizeof(temporaries) / sizeof(temporaries[0]);
+
+    for (size_t index = 0UL; index < temporaries_num; ++index) {
+        matrix_initialize(temporaries[index], &bench_matrix_allocator);
+    }
+
+    matrix_t* x = &state->kf_state;
+    matrix_t* p = &state->kf_covariance;
+
+    matrix_product(&state->kf_transition, x, &predicted_state);
+    matrix_copy(&predicted_state, x);
+    matrix_transpose(&state->kf_transition, &transition_t);
+    matrix_product(&state->kf_transition, p, &fp);
+    matrix_product(&fp, &transition_t, &fpft);
+    matrix_sum(&fpft, &state->kf_process_noise, p);
+
+    matrix_product(&state->kf_observation, x, &hx);
+    matrix_difference(&state->kf_measurement, &hx, &innovation);
+    matrix_transpose(&state->kf_observation, &observation_t);
+    matrix_product(p, &observation_t, &pht);
+    matrix_product(&state->kf_observation, &pht, &hpht);
+    matrix_sum(&hpht, &state->kf_measurement_noise, &innovation_covariance);
+    matrix_inverse(&innovation_covariance, &innovation_covariance_inv);
+    matrix_product(&pht, &innovation_covariance_inv, &gain);
+    matrix_product(&gain, &innovation, &correction);
+    matrix_sum(x, &correction, &predicted_state);
+    matrix_copy(&predicted_state, x);
+
+    matrix_product(&gain, &state->kf_observation, &kh);
+    matrix_create_with_zeros(&identity, state->size, state->size);
+    for (size_t index = 0UL; index < state->size; ++index) {
+        MATRIX_INDEX(&identity, index, index) = 1.0F;
+    }
+    matrix_difference(&identity, &kh, &ikh);
+    matrix_product(&ikh, p, &covariance);
+    matrix_copy(&covariance, p);
+
+    for (size_t index = 0UL; index < temporaries_num; ++index) {
+        matrix_delete(temporaries[index]);
+    }
+}
+
+#define BENCH_SIZED(NAME, MAX_SIZE, FLOPS, BYTES) \
+    {#NAME, bench_##NAME, false, (MAX_SIZE), FLOPS, BYTES}
+
+#define BENCH_FIXED(NAME, FLOPS, BYTES) \
+    {#NAME, bench_##NAME, true, 0UL, {(FLOPS)}, {(BYTES)}}
+
+#define BENCH_COST(C0, C1, C2, C3) {(C0), (C1), (C2), (C3)}
+#define BENCH_NONE BENCH_COST(0.0, 0.0, 0.0, 0.0)
+
+static bench_case_t const bench_cases[] = {
+    BENCH_FIXED(matrix_initialize, 0.0, 0.0),
+    BENCH_FIXED(matrix_deinitialize, 0.0, 0.0),
+    BENCH_SIZED(matrix_create, 0UL, BENCH_NONE, BENCH_NONE),
+    BENCH_SIZED(matrix_create_with_zeros,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 0.0, 4.0, 0.0)),
+    BENCH_SIZED(matrix_create_with_array,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 0.0, 8.0, 0.0)),
+    BENCH_SIZED(matrix_delete, 0UL, BENCH_NONE, BENCH_NONE),
+    BENCH_SIZED(matrix_resize, 0UL, BENCH_NONE, BENCH_NONE),
+    BENCH_SIZED(matrix_resize_with_zeros,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 0.0, 4.0, 0.0)),
+    BENCH_SIZED(matrix_resize_with_array,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 0.0, 8.0, 0.0)),
+    BENCH_SIZED(matrix_fill_with_zeros,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 0.0, 12.0, 0.0)),
+    BENCH_SIZED(matrix_fill_with_array,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 0.0, 16.0, 0.0)),
+    BENCH_SIZED(matrix_copy, 0UL, BENCH_NONE, BENCH_COST(0.0, 0.0, 8.0, 0.0)),
+    BENCH_SIZED(matrix_move, 0UL, BENCH_NONE, BENCH_NONE),
+    BENCH_SIZED(matrix_minor,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 0.0, 8.0, 0.0)),
+    BENCH_SIZED(matrix_complement,
+                BENCH_FACTORIAL_MAX_SIZE,
+                BENCH_NONE,
+                BENCH_NONE),
+    BENCH_SIZED(matrix_adjoint,
+                BENCH_FACTORIAL_MAX_SIZE,
+                BENCH_NONE,
+                BENCH_NONE),
+    BENCH_SIZED(matrix_transpose,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 0.0, 8.0, 0.0)),
+    BENCH_SIZED(matrix_transpose_in_place,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 0.0, 8.0, 0.0)),
+    BENCH_SIZED(matrix_det, BENCH_FACTORIAL_MAX_SIZE, BENCH_NONE, BENCH_NONE),
+    BENCH_SIZED(matrix_inverse,
+                BENCH_FACTORIAL_MAX_SIZE,
+                BENCH_NONE,
+                BENCH_NONE),
+    BENCH_SIZED(matrix_upper_triangular,
+                0UL,
+                BENCH_COST(0.0, 0.0, 0.0, 1.0 / 3.0),
+                BENCH_COST(0.0, 0.0, 16.0, 0.0)),
+    BENCH_SIZED(matrix_lower_triangular,
+                0UL,
+                BENCH_COST(0.0, 0.0, 0.0, 1.0 / 3.0),
+                BENCH_COST(0.0, 0.0, 8.0, 0.0)),
+    BENCH_SIZED(matrix_row_echelon_form,
+                0UL,
+                BENCH_COST(0.0, 0.0, 0.0, 0.0),
+                BENCH_COST(0.0, 0.0, 8.0, 0.0)),
+    BENCH_SIZED(matrix_sum,
+                0UL,
+                BENCH_COST(0.0, 0.0, 1.0, 0.0),
+                BENCH_COST(0.0, 0.0, 12.0, 0.0)),
+    BENCH_SIZED(matrix_difference,
+                0UL,
+                BENCH_COST(0.0, 0.0, 1.0, 0.0),
+                BENCH_COST(0.0, 0.0, 12.0, 0.0)),
+    BENCH_SIZED(matrix_scale,
+                0UL,
+                BENCH_COST(0.0, 0.0, 1.0, 0.0),
+                BENCH_COST(0.0, 0.0, 8.0, 0.0)),
+    BENCH_SIZED(matrix_product,
+                0UL,
+                BENCH_COST(0.0, 0.0, 0.0, 2.0),
+                BENCH_COST(0.0, 0.0, 12.0, 0.0)),
+    BENCH_SIZED(matrix_product_transposed,
+                0UL,
+                BENCH_COST(0.0, 0.0, 0.0, 2.0),
+                BENCH_COST(0.0, 0.0, 12.0, 0.0)),
+    BENCH_SIZED(matrix_gram,
+                0UL,
+                BENCH_COST(0.0, 0.0, 1.0, 1.0),
+                BENCH_COST(0.0, 0.0, 8.0, 0.0)),
+    BENCH_SIZED(matrix_sym_product,
+                0UL,
+                BENCH_COST(0.0, 0.0, 0.0, 2.0),
+                BENCH_COST(0.0, 0.0, 10.0, 0.0)),
+    BENCH_SIZED(matrix_sym_rank_update,
+                0UL,
+                BENCH_COST(0.0, 0.0, 1.0, 1.0),
+                BENCH_COST(0.0, 0.0, 8.0, 0.0)),
+    BENCH_SIZED(matrix_tri_solve,
+                0UL,
+                BENCH_COST(0.0, 0.0, 0.0, 1.0),
+                BENCH_COST(0.0, 0.0, 18.0, 0.0)),
+    BENCH_SIZED(matrix_cholesky_update,
+                0UL,
+                BENCH_COST(0.0, 0.0, 5.0, 0.0),
+                BENCH_COST(0.0, 0.0, 12.0, 0.0)),
+    BENCH_SIZED(matrix_batch_product,
+                0UL,
+                BENCH_COST(0.0,
+                           2.0 * BENCH_BATCH_SIZE * BENCH_BATCH_SIZE *
+                               BENCH_BATCH_SIZE,
+                           0.0,
+                           0.0),
+                BENCH_COST(0.0,
+                           12.0 * BENCH_BATCH_SIZE * BENCH_BATCH_SIZE,
+                           0.0,
+                           0.0)),
+    BENCH_SIZED(matrix_batch_sum,
+                0UL,
+                BENCH_COST(0.0,
+                           1.0 * BENCH_BATCH_SIZE * BENCH_BATCH_SIZE,
+                           0.0,
+                           0.0),
+                BENCH_COST(0.0,
+                           12.0 * BENCH_BATCH_SIZE * BENCH_BATCH_SIZE,
+                           0.0,
+                           0.0)),
+    BENCH_SIZED(matrix_division,
+                BENCH_FACTORIAL_MAX_SIZE,
+                BENCH_NONE,
+                BENCH_NONE),
+    BENCH_SIZED(matrix_power,
+                0UL,
+                BENCH_COST(0.0, 0.0, 0.0, 2.0 * BENCH_POWER_EXPONENT),
+                BENCH_COST(0.0, 0.0, 20.0 * BENCH_POWER_EXPONENT, 0.0)),
+    BENCH_SIZED(matrix_trace,
+                0UL,
+                BENCH_COST(0.0, 1.0, 0.0, 0.0),
+                BENCH_COST(0.0, 4.0, 0.0, 0.0)),
+    BENCH_SIZED(matrix_rank,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 0.0, 8.0, 0.0)),
+    BENCH_SIZED(matrix_eigvals, 0UL, BENCH_NONE, BENCH_NONE),
+    BENCH_SIZED(matrix_print, 0UL, BENCH_NONE, BENCH_COST(0.0, 0.0, 4.0, 0.0)),
+
+    BENCH_FIXED(vector_initialize, 0.0, 0.0),
+    BENCH_FIXED(vector_deinitialize, 0.0, 0.0),
+    BENCH_SIZED(vector_create, 0UL, BENCH_NONE, BENCH_NONE),
+    BENCH_SIZED(vector_create_with_zeros,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 4.0, 0.0, 0.0)),
+    BENCH_SIZED(vector_create_with_array,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 8.0, 0.0, 0.0)),
+    BENCH_SIZED(vector_delete, 0UL, BENCH_NONE, BENCH_NONE),
+    BENCH_SIZED(vector_resize, 0UL, BENCH_NONE, BENCH_NONE),
+    BENCH_SIZED(vector_resize_with_zeros,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 4.0, 0.0, 0.0)),
+    BENCH_SIZED(vector_resize_with_array,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 8.0, 0.0, 0.0)),
+    BENCH_SIZED(vector_fill_with_zeros,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 12.0, 0.0, 0.0)),
+    BENCH_SIZED(vector_fill_with_array,
+                0UL,
+                BENCH_NONE,
+                BENCH_COST(0.0, 16.0, 0.0, 0.0)),
+    BENCH_SIZED(vector_copy, 0UL, BENCH_NONE, BENCH_COST(0.0, 8.0, 0.0, 0.0)),
+    BENCH_SIZED(vector_move, 0UL, BENCH_NONE, BENCH_NONE),
+    BENCH_SIZED(vector_sum,
+                0UL,
+                BENCH_COST(0.0, 1.0, 0.0, 0.0),
+                BENCH_COST(0.0, 12.0, 0.0, 0.0)),
+    BENCH_SIZED(vector_difference,
+                0UL,
+                BENCH_COST(0.0, 1.0, 0.0, 0.0),
+                BENCH_COST(0.0, 12.0, 0.0, 0.0)),
+    BENCH_SIZED(vector_scale,
+                0UL,
+                BENCH_COST(0.0, 1.0, 0.0, 0.0),
+                BENCH_COST(0.0, 8.0, 0.0, 0.0)),
+    BENCH_SIZED(vector_dot,
+                0UL,
+                BENCH_COST(0.0, 2.0, 0.0, 0.0),
+                BENCH_COST(0.0, 8.0, 0.0, 0.0)),
+    BENCH_SIZED(vector_dot_reduced_pairwise,
+                0UL,
+                BENCH_COST(0.0, 2.0, 0.0, 0.0),
+                BENCH_COST(0.0, 8.0, 0.0, 0.0)),
+    BENCH_SIZED(vector_dot_reduced_compensated,
+                0UL,
+                BENCH_COST(0.0, 2.0, 0.0, 0.0),
+                BENCH_COST(0.0, 8.0, 0.0, 0.0)),
+    BENCH_FIXED(vector_cross, 9.0, 36.0),
+    BENCH_SIZED(vector_print, 0UL, BENCH_NONE, BENCH_COST(0.0, 4.0, 0.0, 0.0)),
+
+    BENCH_FIXED(matrix3_fill_with_zeros, 0.0, 36.0),
+    BENCH_FIXED(matrix3_fill_with_array, 0.0, 72.0),
+    BENCH_FIXED(matrix3_minor, 0.0, 52.0),
+    BENCH_FIXED(matrix3_complement, 27.0, 72.0),
+    BENCH_FIXED(matrix3_adjoint, 27.0, 72.0),
+    BENCH_FIXED(matrix3_transpose, 0.0, 72.0),
+    BENCH_FIXED(matrix3_det, 14.0, 40.0),
+    BENCH_FIXED(matrix3_inverse, 42.0, 72.0),
+    BENCH_SIZED(matrix3_inverse_batch,
+                0UL,
+                BENCH_COST(0.0, 42.0, 0.0, 0.0),
+                BENCH_COST(0.0, 72.0, 0.0, 0.0)),
+    BENCH_FIXED(matrix3_upper_triangular, 14.0, 72.0),
+    BENCH_FIXED(matrix3_lower_triangular, 14.0, 72.0),
+    BENCH_FIXED(matrix3_row_echelon_form, 11.0, 72.0),
+    BENCH_FIXED(matrix3_sum, 9.0, 108.0),
+    BENCH_FIXED(matrix3_difference, 9.0, 108.0),
+    BENCH_FIXED(matrix3_scale, 9.0, 72.0),
+    BENCH_FIXED(matrix3_product, 45.0, 108.0),
+    BENCH_FIXED(matrix3_division, 87.0, 108.0),
+    BENCH_FIXED(matrix3_power, 45.0 * BENCH_POWER_EXPONENT, 72.0),
+    BENCH_FIXED(matrix3_trace, 3.0, 16.0),
+    BENCH_FIXED(matrix3_rank, 11.0, 40.0),
+    BENCH_FIXED(matrix3_eigvals, 0.0, 0.0),
+    BENCH_FIXED(matrix3_vector_product, 15.0, 60.0),
+    BENCH_FIXED(matrix3_print, 0.0, 36.0),
+
+    BENCH_FIXED(vector3_fill_with_zeros, 0.0, 12.0),
+    BENCH_FIXED(vector3_fill_with_array, 0.0, 24.0),
+    BENCH_FIXED(vector3_sum, 3.0, 36.0),
+    BENCH_FIXED(vector3_difference, 3.0, 36.0),
+    BENCH_FIXED(vector3_scale, 3.0, 24.0),
+    BENCH_FIXED(vector3_dot, 5.0, 28.0),
+    BENCH_FIXED(vector3_cross, 9.0, 36.0),
+    BENCH_FIXED(vector3_normalized, 9.0, 24.0),
+    BENCH_FIXED(vector3_normalized_fast, 11.0, 24.0),
+    BENCH_SIZED(vector3_normalized_fast_batch,
+                0UL,
+                BENCH_COST(0.0, 11.0, 0.0, 0.0),
+                BENCH_COST(0.0, 24.0, 0.0, 0.0)),
+    BENCH_FIXED(vector3_magnitude, 6.0, 16.0),
+    BENCH_FIXED(vector3_negated, 3.0, 24.0),
+    BENCH_FIXED(vector3_print, 0.0, 12.0),
+
+    BENCH_FIXED(quaternion3_fill_with_zeros, 0.0, 16.0),
+    BENCH_FIXED(quaternion3_fill_with_elements, 0.0, 16.0),
+    BENCH_FIXED(quaternion3_sum, 4.0, 48.0),
+    BENCH_FIXED(quaternion3_difference, 4.0, 48.0),
+    BENCH_FIXED(quaternion3_hamilton, 28.0, 48.0),
+    BENCH_FIXED(quaternion3_scale, 4.0, 32.0),
+    BENCH_FIXED(quaternion3_conjugate, 3.0, 32.0),
+    BENCH_FIXED(quaternion3_inverse, 11.0, 32.0),
+    BENCH_FIXED(quaternion3_normalized, 12.0, 32.0),
+    BENCH_FIXED(quaternion3_normalized_fast, 14.0, 32.0),
+    BENCH_SIZED(quaternion3_normalized_fast_batch,
+                0UL,
+                BENCH_COST(0.0, 14.0, 0.0, 0.0),
+                BENCH_COST(0.0, 32.0, 0.0, 0.0)),
+    BENCH_FIXED(quaternion3_magnitude, 8.0, 20.0),
+    BENCH_FIXED(quaternion3_dot, 7.0, 36.0),
+
+    BENCH_FIXED(transform3_fill_with_arrays, 0.0, 96.0),
+    BENCH_FIXED(transform3_fill_with_zeros, 0.0, 48.0),
+    BENCH_FIXED(transform3_compose, 63.0, 144.0),
+    BENCH_FIXED(transform3_inverse, 60.0, 96.0),
+    BENCH_FIXED(transform3_rigid_inverse, 18.0, 96.0),
+    BENCH_SIZED(transform3_rigid_inverse_batch,
+                0UL,
+                BENCH_COST(0.0, 18.0, 0.0, 0.0),
+                BENCH_COST(0.0, 96.0, 0.0, 0.0)),
+    BENCH_FIXED(transform3_vector_transformation, 18.0, 72.0),
+    BENCH_FIXED(transform3_print, 0.0, 48.0),
+    BENCH_FIXED(transform3_packed_from_transform, 0.0, 96.0),
+    BENCH_FIXED(transform3_packed_to_transform, 0.0, 96.0),
+    BENCH_FIXED(transform3_packed_compose, 63.0, 144.0),
+    BENCH_FIXED(transform3_packed_inverse, 60.0, 96.0),
+    BENCH_FIXED(transform3_packed_rigid_inverse, 18.0, 96.0),
+    BENCH_FIXED(transform3_packed_vector_transformation, 18.0, 72.0),
+
+    BENCH_SIZED(linalg_kf_step,
+                0UL,
+                BENCH_COST(0.0, 0.0, 0.0, 5.25),
+                BENCH_COST(0.0, 0.0, 32.0, 0.0)),
+    BENCH_SIZED(linalg_kf_step_naive,
+                BENCH_KF_NAIVE_MAX_SIZE,
+                BENCH_NONE,
+                BENCH_NONE),
+    BENCH_SIZED(matrix_csr_vector_product,
+                0UL,
+                BENCH_COST(0.0, 0.0, 10.0, 0.0),
+                BENCH_COST(0.0, 0.0, 68.0, 0.0)),
+    BENCH_SIZED(linalg_krylov_cg, 0UL, BENCH_NONE, BENCH_NONE),
+    BENCH_SIZED(linalg_rls_update_batch,
+                0UL,
+                BENCH_COST(0.0, 0.0, 0.0, 3.0),
+                BENCH_COST(0.0, 0.0, 0.0, 8.0)),
+    BENCH_SIZED(linalg_rls_update_batch_square_root,
+                0UL,
+                BENCH_COST(0.0, 0.0, 0.0, 4.0),
+                BENCH_COST(0.0, 0.0, 0.0, 4.0)),
+};
+
+#define BENCH_CASES_NUM (sizeof(bench_cases) / sizeof(bench_cases[0]))
+
+static double bench_polynomial(double const (*coefficients)[4U], double size)
+{
+    return (*coefficients)[0U] + (*coefficients)[1U] * size +
+           (*coefficients)[2U] * size * size +
+           (*coefficients)[3U] * size * size * size;
+}
+
+static bool bench_case_selected(bench_options_t const* options,
+                                char const* name)
+{
+    if (options->filters_num == 0UL) {
+        return true;
+    }
+
+    for (size_t index = 0UL; index < options->filters_num; ++index) {
+        if (strstr(name, options->filters[index]) != NULL) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool bench_case_in_baseline(bench_case_t const* bench_case,
+                                   size_t size,
+                                   bench_result_t const* baseline,
+                                   size_t baseline_num)
+{
+    if (baseline == NULL) {
+        return true;
+    }
+
+    size_t case_size = bench_case->fixed ? 0UL : size;
+
+    for (size_t index = 0UL; index < baseline_num; ++index) {
+        if (baseline[index].size == case_size &&
+            strcmp(baseline[index].name, bench_case->name) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void bench_baseline_sizes(bench_result_t const* baseline,
+                                 size_t baseline_num,
+                                 bench_options_t* options)
+{
+    options->sizes_num = 0UL;
+
+    for (size_t index = 0UL; index < baseline_num; ++index) {
+        size_t size = baseline[index].size;
+        if (size == 0UL) {
+            continue;
+        }
+
+        bool known = false;
+        for (size_t known_index = 0UL; known_index < options->sizes_num;
+             ++known_index) {
+            known = known || options->sizes[known_index] == size;
+        }
+
+        if (!known && options->sizes_num < BENCH_MAX_SIZES) {
+            options->sizes[options->sizes_num++] = size;
+        }
+    }
+
+    if (options->sizes_num == 0UL) {
+        options->sizes[options->sizes_num++] = 4UL;
+    }
+}
+
+static bool bench_case_silent(bench_case_t const* bench_case)
+{
+    size_t length = strlen(bench_case->name);
+
+    return length >= 6UL &&
+           strcmp(bench_case->name + length - 6UL, "_print") == 0;
+}
+
+static int bench_compare_doubles(void const* left, void const* right)
+{
+    double a = *(double const*)left;
+    double b = *(double const*)right;
+
+    return (a > b) - (a < b);
+}
+
+static double bench_sample(bench_case_t const* bench_case,
+                           bench_state_t* state,
+                           size_t iterations)
+{
+    double start = bench_now_ns();
+
+    for (size_t iteration = 0UL; iteration < iterations; ++iteration) {
+        bench_case->run(state);
+    }
+
+    return (bench_now_ns() - start) / (double)iterations;
+}
+
+static void bench_run_case(bench_options_t const* options,
+                           bench_case_t const* bench_case,
+                           bench_state_t* state,
+                           bench_result_t* result)
+{
+    int saved_stdout = -1;
+    if (bench_case_silent(bench_case)) {
+        fflush(stdout);
+        saved_stdout = dup(STDOUT_FILENO);
+
+        int null_fd = open("/dev/null", O_WRONLY);
+        if (null_fd >= 0) {
+            dup2(null_fd, STDOUT_FILENO);
+            close(null_fd);
+        }
+    }
+
+    size_t iterations = 1UL;
+    while (true) {
+        double elapsed = bench_sample(bench_case, state, iterations) *
+                         (double)iterations;
+        if (elapsed >= options->min_time_ns || iterations >= (1UL << 30U)) {
+            break;
+        }
+
+        iterations *= 2UL;
+    }
+
+    for (size_t warmup = 0UL; warmup < options->warmup; ++warmup) {
+        (void)bench_sample(bench_case, state, iterations);
+    }
+
+    for (size_t repetition = 0UL; repetition < options->repetitions;
+         ++repetition) {
+        result->samples[repetition] =
+            bench_sample(bench_case, state, iterations);
+    }
+
+    if (saved_stdout >= 0) {
+        fflush(stdout);
+        dup2(saved_stdout, STDOUT_FILENO);
+        close(saved_stdout);
+    }
+
+    double sorted[BENCH_MAX_REPETITIONS];
+    memcpy(sorted, result->samples, sizeof(double) * options->repetitions);
+    qsort(sorted, options->repetitions, sizeof(double), bench_compare_doubles);
+
+    size_t count = options->repetitions;
+    size_t p99_index = (size_t)ceil(0.99 * (double)count) - 1UL;
+
+    snprintf(result->name, sizeof(result->name), "%s", bench_case->name);
+    result->size = bench_case->fixed ? 0UL : state->size;
+    result->iterations = iterations;
+    result->repetitions = count;
+    result->min_ns = sorted[0U];
+    result->p99_ns = sorted[p99_index];
+    result->median_ns = bench_median(result->samples, count);
+
+    double size = (double)state->size;
+    double flops = bench_polynomial(&bench_case->flops, size);
+    double bytes = bench_polynomial(&bench_case->bytes, size);
+
+    result->gflops = flops / result->median_ns;
+    result->gbps = bytes / result->median_ns;
+}
+
+static void bench_print_header(void)
+{
+    printf("%-44s %6s %10s %12s %12s %9s %9s\n",
+           "name",
+           "size",
+           "iters",
+           "median [ns]",
+           "p99 [ns]",
+           "GFLOP/s",
+           "GB/s");
+}
+
+static void bench_print_result(bench_result_t const* result)
+{
+    printf("%-44s %6zu %10zu %12.1f %12.1f %9.3f %9.3f\n",
+           result->name,
+           result->size,
+           result->iterations,
+           result->median_ns,
+           result->p99_ns,
+           result->gflops,
+           result->gbps);
+}
+
+static void bench_write_json(FILE* file,
+                             bench_result_t const* results,
+                             size_t results_num)
+{
+    fprintf(file, "{\n  \"benchmarks\": [\n");
+
+    for (size_t index = 0UL; index < results_num; ++index) {
+        bench_result_t const* result = &results[index];
+
+        fprintf(file,
+                "    {\"name\": \"%s\", \"size\": %zu, \"iterations\": %zu, "
+                "\"repetitions\": %zu, \"median_ns\": %.3f, "
+                "\"p99_ns\": %.3f, \"min_ns\": %.3f, \"gflops\": %.6f, "
+                "\"gbps\": %.6f, \"samples_ns\": [",
+                result->name,
+                result->size,
+                result->iterations,
+                result->repetitions,
+                result->median_ns,
+                result->p99_ns,
+                result->min_ns,
+                result->gflops,
+                result->gbps);
+
+        for (size_t sample = 0UL; sample < result->repetitions; ++sample) {
+            fprintf(file,
+                    "%s%.3f",
+                    sample == 0UL ? "" : ", ",
+                    result->samples[sample]);
+        }
+
+        fprintf(file, "]}%s\n", index + 1UL == results_num ? "" : ",");
+    }
+
+    fprintf(file, "  ]\n}\n");
+}
+
+static bool bench_pin_cpu(int cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((size_t)cpu, &set);
+
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+
+    return false;
+#endif
+}
+
+static void bench_usage(char const* program)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --filter NAME[,NAME...]  run cases whose name contains NAME\n"
+            "  --sizes N[,N...]         size sweep, N >= 4 (default 4,16,64,256)\n"
+            "  --repetitions N          timed samples per case (default 20)\n"
+            "  --warmup N               untimed samples per case (default 3)\n"
+            "  --min-time-us N          minimum duration of a sample "
+            "(default 200)\n"
+            "  --cpu N                  pin the process to core N\n"
+            "  --json FILE              write results as JSON ('-' = stdout)\n"
+            "  --baseline FILE          rerun the cases in a previous JSON result\n"
+            "                           and fail on significant slowdowns\n"
+            "  --threshold PCT          allowed median slowdown (default 10)\n"
+            "  --alpha P                Mann-Whitney significance level "
+            "(default 0.01)\n"
+            "  --list                   list case names and exit\n",
+            program);
+}
+
+static void bench_parse_list(char* list,
+                             void (*store)(bench_options_t*, char*),
+                             bench_options_t* options)
+{
+    for (char* token = strtok(list, ","); token != NULL;
+         token = strtok(NULL, ",")) {
+        store(options, token);
+    }
+}
+
+static void bench_store_filter(bench_options_t* options, char* token)
+{
+    if (options->filters_num < BENCH_MAX_FILTERS) {
+        options->filters[options->filters_num++] = token;
+    }
+}
+
+static void bench_store_size(bench_options_t* options, char* token)
+{
+    unsigned long size = strtoul(token, NULL, 10);
+    if (size >= 4UL && options->sizes_num < BENCH_MAX_SIZES) {
+        options->sizes[options->sizes_num++] = size;
+    }
+}
+
+static bool bench_parse_options(int argc, char** argv, bench_options_t* options)
+{
+    memset(options, 0, sizeof(*options));
+    options->repetitions = 20UL;
+    options->warmup = 3UL;
+    options->min_time_ns = 200E3;
+    options->cpu = -1;
+    options->threshold = 0.10;
+    options->alpha = 0.01;
+
+    for (int index = 1; index < argc; ++index) {
+        char const* option = argv[index];
+        char* value = index + 1 < argc ? argv[index + 1] : NULL;
+
+        if (strcmp(option, "--list") == 0) {
+            options->list = true;
+            continue;
+        }
+
+        if (value == NULL) {
+            return false;
+        }
+
+        if (strcmp(option, "--filter") == 0) {
+            bench_parse_list(value, bench_store_filter, options);
+        } else if (strcmp(option, "--sizes") == 0) {
+            bench_parse_list(value, bench_store_size, options);
+        } else if (strcmp(option, "--repetitions") == 0) {
+            options->repetitions = strtoul(value, NULL, 10);
+        } else if (strcmp(option, "--warmup") == 0) {
+            options->warmup = strtoul(value, NULL, 10);
+        } else if (strcmp(option, "--min-time-us") == 0) {
+            options->min_time_ns = strtod(value, NULL) * 1E3;
+        } else if (strcmp(option, "--cpu") == 0) {
+            options->cpu = atoi(value);
+        } else if (strcmp(option, "--json") == 0) {
+            options->json_path = value;
+        } else if (strcmp(option, "--baseline") == 0) {
+            options->baseline_path = value;
+        } else if (strcmp(option, "--threshold") == 0) {
+            options->threshold = strtod(value, NULL) / 100.0;
+        } else if (strcmp(option, "--alpha") == 0) {
+            options->alpha = strtod(value, NULL);
+        } else {
+            return false;
+        }
+
+        ++index;
+    }
+
+    if (options->repetitions == 0UL ||
+        options->repetitions > BENCH_MAX_REPETITIONS) {
+        return false;
+    }
+
+    if (options->sizes_num == 0UL) {
+        size_t const sizes[] = {4UL, 16UL, 64UL, 256UL};
+        memcpy(options->sizes, sizes, sizeof(sizes));
+        options->sizes_num = sizeof(sizes) / sizeof(sizes[0]);
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    bench_options_t options;
+    if (!bench_parse_options(argc, argv, &options)) {
+        bench_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (options.list) {
+        for (size_t index = 0UL; index < BENCH_CASES_NUM; ++index) {
+            printf("%s\n", bench_cases[index].name);
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    if (options.cpu >= 0 && !bench_pin_cpu(options.cpu)) {
+        fprintf(stderr, "failed to pin to cpu %d\n", options.cpu);
+        return EXIT_FAILURE;
+    }
+
+    bench_result_t* baseline = NULL;
+    size_t baseline_num = 0UL;
+    if (options.baseline_path != NULL) {
+        if (!bench_baseline_load(options.baseline_path,
+                                 &baseline,
+                                 &baseline_num)) {
+            fprintf(stderr, "failed to load %s\n", options.baseline_path);
+            return EXIT_FAILURE;
+        }
+
+        bench_baseline_sizes(baseline, baseline_num, &options);
+    }
+
+    size_t results_capacity = BENCH_CASES_NUM * options.sizes_num;
+    bench_result_t* results = calloc(results_capacity, sizeof(*results));
+    if (results == NULL) {
+        free(baseline);
+        return EXIT_FAILURE;
+    }
+
+    size_t results_num = 0UL;
+    bool json_stdout =
+        options.json_path != NULL && strcmp(options.json_path, "-") == 0;
+
+    if (!json_stdout) {
+        bench_print_header();
+    }
+
+    for (size_t size_index = 0UL; size_index < options.sizes_num;
+         ++size_index) {
+        size_t size = options.sizes[size_index];
+
+        bench_state_t state;
+        if (!bench_state_create(&state, size)) {
+            fprintf(stderr, "failed to allocate operands of size %zu\n", size);
+            bench_state_delete(&state);
+            free(results);
+            free(baseline);
+            return EXIT_FAILURE;
+        }
+
+        for (size_t index = 0UL; index < BENCH_CASES_NUM; ++index) {
+            bench_case_t const* bench_case = &bench_cases[index];
+
+            if (!bench_case_selected(&options, bench_case->name)) {
+                continue;
+            }
+
+            if (bench_case->fixed && size_index != 0UL) {
+                continue;
+            }
+
+            if (!bench_case->fixed && bench_case->max_size != 0UL &&
+                size > bench_case->max_size) {
+                continue;
+            }
+
+            if (!bench_case_in_baseline(bench_case,
+                                        size,
+                                        baseline,
+                                        baseline_num)) {
+                continue;
+            }
+
+            bench_result_t* result = &results[results_num++];
+            bench_run_case(&options, bench_case, &state, result);
+
+            if (!json_stdout) {
+                bench_print_result(result);
+                fflush(stdout);
+            }
+        }
+
+        bench_state_delete(&state);
+    }
+
+    if (options.json_path != NULL) {
+        FILE* file = json_stdout ? stdout : fopen(options.json_path, "w");
+        if (file == NULL) {
+            fprintf(stderr, "failed to open %s\n", options.json_path);
+            free(results);
+            free(baseline);
+            return EXIT_FAILURE;
+        }
+
+        bench_write_json(file, results, results_num);
+
+        if (!json_stdout) {
+            fclose(file);
+        }
+    }
+
+    bool passed = true;
+    if (baseline != NULL) {
+        passed = bench_compare(json_stdout ? stderr : stdout,
+                               baseline,
+                               baseline_num,
+                               results,
+                               results_num,
+                               options.threshold,
+                               options.alpha);
+    }
+
+    free(results);
+    free(baseline);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
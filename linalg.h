@@ -5,10 +5,32 @@
 extern "C" {
 #endif
 
+#include "linalg_alloc_tracker.h"
+#include "linalg_expr.h"
+#include "linalg_inline.h"
+#include "linalg_kf.h"
+#include "linalg_krylov.h"
+#include "linalg_pool.h"
+#include "linalg_reduce.h"
+#include "linalg_rls.h"
+#include "linalg_text.h"
+#include "linalg_profile.h"
 #include "matrix.h"
+#include "matrix_band.h"
+#include "matrix_batch.h"
+#include "matrix_factor.h"
+#include "matrix_file.h"
+#include "matrix_ooc.h"
+#include "matrix_packed.h"
+#include "matrix_sparse.h"
+#include "matrix2.h"
 #include "matrix3.h"
+#include "matrix4.h"
+#include "matrix6.h"
+#include "matrix9.h"
 #include "quaternion3.h"
 #include "transform3.h"
+#include "transform3_packed.h"
 #include "vector.h"
 #include "vector3.h"
 
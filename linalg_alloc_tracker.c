@@ -0,0 +1,284 @@
+#include "linalg_alloc_tracker.h"
+#include <string.h>
+
+// Prepended to every block so deallocation can recover its size and site;
+// the union keeps the returned pointer aligned like the inner block.
+typedef union {
+    struct {
+        size_t size;
+        size_t site;
+    } info;
+    max_align_t align;
+} linalg_alloc_tracker_header_t;
+
+static size_t linalg_alloc_tracker_bucket(size_t size)
+{
+    size_t bucket = 0UL;
+    while (size > 1UL && bucket < LINALG_ALLOC_TRACKER_BUCKETS - 1UL) {
+        size >>= 1U;
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+static size_t linalg_alloc_tracker_site(linalg_alloc_tracker_t* tracker)
+{
+    if (tracker->tag == NULL) {
+        return 0UL;
+    }
+
+    for (size_t site = 1UL; site < tracker->num_sites; ++site) {
+        if (strcmp(tracker->sites[site].tag, tracker->tag) == 0) {
+            return site;
+        }
+    }
+
+    if (tracker->num_sites == LINALG_ALLOC_TRACKER_MAX_SITES) {
+        return 0UL;
+    }
+
+    tracker->sites[tracker->num_sites].tag = tracker->tag;
+
+    return tracker->num_sites++;
+}
+
+static void* linalg_alloc_tracker_record(linalg_alloc_tracker_t* tracker,
+                                         void* block,
+                                         size_t size)
+{
+    if (block == NULL) {
+        ++tracker->failures;
+        return NULL;
+    }
+
+    size_t site_index = linalg_alloc_tracker_site(tracker);
+    linalg_alloc_tracker_site_t* site = &tracker->sites[site_index];
+
+    linalg_alloc_tracker_header_t* header = block;
+    header->info.size = size;
+    header->info.site = site_index;
+
+    ++tracker->allocations;
+    tracker->live_bytes += size;
+    tracker->total_bytes += size;
+    if (tracker->live_bytes > tracker->peak_bytes) {
+        tracker->peak_bytes = tracker->live_bytes;
+    }
+    ++tracker->histogram[linalg_alloc_tracker_bucket(size)];
+
+    ++site->allocations;
+    site->live_bytes += size;
+    site->total_bytes += size;
+    if (site->live_bytes > site->peak_bytes) {
+        site->peak_bytes = site->live_bytes;
+    }
+
+    return header + 1;
+}
+
+static void* linalg_alloc_tracker_release(linalg_alloc_tracker_t* tracker,
+                                          void* data)
+{
+    linalg_alloc_tracker_header_t* header =
+        (linalg_alloc_tracker_header_t*)data - 1;
+    linalg_alloc_tracker_site_t* site = &tracker->sites[header->info.site];
+
+    ++tracker->deallocations;
+    tracker->live_bytes -= header->info.size;
+
+    ++site->deallocations;
+    site->live_bytes -= header->info.size;
+
+    return header;
+}
+
+static matrix_data_t* linalg_alloc_tracker_matrix_allocate(void* user,
+                                                           matrix_size_t size)
+{
+    linalg_alloc_tracker_t* tracker = user;
+    if (tracker->matrix_inner.allocate == NULL) {
+        return NULL;
+    }
+
+    void* block = tracker->matrix_inner.allocate(
+        tracker->matrix_inner.user,
+        sizeof(linalg_alloc_tracker_header_t) + size);
+
+    return linalg_alloc_tracker_record(tracker, block, size);
+}
+
+static void linalg_alloc_tracker_matrix_deallocate(void* user,
+                                                   matrix_data_t* data)
+{
+    linalg_alloc_tracker_t* tracker = user;
+    if (data == NULL || tracker->matrix_inner.deallocate == NULL) {
+        return;
+    }
+
+    tracker->matrix_inner.deallocate(
+        tracker->matrix_inner.user,
+        linalg_alloc_tracker_release(tracker, data));
+}
+
+static vector_data_t* linalg_alloc_tracker_vector_allocate(void* user,
+                                                           vector_size_t size)
+{
+    linalg_alloc_tracker_t* tracker = user;
+    if (tracker->vector_inner.allocate == NULL) {
+        return NULL;
+    }
+
+    void* block = tracker->vector_inner.allocate(
+        tracker->vector_inner.user,
+        sizeof(linalg_alloc_tracker_header_t) + size);
+
+    return linalg_alloc_tracker_record(tracker, block, size);
+}
+
+static void linalg_alloc_tracker_vector_deallocate(void* user,
+                                                   vector_data_t* data)
+{
+    linalg_alloc_tracker_t* tracker = user;
+    if (data == NULL || tracker->vector_inner.deallocate == NULL) {
+        return;
+    }
+
+    tracker->vector_inner.deallocate(
+        tracker->vector_inner.user,
+        linalg_alloc_tracker_release(tracker, data));
+}
+
+linalg_alloc_tracker_err_t linalg_alloc_tracker_initialize(
+    linalg_alloc_tracker_t* tracker,
+    matrix_allocator_t const* matrix_inner,
+    vector_allocator_t const* vector_inner)
+{
+    if (tracker == NULL) {
+        return LINALG_ALLOC_TRACKER_ERR_NULL;
+    }
+
+    memset(tracker, 0, sizeof(*tracker));
+
+    if (matrix_inner != NULL) {
+        memcpy(&tracker->matrix_inner, matrix_inner, sizeof(*matrix_inner));
+    }
+    if (vector_inner != NULL) {
+        memcpy(&tracker->vector_inner, vector_inner, sizeof(*vector_inner));
+    }
+
+    tracker->sites[0].tag = "(untagged)";
+    tracker->num_sites = 1UL;
+
+    return LINALG_ALLOC_TRACKER_ERR_OK;
+}
+
+linalg_alloc_tracker_err_t linalg_alloc_tracker_deinitialize(
+    linalg_alloc_tracker_t* tracker)
+{
+    if (tracker == NULL) {
+        return LINALG_ALLOC_TRACKER_ERR_NULL;
+    }
+
+    if (tracker->allocations != tracker->deallocations) {
+        return LINALG_ALLOC_TRACKER_ERR_LEAK;
+    }
+
+    memset(tracker, 0, sizeof(*tracker));
+
+    return LINALG_ALLOC_TRACKER_ERR_OK;
+}
+
+linalg_alloc_tracker_err_t linalg_alloc_tracker_matrix_allocator(
+    linalg_alloc_tracker_t* tracker,
+    matrix_allocator_t* allocator)
+{
+    if (tracker == NULL || allocator == NULL) {
+        return LINALG_ALLOC_TRACKER_ERR_NULL;
+    }
+
+    allocator->user = tracker;
+    allocator->allocate = linalg_alloc_tracker_matrix_allocate;
+    allocator->deallocate = linalg_alloc_tracker_matrix_deallocate;
+
+    return LINALG_ALLOC_TRACKER_ERR_OK;
+}
+
+linalg_alloc_tracker_err_t linalg_alloc_tracker_vector_allocator(
+    linalg_alloc_tracker_t* tracker,
+    vector_allocator_t* allocator)
+{
+    if (tracker == NULL || allocator == NULL) {
+        return LINALG_ALLOC_TRACKER_ERR_NULL;
+    }
+
+    allocator->user = tracker;
+    allocator->allocate = linalg_alloc_tracker_vector_allocate;
+    allocator->deallocate = linalg_alloc_tracker_vector_deallocate;
+
+    return LINALG_ALLOC_TRACKER_ERR_OK;
+}
+
+linalg_alloc_tracker_err_t linalg_alloc_tracker_set_tag(
+    linalg_alloc_tracker_t* tracker,
+    char const* tag)
+{
+    if (tracker == NULL) {
+        return LINALG_ALLOC_TRACKER_ERR_NULL;
+    }
+
+    tracker->tag = tag;
+
+    return LINALG_ALLOC_TRACKER_ERR_OK;
+}
+
+linalg_alloc_tracker_err_t linalg_alloc_tracker_report(
+    linalg_alloc_tracker_t const* tracker,
+    FILE* stream)
+{
+    if (tracker == NULL || stream == NULL) {
+        return LINALG_ALLOC_TRACKER_ERR_NULL;
+    }
+
+    fprintf(stream,
+            "allocations %llu, deallocations %llu, failures %llu\n",
+            (unsigned long long)tracker->allocations,
+            (unsigned long long)tracker->deallocations,
+            (unsigned long long)tracker->failures);
+    fprintf(stream,
+            "live %llu B, peak %llu B, total %llu B\n",
+            (unsigned long long)tracker->live_bytes,
+            (unsigned long long)tracker->peak_bytes,
+            (unsigned long long)tracker->total_bytes);
+
+    fprintf(stream, "size histogram:\n");
+    for (size_t bucket = 0UL; bucket < LINALG_ALLOC_TRACKER_BUCKETS;
+         ++bucket) {
+        if (tracker->histogram[bucket] == 0UL) {
+            continue;
+        }
+        fprintf(stream,
+                "  >= %-12llu %llu\n",
+                bucket == 0UL ? 0ULL : 1ULL << bucket,
+                (unsigned long long)tracker->histogram[bucket]);
+    }
+
+    fprintf(stream, "sites:\n");
+    for (size_t site = 0UL; site < tracker->num_sites; ++site) {
+        linalg_alloc_tracker_site_t const* entry = &tracker->sites[site];
+        if (entry->allocations == 0UL) {
+            continue;
+        }
+        fprintf(stream,
+                "  %s: allocations %llu, live %llu B, peak %llu B, "
+                "total %llu B%s\n",
+                entry->tag,
+                (unsigned long long)entry->allocations,
+                (unsigned long long)entry->live_bytes,
+                (unsigned long long)entry->peak_bytes,
+                (unsigned long long)entry->total_bytes,
+                entry->allocations != entry->deallocations ? " (leak)" : "");
+    }
+
+    return LINALG_ALLOC_TRACKER_ERR_OK;
+}
@@ -0,0 +1,89 @@
+#ifndef LINALG_LINALG_ALLOC_TRACKER_H
+#define LINALG_LINALG_ALLOC_TRACKER_H
+
+#include "matrix.h"
+#include "vector.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LINALG_ALLOC_TRACKER_BUCKETS 32U
+#define LINALG_ALLOC_TRACKER_MAX_SITES 32U
+
+#define LINALG_ALLOC_TRACKER_STRINGIFY_(VALUE) #VALUE
+#define LINALG_ALLOC_TRACKER_STRINGIFY(VALUE) \
+    LINALG_ALLOC_TRACKER_STRINGIFY_(VALUE)
+
+#define LINALG_ALLOC_TRACKER_HERE \
+    (__FILE__ ":" LINALG_ALLOC_TRACKER_STRINGIFY(__LINE__))
+
+typedef enum {
+    LINALG_ALLOC_TRACKER_ERR_OK = 0,
+    LINALG_ALLOC_TRACKER_ERR_FAIL,
+    LINALG_ALLOC_TRACKER_ERR_NULL,
+    LINALG_ALLOC_TRACKER_ERR_LEAK,
+} linalg_alloc_tracker_err_t;
+
+typedef struct {
+    char const* tag;
+    uint64_t allocations;
+    uint64_t deallocations;
+    uint64_t live_bytes;
+    uint64_t peak_bytes;
+    uint64_t total_bytes;
+} linalg_alloc_tracker_site_t;
+
+typedef struct {
+    matrix_allocator_t matrix_inner;
+    vector_allocator_t vector_inner;
+    char const* tag;
+    uint64_t allocations;
+    uint64_t deallocations;
+    uint64_t failures;
+    uint64_t live_bytes;
+    uint64_t peak_bytes;
+    uint64_t total_bytes;
+    uint64_t histogram[LINALG_ALLOC_TRACKER_BUCKETS];
+    linalg_alloc_tracker_site_t sites[LINALG_ALLOC_TRACKER_MAX_SITES];
+    size_t num_sites;
+} linalg_alloc_tracker_t;
+
+// Wraps matrix_inner and vector_inner; either may be NULL when the tracker is
+// only used for the other type. Byte counts are the sizes requested by the
+// library and exclude the small header the tracker prepends to every block.
+linalg_alloc_tracker_err_t linalg_alloc_tracker_initialize(
+    linalg_alloc_tracker_t* tracker,
+    matrix_allocator_t const* matrix_inner,
+    vector_allocator_t const* vector_inner);
+
+// Fails with LINALG_ALLOC_TRACKER_ERR_LEAK while any block is still live.
+linalg_alloc_tracker_err_t linalg_alloc_tracker_deinitialize(
+    linalg_alloc_tracker_t* tracker);
+
+linalg_alloc_tracker_err_t linalg_alloc_tracker_matrix_allocator(
+    linalg_alloc_tracker_t* tracker,
+    matrix_allocator_t* allocator);
+
+linalg_alloc_tracker_err_t linalg_alloc_tracker_vector_allocator(
+    linalg_alloc_tracker_t* tracker,
+    vector_allocator_t* allocator);
+
+// Attributes following allocations to tag, typically LINALG_ALLOC_TRACKER_HERE.
+// Tags are compared by content and must outlive the tracker; NULL untags.
+linalg_alloc_tracker_err_t linalg_alloc_tracker_set_tag(
+    linalg_alloc_tracker_t* tracker,
+    char const* tag);
+
+linalg_alloc_tracker_err_t linalg_alloc_tracker_report(
+    linalg_alloc_tracker_t const* tracker,
+    FILE* stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_LINALG_ALLOC_TRACKER_H
@@ -0,0 +1,550 @@
+#include "linalg_expr.h"
+#include "linalg_profile.h"
+#include <stdbool.h>
+#include <string.h>
+
+// Elements combined per pass through a stack buffer in
+// linalg_expr_combine, small enough to stay in L1.
+#define LINALG_EXPR_CHUNK 256UL
+
+typedef struct {
+    matrix_data_t coefficient;
+    linalg_expr_id_t id;
+} linalg_expr_term_t;
+
+typedef struct {
+    linalg_expr_term_t terms[LINALG_EXPR_MAX_NODES];
+    size_t num_terms;
+} linalg_expr_form_t;
+
+typedef struct {
+    matrix_data_t const* operands[2U];
+    matrix_data_t coefficient;
+    matrix_size_t common;
+} linalg_expr_gemm_t;
+
+linalg_expr_err_t linalg_expr_initialize(linalg_expr_t* expr,
+                                         matrix_allocator_t const* allocator)
+{
+    if (expr == NULL || allocator == NULL) {
+        return LINALG_EXPR_ERR_NULL;
+    }
+
+    memset(expr, 0, sizeof(*expr));
+    expr->allocator = *allocator;
+
+    return LINALG_EXPR_ERR_OK;
+}
+
+linalg_expr_err_t linalg_expr_deinitialize(linalg_expr_t* expr)
+{
+    if (expr == NULL) {
+        return LINALG_EXPR_ERR_NULL;
+    }
+
+    if (expr->arena != NULL) {
+        expr->allocator.deallocate(expr->allocator.user, expr->arena);
+    }
+
+    memset(expr, 0, sizeof(*expr));
+
+    return LINALG_EXPR_ERR_OK;
+}
+
+linalg_expr_err_t linalg_expr_clear(linalg_expr_t* expr)
+{
+    if (expr == NULL) {
+        return LINALG_EXPR_ERR_NULL;
+    }
+
+    expr->num_nodes = 0UL;
+
+    return LINALG_EXPR_ERR_OK;
+}
+
+static linalg_expr_err_t linalg_expr_push(linalg_expr_t* expr,
+                                          linalg_expr_node_t const* node,
+                                          linalg_expr_id_t* id)
+{
+    if (expr->num_nodes == LINALG_EXPR_MAX_NODES) {
+        return LINALG_EXPR_ERR_FULL;
+    }
+
+    expr->nodes[expr->num_nodes] = *node;
+    *id = expr->num_nodes++;
+
+    return LINALG_EXPR_ERR_OK;
+}
+
+linalg_expr_err_t linalg_expr_matrix(linalg_expr_t* expr,
+                                     matrix_t const* matrix,
+                                     linalg_expr_id_t* id)
+{
+    if (expr == NULL || matrix == NULL || id == NULL) {
+        return LINALG_EXPR_ERR_NULL;
+    }
+
+    linalg_expr_node_t node = {
+        .op = LINALG_EXPR_OP_MATRIX,
+        .matrix = matrix,
+        .rows = matrix->rows,
+        .columns = matrix->columns,
+    };
+
+    return linalg_expr_push(expr, &node, id);
+}
+
+static linalg_expr_err_t linalg_expr_elementwise(linalg_expr_t* expr,
+                                                 linalg_expr_op_t op,
+                                                 linalg_expr_id_t id1,
+                                                 linalg_expr_id_t id2,
+                                                 linalg_expr_id_t* id)
+{
+    if (expr == NULL || id == NULL) {
+        return LINALG_EXPR_ERR_NULL;
+    }
+
+    if (id1 >= expr->num_nodes || id2 >= expr->num_nodes) {
+        return LINALG_EXPR_ERR_FAIL;
+    }
+
+    linalg_expr_node_t const* node1 = &expr->nodes[id1];
+    linalg_expr_node_t const* node2 = &expr->nodes[id2];
+
+    if (node1->rows != node2->rows || node1->columns != node2->columns) {
+        return LINALG_EXPR_ERR_DIMENSION;
+    }
+
+    linalg_expr_node_t node = {
+        .op = op,
+        .operands = {id1, id2},
+        .rows = node1->rows,
+        .columns = node1->columns,
+    };
+
+    return linalg_expr_push(expr, &node, id);
+}
+
+linalg_expr_err_t linalg_expr_sum(linalg_expr_t* expr,
+                                  linalg_expr_id_t id1,
+                                  linalg_expr_id_t id2,
+                                  linalg_expr_id_t* id)
+{
+    return linalg_expr_elementwise(expr, LINALG_EXPR_OP_SUM, id1, id2, id);
+}
+
+linalg_expr_err_t linalg_expr_difference(linalg_expr_t* expr,
+                                         linalg_expr_id_t id1,
+                                         linalg_expr_id_t id2,
+                                         linalg_expr_id_t* id)
+{
+    return linalg_expr_elementwise(expr,
+                                   LINALG_EXPR_OP_DIFFERENCE,
+                                   id1,
+                                   id2,
+                                   id);
+}
+
+linalg_expr_err_t linalg_expr_scale(linalg_expr_t* expr,
+                                    linalg_expr_id_t id1,
+                                    matrix_data_t scalar,
+                                    linalg_expr_id_t* id)
+{
+    if (expr == NULL || id == NULL) {
+        return LINALG_EXPR_ERR_NULL;
+    }
+
+    if (id1 >= expr->num_nodes) {
+        return LINALG_EXPR_ERR_FAIL;
+    }
+
+    linalg_expr_node_t node = {
+        .op = LINALG_EXPR_OP_SCALE,
+        .operands = {id1, id1},
+        .scalar = scalar,
+        .rows = expr->nodes[id1].rows,
+        .columns = expr->nodes[id1].columns,
+    };
+
+    return linalg_expr_push(expr, &node, id);
+}
+
+linalg_expr_err_t linalg_expr_product(linalg_expr_t* expr,
+                                      linalg_expr_id_t id1,
+                                      linalg_expr_id_t id2,
+                                      linalg_expr_id_t* id)
+{
+    if (expr == NULL || id == NULL) {
+        return LINALG_EXPR_ERR_NULL;
+    }
+
+    if (id1 >= expr->num_nodes || id2 >= expr->num_nodes) {
+        return LINALG_EXPR_ERR_FAIL;
+    }
+
+    linalg_expr_node_t const* node1 = &expr->nodes[id1];
+    linalg_expr_node_t const* node2 = &expr->nodes[id2];
+
+    if (node1->columns != node2->rows) {
+        return LINALG_EXPR_ERR_DIMENSION;
+    }
+
+    linalg_expr_node_t node = {
+        .op = LINALG_EXPR_OP_PRODUCT,
+        .operands = {id1, id2},
+        .rows = node1->rows,
+        .columns = node2->columns,
+    };
+
+    return linalg_expr_push(expr, &node, id);
+}
+
+static bool linalg_expr_same_leaf(linalg_expr_t const* expr,
+                                  linalg_expr_id_t id1,
+                                  linalg_expr_id_t id2)
+{
+    linalg_expr_node_t const* node1 = &expr->nodes[id1];
+    linalg_expr_node_t const* node2 = &expr->nodes[id2];
+
+    return node1->op == LINALG_EXPR_OP_MATRIX &&
+           node2->op == LINALG_EXPR_OP_MATRIX &&
+           node1->matrix == node2->matrix;
+}
+
+// Rewrites node root as a weighted sum of leaves and products. Operands always
+// precede the nodes using them, so walking ids downwards finishes every
+// coefficient before it is read, shared subexpressions are visited once and
+// repeated leaves are merged.
+static void linalg_expr_flatten(linalg_expr_t const* expr,
+                                linalg_expr_id_t root,
+                                linalg_expr_form_t* form)
+{
+    matrix_data_t coefficients[LINALG_EXPR_MAX_NODES] = {0};
+    bool reached[LINALG_EXPR_MAX_NODES] = {false};
+
+    coefficients[root] = 1.0F;
+    reached[root] = true;
+    form->num_terms = 0UL;
+
+    for (linalg_expr_id_t id = root + 1UL; id-- > 0UL;) {
+        if (!reached[id]) {
+            continue;
+        }
+
+        linalg_expr_node_t const* node = &expr->nodes[id];
+        linalg_expr_id_t operand1 = node->operands[0U];
+        linalg_expr_id_t operand2 = node->operands[1U];
+        matrix_data_t coefficient = coefficients[id];
+
+        switch (node->op) {
+        case LINALG_EXPR_OP_SUM:
+            coefficients[operand1] += coefficient;
+            coefficients[operand2] += coefficient;
+            reached[operand1] = true;
+            reached[operand2] = true;
+            break;
+        case LINALG_EXPR_OP_DIFFERENCE:
+            coefficients[operand1] += coefficient;
+            coefficients[operand2] -= coefficient;
+            reached[operand1] = true;
+            reached[operand2] = true;
+            break;
+        case LINALG_EXPR_OP_SCALE:
+            coefficients[operand1] += coefficient * node->scalar;
+            reached[operand1] = true;
+            break;
+        case LINALG_EXPR_OP_MATRIX:
+        case LINALG_EXPR_OP_PRODUCT: {
+            size_t index = 0UL;
+            while (index < form->num_terms &&
+                   !linalg_expr_same_leaf(expr, form->terms[index].id, id)) {
+                ++index;
+            }
+
+            if (index == form->num_terms) {
+                form->terms[form->num_terms].coefficient = coefficient;
+                form->terms[form->num_terms].id = id;
+                ++form->num_terms;
+            } else {
+                form->terms[index].coefficient += coefficient;
+            }
+            break;
+        }
+        }
+    }
+}
+
+// A product operand can be read in place when it is a single scaled leaf;
+// the scale then folds into the product's coefficient.
+static bool linalg_expr_direct(linalg_expr_t const* expr,
+                               linalg_expr_id_t id,
+                               matrix_data_t const** data,
+                               matrix_data_t* coefficient)
+{
+    linalg_expr_form_t form;
+    linalg_expr_flatten(expr, id, &form);
+
+    if (form.num_terms != 1UL ||
+        expr->nodes[form.terms[0U].id].op != LINALG_EXPR_OP_MATRIX) {
+        return false;
+    }
+
+    *data = expr->nodes[form.terms[0U].id].matrix->data;
+    *coefficient = form.terms[0U].coefficient;
+
+    return true;
+}
+
+// Arena elements linalg_expr_run needs for node id.
+static size_t linalg_expr_plan(linalg_expr_t const* expr, linalg_expr_id_t id)
+{
+    linalg_expr_form_t form;
+    linalg_expr_flatten(expr, id, &form);
+
+    size_t needed = 0UL;
+
+    for (size_t index = 0UL; index < form.num_terms; ++index) {
+        linalg_expr_node_t const* node = &expr->nodes[form.terms[index].id];
+        if (node->op != LINALG_EXPR_OP_PRODUCT) {
+            continue;
+        }
+
+        for (size_t side = 0UL; side < 2UL; ++side) {
+            linalg_expr_id_t operand = node->operands[side];
+            matrix_data_t const* data;
+            matrix_data_t coefficient;
+
+            if (!linalg_expr_direct(expr, operand, &data, &coefficient)) {
+                needed += expr->nodes[operand].rows *
+                              expr->nodes[operand].columns +
+                          linalg_expr_plan(expr, operand);
+            }
+        }
+    }
+
+    return needed;
+}
+
+// output[0, count) = weighted sum of the leaves over [offset, offset + count).
+// The sum is formed in a stack buffer so output may alias any leaf.
+static void linalg_expr_combine(linalg_expr_t const* expr,
+                                linalg_expr_term_t const* leaves,
+                                size_t num_leaves,
+                                matrix_data_t* output,
+                                size_t offset,
+                                size_t count)
+{
+    matrix_data_t buffer[LINALG_EXPR_CHUNK];
+
+    for (size_t begin = 0UL; begin < count; begin += LINALG_EXPR_CHUNK) {
+        size_t length = count - begin < LINALG_EXPR_CHUNK ? count - begin
+                                                          : LINALG_EXPR_CHUNK;
+
+        memset(buffer, 0, sizeof(matrix_data_t) * length);
+
+        for (size_t term = 0UL; term < num_leaves; ++term) {
+            matrix_data_t coefficient = leaves[term].coefficient;
+            matrix_data_t const* data =
+                &expr->nodes[leaves[term].id].matrix->data[offset + begin];
+
+            for (size_t index = 0UL; index < length; ++index) {
+                buffer[index] += coefficient * data[index];
+            }
+        }
+
+        memcpy(&output[begin], buffer, sizeof(matrix_data_t) * length);
+    }
+}
+
+static void linalg_expr_run(linalg_expr_t* expr,
+                            linalg_expr_id_t id,
+                            matrix_data_t* output)
+{
+    matrix_size_t rows = expr->nodes[id].rows;
+    matrix_size_t columns = expr->nodes[id].columns;
+
+    linalg_expr_form_t form;
+    linalg_expr_flatten(expr, id, &form);
+
+    linalg_expr_term_t leaves[LINALG_EXPR_MAX_NODES];
+    linalg_expr_gemm_t gemms[LINALG_EXPR_MAX_NODES];
+    size_t num_leaves = 0UL;
+    size_t num_gemms = 0UL;
+
+    // Every product operand is materialized before output is written.
+    for (size_t index = 0UL; index < form.num_terms; ++index) {
+        linalg_expr_term_t const* term = &form.terms[index];
+        linalg_expr_node_t const* node = &expr->nodes[term->id];
+
+        if (node->op == LINALG_EXPR_OP_MATRIX) {
+            leaves[num_leaves++] = *term;
+            continue;
+        }
+
+        linalg_expr_gemm_t* gemm = &gemms[num_gemms++];
+        gemm->coefficient = term->coefficient;
+        gemm->common = expr->nodes[node->operands[0U]].columns;
+
+        for (size_t side = 0UL; side < 2UL; ++side) {
+            linalg_expr_id_t operand = node->operands[side];
+            matrix_data_t coefficient;
+
+            if (linalg_expr_direct(expr,
+                                   operand,
+                                   &gemm->operands[side],
+                                   &coefficient)) {
+                gemm->coefficient *= coefficient;
+                continue;
+            }
+
+            matrix_data_t* block = &expr->arena[expr->arena_used];
+            expr->arena_used +=
+                expr->nodes[operand].rows * expr->nodes[operand].columns;
+
+            linalg_expr_run(expr, operand, block);
+            gemm->operands[side] = block;
+        }
+    }
+
+    if (num_gemms == 0UL) {
+        linalg_expr_combine(expr,
+                            leaves,
+                            num_leaves,
+                            output,
+                            0UL,
+                            rows * columns);
+        return;
+    }
+
+    // The weighted leaves initialize each output row and every product then
+    // accumulates into it while it is still in cache.
+    for (matrix_size_t row = 0UL; row < rows; ++row) {
+        matrix_data_t* output_row = &output[row * columns];
+
+        linalg_expr_combine(expr,
+                            leaves,
+                            num_leaves,
+                            output_row,
+                            row * columns,
+                            columns);
+
+        for (size_t index = 0UL; index < num_gemms; ++index) {
+            linalg_expr_gemm_t const* gemm = &gemms[index];
+            matrix_data_t const* x_row =
+                &gemm->operands[0U][row * gemm->common];
+
+            for (matrix_size_t common = 0UL; common < gemm->common; ++common) {
+                matrix_data_t factor = gemm->coefficient * x_row[common];
+                matrix_data_t const* y_row =
+                    &gemm->operands[1U][common * columns];
+
+                for (matrix_size_t column = 0UL; column < columns; ++column) {
+                    output_row[column] += factor * y_row[column];
+                }
+            }
+        }
+    }
+}
+
+static bool linalg_expr_reserve(linalg_expr_t* expr, size_t needed)
+{
+    if (needed <= expr->arena_capacity) {
+        return true;
+    }
+
+    size_t capacity = expr->arena_capacity * 2UL;
+    if (capacity < needed) {
+        capacity = needed;
+    }
+
+    matrix_data_t* arena = expr->allocator.allocate(
+        expr->allocator.user, sizeof(matrix_data_t) * capacity);
+    if (arena == NULL) {
+        return false;
+    }
+
+    if (expr->arena != NULL) {
+        expr->allocator.deallocate(expr->allocator.user, expr->arena);
+    }
+
+    expr->arena = arena;
+    expr->arena_capacity = capacity;
+
+    return true;
+}
+
+linalg_expr_err_t linalg_expr_evaluate(linalg_expr_t* expr,
+                                       linalg_expr_id_t id,
+                                       matrix_t* result)
+{
+    if (expr == NULL || result == NULL) {
+        return LINALG_EXPR_ERR_NULL;
+    }
+
+    if (id >= expr->num_nodes) {
+        return LINALG_EXPR_ERR_FAIL;
+    }
+
+    matrix_size_t rows = expr->nodes[id].rows;
+    matrix_size_t columns = expr->nodes[id].columns;
+
+    LINALG_PROFILE_FUNCTION(linalg_expr_evaluate,
+                            0,
+                            sizeof(matrix_data_t) * rows * columns);
+
+    // Products read whole rows and columns of their operands, and resizing
+    // would free a leaf's data, so either case is staged through the arena
+    // when result is one of the leaves. Leaves resized since they were added
+    // no longer match the shapes checked by the builders and are rejected.
+    bool aliased = false;
+    bool products = false;
+    for (linalg_expr_id_t index = 0UL; index <= id; ++index) {
+        linalg_expr_node_t const* node = &expr->nodes[index];
+
+        if (node->op == LINALG_EXPR_OP_MATRIX &&
+            (node->matrix->rows != node->rows ||
+             node->matrix->columns != node->columns)) {
+            return LINALG_EXPR_ERR_DIMENSION;
+        }
+
+        products = products || node->op == LINALG_EXPR_OP_PRODUCT;
+        aliased = aliased || (node->op == LINALG_EXPR_OP_MATRIX &&
+                              (node->matrix == result ||
+                               (result->data != NULL &&
+                                node->matrix->data == result->data)));
+    }
+
+    bool staged = aliased && (products || result->rows != rows ||
+                              result->columns != columns);
+
+    size_t needed =
+        linalg_expr_plan(expr, id) + (staged ? rows * columns : 0UL);
+    if (!linalg_expr_reserve(expr, needed)) {
+        return LINALG_EXPR_ERR_ALLOC;
+    }
+
+    expr->arena_used = 0UL;
+
+    if (!staged) {
+        if (matrix_resize(result, rows, columns) != MATRIX_ERR_OK) {
+            return LINALG_EXPR_ERR_ALLOC;
+        }
+
+        linalg_expr_run(expr, id, result->data);
+
+        return LINALG_EXPR_ERR_OK;
+    }
+
+    matrix_data_t* output = expr->arena;
+    expr->arena_used = rows * columns;
+
+    linalg_expr_run(expr, id, output);
+
+    if (matrix_resize(result, rows, columns) != MATRIX_ERR_OK) {
+        return LINALG_EXPR_ERR_ALLOC;
+    }
+
+    memcpy(result->data, output, sizeof(matrix_data_t) * rows * columns);
+
+    return LINALG_EXPR_ERR_OK;
+}
@@ -0,0 +1,103 @@
+#ifndef LINALG_LINALG_EXPR_H
+#define LINALG_LINALG_EXPR_H
+
+#include "matrix.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LINALG_EXPR_MAX_NODES 64U
+
+typedef enum {
+    LINALG_EXPR_ERR_OK = 0,
+    LINALG_EXPR_ERR_FAIL,
+    LINALG_EXPR_ERR_NULL,
+    LINALG_EXPR_ERR_ALLOC,
+    LINALG_EXPR_ERR_DIMENSION,
+    LINALG_EXPR_ERR_FULL,
+} linalg_expr_err_t;
+
+typedef enum {
+    LINALG_EXPR_OP_MATRIX = 0,
+    LINALG_EXPR_OP_SUM,
+    LINALG_EXPR_OP_DIFFERENCE,
+    LINALG_EXPR_OP_SCALE,
+    LINALG_EXPR_OP_PRODUCT,
+} linalg_expr_op_t;
+
+typedef size_t linalg_expr_id_t;
+
+typedef struct {
+    linalg_expr_op_t op;
+    linalg_expr_id_t operands[2U];
+    matrix_data_t scalar;
+    matrix_t const* matrix;
+    matrix_size_t rows;
+    matrix_size_t columns;
+} linalg_expr_node_t;
+
+// Deferred matrix expression. Nodes are added with the builder functions,
+// which check shapes immediately, and nothing is computed until
+// linalg_expr_evaluate. Leaves refer to their matrix_t by pointer and are
+// read at evaluation time, which fails with LINALG_EXPR_ERR_DIMENSION if a
+// leaf no longer has the shape it had when it was added.
+//
+// Sums, differences and scales are linear, so the evaluator reduces every
+// chain of them to one weighted sum of leaves and products that it computes
+// in a single pass, or uses to initialize the product it is added to.
+// Product operands that are not plain (scaled) leaves are evaluated into an
+// arena that is sized before each evaluation and kept across clears.
+typedef struct {
+    linalg_expr_node_t nodes[LINALG_EXPR_MAX_NODES];
+    size_t num_nodes;
+    matrix_allocator_t allocator;
+    matrix_data_t* arena;
+    size_t arena_capacity;
+    size_t arena_used;
+} linalg_expr_t;
+
+linalg_expr_err_t linalg_expr_initialize(linalg_expr_t* expr,
+                                         matrix_allocator_t const* allocator);
+
+linalg_expr_err_t linalg_expr_deinitialize(linalg_expr_t* expr);
+
+// Drops every node but keeps the arena for the next expression.
+linalg_expr_err_t linalg_expr_clear(linalg_expr_t* expr);
+
+linalg_expr_err_t linalg_expr_matrix(linalg_expr_t* expr,
+                                     matrix_t const* matrix,
+                                     linalg_expr_id_t* id);
+
+linalg_expr_err_t linalg_expr_sum(linalg_expr_t* expr,
+                                  linalg_expr_id_t id1,
+                                  linalg_expr_id_t id2,
+                                  linalg_expr_id_t* id);
+
+linalg_expr_err_t linalg_expr_difference(linalg_expr_t* expr,
+                                         linalg_expr_id_t id1,
+                                         linalg_expr_id_t id2,
+                                         linalg_expr_id_t* id);
+
+linalg_expr_err_t linalg_expr_scale(linalg_expr_t* expr,
+                                    linalg_expr_id_t id1,
+                                    matrix_data_t scalar,
+                                    linalg_expr_id_t* id);
+
+linalg_expr_err_t linalg_expr_product(linalg_expr_t* expr,
+                                      linalg_expr_id_t id1,
+                                      linalg_expr_id_t id2,
+                                      linalg_expr_id_t* id);
+
+// Resizes result and stores the value of node id in it. result may be one of
+// the leaves.
+linalg_expr_err_t linalg_expr_evaluate(linalg_expr_t* expr,
+                                       linalg_expr_id_t id,
+                                       matrix_t* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_LINALG_EXPR_H
@@ -0,0 +1,31 @@
+#ifndef LINALG_LINALG_FIXED_H
+#define LINALG_LINALG_FIXED_H
+
+// Generator for fixed-size square matrix and vector types. A header defines
+// LINALG_FIXED_N and includes linalg_fixed_decl.h to declare matrixN_t,
+// vectorN_t and their functions with the same shape as matrix3.h; the
+// matching source includes linalg_fixed_impl.h to define them. Sizes up to 4
+// must define matrixN_det_unchecked and matrixN_inverse_unchecked in closed
+// form before including the implementation, larger sizes get LU-based ones.
+
+#define LINALG_FIXED_CONCAT_(A, B, C) A##B##C
+#define LINALG_FIXED_CONCAT(A, B, C) LINALG_FIXED_CONCAT_(A, B, C)
+
+// matrixN / MATRIXN / vectorN / VECTORN followed by SUFFIX.
+#define LINALG_FIXED_MATRIX(SUFFIX) \
+    LINALG_FIXED_CONCAT(matrix, LINALG_FIXED_N, SUFFIX)
+#define LINALG_FIXED_MATRIX_ERR(SUFFIX) \
+    LINALG_FIXED_CONCAT(MATRIX, LINALG_FIXED_N, SUFFIX)
+#define LINALG_FIXED_VECTOR(SUFFIX) \
+    LINALG_FIXED_CONCAT(vector, LINALG_FIXED_N, SUFFIX)
+#define LINALG_FIXED_VECTOR_ERR(SUFFIX) \
+    LINALG_FIXED_CONCAT(VECTOR, LINALG_FIXED_N, SUFFIX)
+
+// Every loop bound is a compile-time constant, so ask for full unrolling.
+#if defined(__GNUC__)
+#define LINALG_FIXED_UNROLL _Pragma("GCC unroll 16")
+#else
+#define LINALG_FIXED_UNROLL
+#endif
+
+#endif // LINALG_LINALG_FIXED_H
@@ -0,0 +1,132 @@
+// Declaration template, see linalg_fixed.h. Included once per size, so there
+// is deliberately no include guard.
+
+#ifndef LINALG_FIXED_N
+#error "define LINALG_FIXED_N before including linalg_fixed_decl.h"
+#endif
+
+#include "linalg_fixed.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define MATRIXN LINALG_FIXED_MATRIX
+#define MATRIXN_ERR LINALG_FIXED_MATRIX_ERR
+#define VECTORN LINALG_FIXED_VECTOR
+#define VECTORN_ERR LINALG_FIXED_VECTOR_ERR
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef float VECTORN(_data_t);
+typedef size_t VECTORN(_size_t);
+
+typedef enum {
+    VECTORN_ERR(_ERR_OK) = 0,
+    VECTORN_ERR(_ERR_FAIL),
+    VECTORN_ERR(_ERR_NULL),
+} VECTORN(_err_t);
+
+typedef struct {
+    VECTORN(_data_t) data[LINALG_FIXED_N];
+} VECTORN(_t);
+
+typedef float MATRIXN(_data_t);
+typedef size_t MATRIXN(_size_t);
+
+typedef enum {
+    MATRIXN_ERR(_ERR_OK) = 0,
+    MATRIXN_ERR(_ERR_FAIL),
+    MATRIXN_ERR(_ERR_NULL),
+    MATRIXN_ERR(_ERR_SINGULAR),
+} MATRIXN(_err_t);
+
+typedef struct {
+    MATRIXN(_data_t) data[LINALG_FIXED_N][LINALG_FIXED_N];
+} MATRIXN(_t);
+
+VECTORN(_err_t) VECTORN(_fill_with_zeros)(VECTORN(_t)* vector);
+
+VECTORN(_err_t)
+VECTORN(_fill_with_array)(VECTORN(_t)* vector,
+                          const VECTORN(_data_t) (*array)[LINALG_FIXED_N]);
+
+VECTORN(_err_t) VECTORN(_sum)(VECTORN(_t) const* vector1,
+                              VECTORN(_t) const* vector2,
+                              VECTORN(_t)* sum);
+
+VECTORN(_err_t) VECTORN(_difference)(VECTORN(_t) const* vector1,
+                                     VECTORN(_t) const* vector2,
+                                     VECTORN(_t)* difference);
+
+VECTORN(_err_t) VECTORN(_scale)(VECTORN(_t) const* vector,
+                                VECTORN(_data_t) scalar,
+                                VECTORN(_t)* scale);
+
+VECTORN(_err_t) VECTORN(_dot)(VECTORN(_t) const* vector1,
+                              VECTORN(_t) const* vector2,
+                              VECTORN(_data_t)* dot);
+
+VECTORN(_err_t) VECTORN(_print)(VECTORN(_t) const* vector,
+                                char const* endline);
+
+MATRIXN(_err_t) MATRIXN(_fill_with_zeros)(MATRIXN(_t)* matrix);
+
+MATRIXN(_err_t) MATRIXN(_fill_with_identity)(MATRIXN(_t)* matrix);
+
+MATRIXN(_err_t)
+MATRIXN(_fill_with_array)(
+    MATRIXN(_t)* matrix,
+    const MATRIXN(_data_t) (*array)[LINALG_FIXED_N][LINALG_FIXED_N]);
+
+MATRIXN(_err_t) MATRIXN(_transpose)(MATRIXN(_t) const* matrix,
+                                    MATRIXN(_t)* transpose);
+
+MATRIXN(_err_t) MATRIXN(_det)(MATRIXN(_t) const* matrix,
+                              MATRIXN(_data_t)* det);
+
+// Fails with ERR_SINGULAR when the determinant (closed-form sizes) or an LU
+// pivot (larger sizes) is below 1E-6 in magnitude.
+MATRIXN(_err_t) MATRIXN(_inverse)(MATRIXN(_t) const* matrix,
+                                  MATRIXN(_t)* inverse);
+
+MATRIXN(_err_t) MATRIXN(_sum)(MATRIXN(_t) const* matrix1,
+                              MATRIXN(_t) const* matrix2,
+                              MATRIXN(_t)* sum);
+
+MATRIXN(_err_t) MATRIXN(_difference)(MATRIXN(_t) const* matrix1,
+                                     MATRIXN(_t) const* matrix2,
+                                     MATRIXN(_t)* difference);
+
+MATRIXN(_err_t) MATRIXN(_scale)(MATRIXN(_t) const* matrix,
+                                MATRIXN(_data_t) scalar,
+                                MATRIXN(_t)* scale);
+
+MATRIXN(_err_t) MATRIXN(_product)(MATRIXN(_t) const* matrix1,
+                                  MATRIXN(_t) const* matrix2,
+                                  MATRIXN(_t)* product);
+
+MATRIXN(_err_t) MATRIXN(_trace)(MATRIXN(_t) const* matrix,
+                                MATRIXN(_data_t)* trace);
+
+MATRIXN(_err_t) MATRIXN(_vector_product)(MATRIXN(_t) const* matrix,
+                                         VECTORN(_t) const* vector,
+                                         VECTORN(_t)* product);
+
+// Solves matrix * solution = vector by LU decomposition with partial
+// pivoting. solution may alias vector.
+MATRIXN(_err_t) MATRIXN(_solve)(MATRIXN(_t) const* matrix,
+                                VECTORN(_t) const* vector,
+                                VECTORN(_t)* solution);
+
+MATRIXN(_err_t) MATRIXN(_print)(MATRIXN(_t) const* matrix,
+                                char const* endline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#undef MATRIXN
+#undef MATRIXN_ERR
+#undef VECTORN
+#undef VECTORN_ERR
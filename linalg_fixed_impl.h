@@ -0,0 +1,634 @@
+// Implementation template, see linalg_fixed.h. Included once per size by
+// matrixN.c after the matching declarations, so there is deliberately no
+// include guard.
+
+#ifndef LINALG_FIXED_N
+#error "define LINALG_FIXED_N before including linalg_fixed_impl.h"
+#endif
+
+#include "linalg_fixed.h"
+#include "linalg_profile.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MATRIXN LINALG_FIXED_MATRIX
+#define MATRIXN_ERR LINALG_FIXED_MATRIX_ERR
+#define VECTORN LINALG_FIXED_VECTOR
+#define VECTORN_ERR LINALG_FIXED_VECTOR_ERR
+
+#define LINALG_FIXED_PROFILE_(NAME, FLOPS, BYTES) \
+    LINALG_PROFILE_FUNCTION(NAME, FLOPS, BYTES)
+#define LINALG_FIXED_PROFILE(NAME, FLOPS, BYTES) \
+    LINALG_FIXED_PROFILE_(NAME, FLOPS, BYTES)
+
+// Element counts used by the profiling estimates.
+#define LINALG_FIXED_N2 (LINALG_FIXED_N * LINALG_FIXED_N)
+#define LINALG_FIXED_N3 (LINALG_FIXED_N2 * LINALG_FIXED_N)
+
+VECTORN(_err_t) VECTORN(_fill_with_zeros)(VECTORN(_t)* vector)
+{
+    if (vector == NULL) {
+        return VECTORN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(VECTORN(_fill_with_zeros), 0, sizeof(*vector));
+
+    memset(vector->data, 0, sizeof(vector->data));
+
+    return VECTORN_ERR(_ERR_OK);
+}
+
+VECTORN(_err_t)
+VECTORN(_fill_with_array)(VECTORN(_t)* vector,
+                          const VECTORN(_data_t) (*array)[LINALG_FIXED_N])
+{
+    if (vector == NULL || array == NULL) {
+        return VECTORN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(VECTORN(_fill_with_array), 0, 2UL * sizeof(*vector));
+
+    memcpy(vector->data, *array, sizeof(vector->data));
+
+    return VECTORN_ERR(_ERR_OK);
+}
+
+VECTORN(_err_t) VECTORN(_sum)(VECTORN(_t) const* vector1,
+                              VECTORN(_t) const* vector2,
+                              VECTORN(_t)* sum)
+{
+    if (vector1 == NULL || vector2 == NULL || sum == NULL) {
+        return VECTORN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(VECTORN(_sum), LINALG_FIXED_N, 3UL * sizeof(*sum));
+
+    LINALG_FIXED_UNROLL
+    for (VECTORN(_size_t) index = 0UL; index < LINALG_FIXED_N; ++index) {
+        sum->data[index] = vector1->data[index] + vector2->data[index];
+    }
+
+    return VECTORN_ERR(_ERR_OK);
+}
+
+VECTORN(_err_t) VECTORN(_difference)(VECTORN(_t) const* vector1,
+                                     VECTORN(_t) const* vector2,
+                                     VECTORN(_t)* difference)
+{
+    if (vector1 == NULL || vector2 == NULL || difference == NULL) {
+        return VECTORN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(VECTORN(_difference),
+                         LINALG_FIXED_N,
+                         3UL * sizeof(*difference));
+
+    LINALG_FIXED_UNROLL
+    for (VECTORN(_size_t) index = 0UL; index < LINALG_FIXED_N; ++index) {
+        difference->data[index] = vector1->data[index] - vector2->data[index];
+    }
+
+    return VECTORN_ERR(_ERR_OK);
+}
+
+VECTORN(_err_t) VECTORN(_scale)(VECTORN(_t) const* vector,
+                                VECTORN(_data_t) scalar,
+                                VECTORN(_t)* scale)
+{
+    if (vector == NULL || scale == NULL) {
+        return VECTORN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(VECTORN(_scale), LINALG_FIXED_N, 2UL * sizeof(*scale));
+
+    LINALG_FIXED_UNROLL
+    for (VECTORN(_size_t) index = 0UL; index < LINALG_FIXED_N; ++index) {
+        scale->data[index] = vector->data[index] * scalar;
+    }
+
+    return VECTORN_ERR(_ERR_OK);
+}
+
+VECTORN(_err_t) VECTORN(_dot)(VECTORN(_t) const* vector1,
+                              VECTORN(_t) const* vector2,
+                              VECTORN(_data_t)* dot)
+{
+    if (vector1 == NULL || vector2 == NULL || dot == NULL) {
+        return VECTORN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(VECTORN(_dot),
+                         2UL * LINALG_FIXED_N,
+                         2UL * sizeof(*vector1));
+
+    VECTORN(_data_t) sum = 0.0F;
+
+    LINALG_FIXED_UNROLL
+    for (VECTORN(_size_t) index = 0UL; index < LINALG_FIXED_N; ++index) {
+        sum += vector1->data[index] * vector2->data[index];
+    }
+
+    *dot = sum;
+
+    return VECTORN_ERR(_ERR_OK);
+}
+
+VECTORN(_err_t) VECTORN(_print)(VECTORN(_t) const* vector,
+                                char const* endline)
+{
+    if (vector == NULL || endline == NULL) {
+        return VECTORN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(VECTORN(_print), 0, sizeof(*vector));
+
+    printf("[ ");
+
+    for (VECTORN(_size_t) index = 0UL; index < LINALG_FIXED_N; ++index) {
+        printf("%f ", (double)vector->data[index]);
+    }
+
+    printf("]%s", endline);
+
+    return VECTORN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t) MATRIXN(_fill_with_zeros)(MATRIXN(_t)* matrix)
+{
+    if (matrix == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_fill_with_zeros), 0, sizeof(*matrix));
+
+    memset(matrix->data, 0, sizeof(matrix->data));
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t) MATRIXN(_fill_with_identity)(MATRIXN(_t)* matrix)
+{
+    if (matrix == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_fill_with_identity), 0, sizeof(*matrix));
+
+    memset(matrix->data, 0, sizeof(matrix->data));
+
+    LINALG_FIXED_UNROLL
+    for (MATRIXN(_size_t) index = 0UL; index < LINALG_FIXED_N; ++index) {
+        matrix->data[index][index] = 1.0F;
+    }
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t)
+MATRIXN(_fill_with_array)(
+    MATRIXN(_t)* matrix,
+    const MATRIXN(_data_t) (*array)[LINALG_FIXED_N][LINALG_FIXED_N])
+{
+    if (matrix == NULL || array == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_fill_with_array), 0, 2UL * sizeof(*matrix));
+
+    memcpy(matrix->data, *array, sizeof(matrix->data));
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t) MATRIXN(_transpose)(MATRIXN(_t) const* matrix,
+                                    MATRIXN(_t)* transpose)
+{
+    if (matrix == NULL || transpose == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_transpose), 0, 2UL * sizeof(*matrix));
+
+    MATRIXN(_t) result;
+
+    LINALG_FIXED_UNROLL
+    for (MATRIXN(_size_t) row = 0UL; row < LINALG_FIXED_N; ++row) {
+        LINALG_FIXED_UNROLL
+        for (MATRIXN(_size_t) column = 0UL; column < LINALG_FIXED_N; ++column) {
+            result.data[column][row] = matrix->data[row][column];
+        }
+    }
+
+    *transpose = result;
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+// Doolittle LU decomposition with partial pivoting, P * matrix = L * U, with
+// the unit diagonal of L implied. pivots[k] is the row swapped with row k at
+// step k. Elimination continues past small pivots so that *det stays exact;
+// only an exactly zero column is skipped.
+static MATRIXN(_err_t)
+MATRIXN(_lu_unchecked)(MATRIXN(_t) const* matrix,
+                       MATRIXN(_t)* lu,
+                       MATRIXN(_size_t) (*pivots)[LINALG_FIXED_N],
+                       MATRIXN(_data_t)* det)
+{
+    MATRIXN(_err_t) err = MATRIXN_ERR(_ERR_OK);
+    MATRIXN(_data_t) product = 1.0F;
+
+    *lu = *matrix;
+
+    LINALG_FIXED_UNROLL
+    for (MATRIXN(_size_t) step = 0UL; step < LINALG_FIXED_N; ++step) {
+        MATRIXN(_size_t) pivot = step;
+        MATRIXN(_data_t) max = fabsf(lu->data[step][step]);
+
+        LINALG_FIXED_UNROLL
+        for (MATRIXN(_size_t) row = step + 1UL; row < LINALG_FIXED_N; ++row) {
+            if (fabsf(lu->data[row][step]) > max) {
+                max = fabsf(lu->data[row][step]);
+                pivot = row;
+            }
+        }
+
+        (*pivots)[step] = pivot;
+
+        if (pivot != step) {
+            LINALG_FIXED_UNROLL
+            for (MATRIXN(_size_t) column = 0UL; column < LINALG_FIXED_N;
+                 ++column) {
+                MATRIXN(_data_t) swap = lu->data[step][column];
+                lu->data[step][column] = lu->data[pivot][column];
+                lu->data[pivot][column] = swap;
+            }
+
+            product = -product;
+        }
+
+        product *= lu->data[step][step];
+
+        if (max < 1E-6F) {
+            err = MATRIXN_ERR(_ERR_SINGULAR);
+        }
+
+        if (max == 0.0F) {
+            continue;
+        }
+
+        MATRIXN(_data_t) pivot_inv = 1.0F / lu->data[step][step];
+
+        LINALG_FIXED_UNROLL
+        for (MATRIXN(_size_t) row = step + 1UL; row < LINALG_FIXED_N; ++row) {
+            MATRIXN(_data_t) factor = lu->data[row][step] * pivot_inv;
+            lu->data[row][step] = factor;
+
+            LINALG_FIXED_UNROLL
+            for (MATRIXN(_size_t) column = step + 1UL; column < LINALG_FIXED_N;
+                 ++column) {
+                lu->data[row][column] -= factor * lu->data[step][column];
+            }
+        }
+    }
+
+    *det = product;
+
+    return err;
+}
+
+// Solves in place using a decomposition from matrixN_lu_unchecked that did
+// not report a singular matrix.
+static void MATRIXN(_lu_solve_unchecked)(MATRIXN(_t) const* lu,
+                                         MATRIXN(_size_t) const* pivots,
+                                         MATRIXN(_data_t)* x)
+{
+    LINALG_FIXED_UNROLL
+    for (MATRIXN(_size_t) step = 0UL; step < LINALG_FIXED_N; ++step) {
+        MATRIXN(_data_t) swap = x[step];
+        x[step] = x[pivots[step]];
+        x[pivots[step]] = swap;
+    }
+
+    LINALG_FIXED_UNROLL
+    for (MATRIXN(_size_t) row = 1UL; row < LINALG_FIXED_N; ++row) {
+        LINALG_FIXED_UNROLL
+        for (MATRIXN(_size_t) column = 0UL; column < row; ++column) {
+            x[row] -= lu->data[row][column] * x[column];
+        }
+    }
+
+    LINALG_FIXED_UNROLL
+    for (MATRIXN(_size_t) row = LINALG_FIXED_N; row-- > 0UL;) {
+        LINALG_FIXED_UNROLL
+        for (MATRIXN(_size_t) column = row + 1UL; column < LINALG_FIXED_N;
+             ++column) {
+            x[row] -= lu->data[row][column] * x[column];
+        }
+
+        x[row] /= lu->data[row][row];
+    }
+}
+
+#if LINALG_FIXED_N > 4
+
+static inline MATRIXN(_data_t) MATRIXN(_det_unchecked)(MATRIXN(_t) const* matrix)
+{
+    MATRIXN(_t) lu;
+    MATRIXN(_size_t) pivots[LINALG_FIXED_N];
+    MATRIXN(_data_t) det;
+
+    (void)MATRIXN(_lu_unchecked)(matrix, &lu, &pivots, &det);
+
+    return det;
+}
+
+static inline MATRIXN(_err_t)
+MATRIXN(_inverse_unchecked)(MATRIXN(_t) const* matrix, MATRIXN(_t)* inverse)
+{
+    MATRIXN(_t) lu;
+    MATRIXN(_size_t) pivots[LINALG_FIXED_N];
+    MATRIXN(_data_t) det;
+
+    MATRIXN(_err_t) err = MATRIXN(_lu_unchecked)(matrix, &lu, &pivots, &det);
+    if (err != MATRIXN_ERR(_ERR_OK)) {
+        return err;
+    }
+
+    for (MATRIXN(_size_t) column = 0UL; column < LINALG_FIXED_N; ++column) {
+        MATRIXN(_data_t) unit[LINALG_FIXED_N] = {0};
+        unit[column] = 1.0F;
+
+        MATRIXN(_lu_solve_unchecked)(&lu, pivots, unit);
+
+        LINALG_FIXED_UNROLL
+        for (MATRIXN(_size_t) row = 0UL; row < LINALG_FIXED_N; ++row) {
+            inverse->data[row][column] = unit[row];
+        }
+    }
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+#endif // LINALG_FIXED_N > 4
+
+MATRIXN(_err_t) MATRIXN(_det)(MATRIXN(_t) const* matrix,
+                              MATRIXN(_data_t)* det)
+{
+    if (matrix == NULL || det == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_det),
+                         2UL * LINALG_FIXED_N3 / 3UL,
+                         sizeof(*matrix));
+
+    *det = MATRIXN(_det_unchecked)(matrix);
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t) MATRIXN(_inverse)(MATRIXN(_t) const* matrix,
+                                  MATRIXN(_t)* inverse)
+{
+    if (matrix == NULL || inverse == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_inverse),
+                         2UL * LINALG_FIXED_N3,
+                         2UL * sizeof(*matrix));
+
+    MATRIXN(_t) result;
+
+    MATRIXN(_err_t) err = MATRIXN(_inverse_unchecked)(matrix, &result);
+    if (err != MATRIXN_ERR(_ERR_OK)) {
+        return err;
+    }
+
+    *inverse = result;
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t) MATRIXN(_sum)(MATRIXN(_t) const* matrix1,
+                              MATRIXN(_t) const* matrix2,
+                              MATRIXN(_t)* sum)
+{
+    if (matrix1 == NULL || matrix2 == NULL || sum == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_sum), LINALG_FIXED_N2, 3UL * sizeof(*sum));
+
+    LINALG_FIXED_UNROLL
+    for (MATRIXN(_size_t) row = 0UL; row < LINALG_FIXED_N; ++row) {
+        LINALG_FIXED_UNROLL
+        for (MATRIXN(_size_t) column = 0UL; column < LINALG_FIXED_N; ++column) {
+            sum->data[row][column] =
+                matrix1->data[row][column] + matrix2->data[row][column];
+        }
+    }
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t) MATRIXN(_difference)(MATRIXN(_t) const* matrix1,
+                                     MATRIXN(_t) const* matrix2,
+                                     MATRIXN(_t)* difference)
+{
+    if (matrix1 == NULL || matrix2 == NULL || difference == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_difference),
+                         LINALG_FIXED_N2,
+                         3UL * sizeof(*difference));
+
+    LINALG_FIXED_UNROLL
+    for (MATRIXN(_size_t) row = 0UL; row < LINALG_FIXED_N; ++row) {
+        LINALG_FIXED_UNROLL
+        for (MATRIXN(_size_t) column = 0UL; column < LINALG_FIXED_N; ++column) {
+            difference->data[row][column] =
+                matrix1->data[row][column] - matrix2->data[row][column];
+        }
+    }
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t) MATRIXN(_scale)(MATRIXN(_t) const* matrix,
+                                MATRIXN(_data_t) scalar,
+                                MATRIXN(_t)* scale)
+{
+    if (matrix == NULL || scale == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_scale), LINALG_FIXED_N2, 2UL * sizeof(*scale));
+
+    LINALG_FIXED_UNROLL
+    for (MATRIXN(_size_t) row = 0UL; row < LINALG_FIXED_N; ++row) {
+        LINALG_FIXED_UNROLL
+        for (MATRIXN(_size_t) column = 0UL; column < LINALG_FIXED_N; ++column) {
+            scale->data[row][column] = matrix->data[row][column] * scalar;
+        }
+    }
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t) MATRIXN(_product)(MATRIXN(_t) const* matrix1,
+                                  MATRIXN(_t) const* matrix2,
+                                  MATRIXN(_t)* product)
+{
+    if (matrix1 == NULL || matrix2 == NULL || product == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_product),
+                         2UL * LINALG_FIXED_N3,
+                         3UL * sizeof(*product));
+
+    MATRIXN(_t) result;
+
+    // Row-times-row order keeps the innermost loop contiguous in both
+    // matrix2 and the result, so it vectorizes once unrolled.
+    LINALG_FIXED_UNROLL
+    for (MATRIXN(_size_t) row = 0UL; row < LINALG_FIXED_N; ++row) {
+        LINALG_FIXED_UNROLL
+        for (MATRIXN(_size_t) column = 0UL; column < LINALG_FIXED_N; ++column) {
+            result.data[row][column] =
+                matrix1->data[row][0U] * matrix2->data[0U][column];
+        }
+
+        LINALG_FIXED_UNROLL
+        for (MATRIXN(_size_t) common = 1UL; common < LINALG_FIXED_N; ++common) {
+            LINALG_FIXED_UNROLL
+            for (MATRIXN(_size_t) column = 0UL; column < LINALG_FIXED_N;
+                 ++column) {
+                result.data[row][column] +=
+                    matrix1->data[row][common] * matrix2->data[common][column];
+            }
+        }
+    }
+
+    *product = result;
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t) MATRIXN(_trace)(MATRIXN(_t) const* matrix,
+                                MATRIXN(_data_t)* trace)
+{
+    if (matrix == NULL || trace == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_trace),
+                         LINALG_FIXED_N,
+                         LINALG_FIXED_N * sizeof(MATRIXN(_data_t)));
+
+    MATRIXN(_data_t) sum = 0.0F;
+
+    LINALG_FIXED_UNROLL
+    for (MATRIXN(_size_t) index = 0UL; index < LINALG_FIXED_N; ++index) {
+        sum += matrix->data[index][index];
+    }
+
+    *trace = sum;
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t) MATRIXN(_vector_product)(MATRIXN(_t) const* matrix,
+                                         VECTORN(_t) const* vector,
+                                         VECTORN(_t)* product)
+{
+    if (matrix == NULL || vector == NULL || product == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_vector_product),
+                         2UL * LINALG_FIXED_N2,
+                         sizeof(*matrix) + 2UL * sizeof(*vector));
+
+    VECTORN(_t) result;
+
+    LINALG_FIXED_UNROLL
+    for (MATRIXN(_size_t) row = 0UL; row < LINALG_FIXED_N; ++row) {
+        MATRIXN(_data_t) sum = 0.0F;
+
+        LINALG_FIXED_UNROLL
+        for (MATRIXN(_size_t) column = 0UL; column < LINALG_FIXED_N; ++column) {
+            sum += matrix->data[row][column] * vector->data[column];
+        }
+
+        result.data[row] = sum;
+    }
+
+    *product = result;
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t) MATRIXN(_solve)(MATRIXN(_t) const* matrix,
+                                VECTORN(_t) const* vector,
+                                VECTORN(_t)* solution)
+{
+    if (matrix == NULL || vector == NULL || solution == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_solve),
+                         2UL * LINALG_FIXED_N3 / 3UL + 2UL * LINALG_FIXED_N2,
+                         sizeof(*matrix) + 2UL * sizeof(*vector));
+
+    MATRIXN(_t) lu;
+    MATRIXN(_size_t) pivots[LINALG_FIXED_N];
+    MATRIXN(_data_t) det;
+
+    MATRIXN(_err_t) err = MATRIXN(_lu_unchecked)(matrix, &lu, &pivots, &det);
+    if (err != MATRIXN_ERR(_ERR_OK)) {
+        return err;
+    }
+
+    VECTORN(_t) result = *vector;
+
+    MATRIXN(_lu_solve_unchecked)(&lu, pivots, result.data);
+
+    *solution = result;
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+MATRIXN(_err_t) MATRIXN(_print)(MATRIXN(_t) const* matrix,
+                                char const* endline)
+{
+    if (matrix == NULL || endline == NULL) {
+        return MATRIXN_ERR(_ERR_NULL);
+    }
+
+    LINALG_FIXED_PROFILE(MATRIXN(_print), 0, sizeof(*matrix));
+
+    for (MATRIXN(_size_t) row = 0UL; row < LINALG_FIXED_N; ++row) {
+        printf("[ ");
+
+        for (MATRIXN(_size_t) column = 0UL; column < LINALG_FIXED_N; ++column) {
+            printf("%f ", (double)matrix->data[row][column]);
+        }
+
+        printf("]%s", endline);
+    }
+
+    return MATRIXN_ERR(_ERR_OK);
+}
+
+#undef LINALG_FIXED_N2
+#undef LINALG_FIXED_N3
+#undef LINALG_FIXED_PROFILE
+#undef LINALG_FIXED_PROFILE_
+#undef MATRIXN
+#undef MATRIXN_ERR
+#undef VECTORN
+#undef VECTORN_ERR
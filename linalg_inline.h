@@ -0,0 +1,358 @@
+#ifndef LINALG_LINALG_INLINE_H
+#define LINALG_LINALG_INLINE_H
+
+#include "linalg_rsqrt.h"
+#include "matrix3.h"
+#include "quaternion3.h"
+#include "transform3.h"
+#include "vector3.h"
+#include <math.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Value-returning counterparts of the fixed-size functions. They compute the
+// same results as the checked API but take and return structures by value,
+// perform no NULL checks and are not profiled, so the compiler can inline
+// whole chains of them and keep the operands in registers. Operations that
+// fail in the checked API (normalizing a zero vector, inverting a singular
+// matrix) are the caller's responsibility here and produce infinities or
+// NaNs instead of an error.
+
+static inline vector3_t vector3_make(vector3_data_t x,
+                                     vector3_data_t y,
+                                     vector3_data_t z)
+{
+    vector3_t vector = {{x, y, z}};
+
+    return vector;
+}
+
+static inline vector3_t vector3_add(vector3_t vector1, vector3_t vector2)
+{
+    return vector3_make(vector1.data[0U] + vector2.data[0U],
+                        vector1.data[1U] + vector2.data[1U],
+                        vector1.data[2U] + vector2.data[2U]);
+}
+
+static inline vector3_t vector3_sub(vector3_t vector1, vector3_t vector2)
+{
+    return vector3_make(vector1.data[0U] - vector2.data[0U],
+                        vector1.data[1U] - vector2.data[1U],
+                        vector1.data[2U] - vector2.data[2U]);
+}
+
+static inline vector3_t vector3_scaled(vector3_t vector, vector3_data_t scalar)
+{
+    return vector3_make(vector.data[0U] * scalar,
+                        vector.data[1U] * scalar,
+                        vector.data[2U] * scalar);
+}
+
+static inline vector3_t vector3_neg(vector3_t vector)
+{
+    return vector3_make(-vector.data[0U], -vector.data[1U], -vector.data[2U]);
+}
+
+static inline vector3_data_t vector3_inner(vector3_t vector1,
+                                           vector3_t vector2)
+{
+    return vector1.data[0U] * vector2.data[0U] +
+           vector1.data[1U] * vector2.data[1U] +
+           vector1.data[2U] * vector2.data[2U];
+}
+
+static inline vector3_t vector3_cross_product(vector3_t vector1,
+                                              vector3_t vector2)
+{
+    return vector3_make(
+        vector1.data[1U] * vector2.data[2U] -
+            vector1.data[2U] * vector2.data[1U],
+        vector1.data[2U] * vector2.data[0U] -
+            vector1.data[0U] * vector2.data[2U],
+        vector1.data[0U] * vector2.data[1U] -
+            vector1.data[1U] * vector2.data[0U]);
+}
+
+static inline vector3_data_t vector3_length(vector3_t vector)
+{
+    return sqrtf(vector3_inner(vector, vector));
+}
+
+static inline vector3_t vector3_unit(vector3_t vector)
+{
+    vector3_data_t magnitude = vector3_length(vector);
+
+    return vector3_make(vector.data[0U] / magnitude,
+                        vector.data[1U] / magnitude,
+                        vector.data[2U] / magnitude);
+}
+
+static inline vector3_t vector3_unit_fast(vector3_t vector)
+{
+    return vector3_scaled(vector, linalg_rsqrt(vector3_inner(vector, vector)));
+}
+
+static inline matrix3_t matrix3_identity(void)
+{
+    matrix3_t identity = {{{1.0F, 0.0F, 0.0F},
+                           {0.0F, 1.0F, 0.0F},
+                           {0.0F, 0.0F, 1.0F}}};
+
+    return identity;
+}
+
+static inline matrix3_t matrix3_add(matrix3_t matrix1, matrix3_t matrix2)
+{
+    matrix3_t sum;
+
+    for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
+        for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
+            sum.data[row][column] =
+                matrix1.data[row][column] + matrix2.data[row][column];
+        }
+    }
+
+    return sum;
+}
+
+static inline matrix3_t matrix3_sub(matrix3_t matrix1, matrix3_t matrix2)
+{
+    matrix3_t difference;
+
+    for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
+        for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
+            difference.data[row][column] =
+                matrix1.data[row][column] - matrix2.data[row][column];
+        }
+    }
+
+    return difference;
+}
+
+static inline matrix3_t matrix3_scaled(matrix3_t matrix, matrix3_data_t scalar)
+{
+    for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
+        for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
+            matrix.data[row][column] *= scalar;
+        }
+    }
+
+    return matrix;
+}
+
+static inline matrix3_t matrix3_mul(matrix3_t matrix1, matrix3_t matrix2)
+{
+    matrix3_t product;
+
+    for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
+        for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
+            product.data[row][column] =
+                matrix1.data[row][0U] * matrix2.data[0U][column] +
+                matrix1.data[row][1U] * matrix2.data[1U][column] +
+                matrix1.data[row][2U] * matrix2.data[2U][column];
+        }
+    }
+
+    return product;
+}
+
+static inline vector3_t matrix3_mul_vector3(matrix3_t matrix, vector3_t vector)
+{
+    return vector3_make(
+        matrix.data[0U][0U] * vector.data[0U] +
+            matrix.data[0U][1U] * vector.data[1U] +
+            matrix.data[0U][2U] * vector.data[2U],
+        matrix.data[1U][0U] * vector.data[0U] +
+            matrix.data[1U][1U] * vector.data[1U] +
+            matrix.data[1U][2U] * vector.data[2U],
+        matrix.data[2U][0U] * vector.data[0U] +
+            matrix.data[2U][1U] * vector.data[1U] +
+            matrix.data[2U][2U] * vector.data[2U]);
+}
+
+static inline matrix3_t matrix3_transposed(matrix3_t matrix)
+{
+    matrix3_t transpose;
+
+    for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
+        for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
+            transpose.data[row][column] = matrix.data[column][row];
+        }
+    }
+
+    return transpose;
+}
+
+static inline matrix3_data_t matrix3_determinant(matrix3_t matrix)
+{
+    matrix3_data_t const (*m)[3U] = matrix.data;
+
+    return m[0U][0U] * (m[1U][1U] * m[2U][2U] - m[1U][2U] * m[2U][1U]) -
+           m[0U][1U] * (m[1U][0U] * m[2U][2U] - m[1U][2U] * m[2U][0U]) +
+           m[0U][2U] * (m[1U][0U] * m[2U][1U] - m[1U][1U] * m[2U][0U]);
+}
+
+// Adjugate divided by the determinant. matrix3_inverse rejects matrices with
+// a determinant below 1E-6 in magnitude; this variant does not check.
+static inline matrix3_t matrix3_inverted(matrix3_t matrix)
+{
+    matrix3_data_t const (*m)[3U] = matrix.data;
+    vector3_t row0 = vector3_make(m[0U][0U], m[0U][1U], m[0U][2U]);
+    vector3_t row1 = vector3_make(m[1U][0U], m[1U][1U], m[1U][2U]);
+    vector3_t row2 = vector3_make(m[2U][0U], m[2U][1U], m[2U][2U]);
+
+    // The cofactor rows are the cross products of the other two rows, so
+    // they form the columns of the adjugate.
+    vector3_t cofactor0 = vector3_cross_product(row1, row2);
+    vector3_t cofactor1 = vector3_cross_product(row2, row0);
+    vector3_t cofactor2 = vector3_cross_product(row0, row1);
+    matrix3_data_t det_inv = 1.0F / vector3_inner(row0, cofactor0);
+
+    matrix3_t inverse;
+
+    for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
+        inverse.data[row][0U] = cofactor0.data[row] * det_inv;
+        inverse.data[row][1U] = cofactor1.data[row] * det_inv;
+        inverse.data[row][2U] = cofactor2.data[row] * det_inv;
+    }
+
+    return inverse;
+}
+
+static inline quaternion3_t quaternion3_make(quaternion3_data_t w,
+                                             quaternion3_data_t x,
+                                             quaternion3_data_t y,
+                                             quaternion3_data_t z)
+{
+    quaternion3_t quaternion = {w, x, y, z};
+
+    return quaternion;
+}
+
+static inline quaternion3_t quaternion3_add(quaternion3_t quaternion1,
+                                            quaternion3_t quaternion2)
+{
+    return quaternion3_make(quaternion1.w + quaternion2.w,
+                            quaternion1.x + quaternion2.x,
+                            quaternion1.y + quaternion2.y,
+                            quaternion1.z + quaternion2.z);
+}
+
+static inline quaternion3_t quaternion3_sub(quaternion3_t quaternion1,
+                                            quaternion3_t quaternion2)
+{
+    return quaternion3_make(quaternion1.w - quaternion2.w,
+                            quaternion1.x - quaternion2.x,
+                            quaternion1.y - quaternion2.y,
+                            quaternion1.z - quaternion2.z);
+}
+
+// Hamilton product quaternion1 * quaternion2.
+static inline quaternion3_t quaternion3_mul(quaternion3_t q1, quaternion3_t q2)
+{
+    return quaternion3_make(q1.w * q2.w - q1.x * q2.x - q1.y * q2.y -
+                                q1.z * q2.z,
+                            q1.w * q2.x + q1.x * q2.w + q1.y * q2.z -
+                                q1.z * q2.y,
+                            q1.w * q2.y - q1.x * q2.z + q1.y * q2.w +
+                                q1.z * q2.x,
+                            q1.w * q2.z + q1.x * q2.y - q1.y * q2.x +
+                                q1.z * q2.w);
+}
+
+static inline quaternion3_t quaternion3_scaled(quaternion3_t quaternion,
+                                               quaternion3_data_t scalar)
+{
+    return quaternion3_make(quaternion.w * scalar,
+                            quaternion.x * scalar,
+                            quaternion.y * scalar,
+                            quaternion.z * scalar);
+}
+
+static inline quaternion3_t quaternion3_conjugated(quaternion3_t quaternion)
+{
+    return quaternion3_make(quaternion.w,
+                            -quaternion.x,
+                            -quaternion.y,
+                            -quaternion.z);
+}
+
+static inline quaternion3_data_t quaternion3_inner(quaternion3_t quaternion1,
+                                                   quaternion3_t quaternion2)
+{
+    return quaternion1.w * quaternion2.w + quaternion1.x * quaternion2.x +
+           quaternion1.y * quaternion2.y + quaternion1.z * quaternion2.z;
+}
+
+static inline quaternion3_t quaternion3_inverted(quaternion3_t quaternion)
+{
+    quaternion3_data_t mag_sq = quaternion3_inner(quaternion, quaternion);
+    quaternion3_t conj = quaternion3_conjugated(quaternion);
+
+    return quaternion3_make(conj.w / mag_sq,
+                            conj.x / mag_sq,
+                            conj.y / mag_sq,
+                            conj.z / mag_sq);
+}
+
+static inline quaternion3_data_t quaternion3_length(quaternion3_t quaternion)
+{
+    return sqrtf(quaternion3_inner(quaternion, quaternion));
+}
+
+static inline quaternion3_t quaternion3_unit(quaternion3_t quaternion)
+{
+    quaternion3_data_t mag = quaternion3_length(quaternion);
+
+    return quaternion3_make(quaternion.w / mag,
+                            quaternion.x / mag,
+                            quaternion.y / mag,
+                            quaternion.z / mag);
+}
+
+static inline quaternion3_t quaternion3_unit_fast(quaternion3_t quaternion)
+{
+    return quaternion3_scaled(
+        quaternion, linalg_rsqrt(quaternion3_inner(quaternion, quaternion)));
+}
+
+// Applies transform2 first, then transform1, like transform3_compose.
+static inline transform3_t transform3_mul(transform3_t transform1,
+                                          transform3_t transform2)
+{
+    transform3_t compose = {
+        matrix3_mul(transform1.rotation, transform2.rotation),
+        vector3_add(
+            transform1.translation,
+            matrix3_mul_vector3(transform1.rotation, transform2.translation)),
+    };
+
+    return compose;
+}
+
+static inline vector3_t transform3_apply(transform3_t transform,
+                                         vector3_t vector)
+{
+    return vector3_add(matrix3_mul_vector3(transform.rotation, vector),
+                       transform.translation);
+}
+
+// Assumes an orthonormal rotation, like transform3_rigid_inverse.
+static inline transform3_t transform3_rigid_inverted(transform3_t transform)
+{
+    transform3_t inverse;
+
+    inverse.rotation = matrix3_transposed(transform.rotation);
+    inverse.translation = vector3_neg(
+        matrix3_mul_vector3(inverse.rotation, transform.translation));
+
+    return inverse;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_LINALG_INLINE_H
@@ -0,0 +1,442 @@
+#include "linalg_kf.h"
+#include "linalg_profile.h"
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define LINALG_KF_MATRICES 7U
+
+static bool linalg_kf_has_shape(matrix_t const* matrix,
+                                matrix_size_t rows,
+                                matrix_size_t columns)
+{
+    return matrix->rows == rows && matrix->columns == columns;
+}
+
+static void linalg_kf_matrices(linalg_kf_t* kf,
+                               matrix_t* (*matrices)[LINALG_KF_MATRICES])
+{
+    (*matrices)[0U] = &kf->state;
+    (*matrices)[1U] = &kf->covariance;
+    (*matrices)[2U] = &kf->innovation;
+    (*matrices)[3U] = &kf->innovation_covariance;
+    (*matrices)[4U] = &kf->gain;
+    (*matrices)[5U] = &kf->cross_covariance;
+    (*matrices)[6U] = &kf->scratch;
+}
+
+linalg_kf_err_t linalg_kf_initialize(linalg_kf_t* kf,
+                                     matrix_size_t state_size,
+                                     matrix_size_t measurement_size,
+                                     matrix_allocator_t const* allocator)
+{
+    if (kf == NULL || allocator == NULL) {
+        return LINALG_KF_ERR_NULL;
+    }
+
+    if (state_size == 0UL || measurement_size == 0UL) {
+        return LINALG_KF_ERR_DIMENSION;
+    }
+
+    memset(kf, 0, sizeof(*kf));
+    kf->state_size = state_size;
+    kf->measurement_size = measurement_size;
+
+    matrix_t* matrices[LINALG_KF_MATRICES];
+    linalg_kf_matrices(kf, &matrices);
+
+    matrix_size_t const shapes[LINALG_KF_MATRICES][2U] = {
+        {state_size, 1UL},
+        {state_size, state_size},
+        {measurement_size, 1UL},
+        {measurement_size, measurement_size},
+        {measurement_size, state_size},
+        {measurement_size, state_size},
+        {state_size, state_size},
+    };
+
+    for (size_t index = 0UL; index < LINALG_KF_MATRICES; ++index) {
+        matrix_initialize(matrices[index], allocator);
+
+        if (matrix_create_with_zeros(matrices[index],
+                                     shapes[index][0U],
+                                     shapes[index][1U]) != MATRIX_ERR_OK) {
+            linalg_kf_deinitialize(kf);
+            return LINALG_KF_ERR_ALLOC;
+        }
+    }
+
+    return LINALG_KF_ERR_OK;
+}
+
+linalg_kf_err_t linalg_kf_deinitialize(linalg_kf_t* kf)
+{
+    if (kf == NULL) {
+        return LINALG_KF_ERR_NULL;
+    }
+
+    matrix_t* matrices[LINALG_KF_MATRICES];
+    linalg_kf_matrices(kf, &matrices);
+
+    for (size_t index = 0UL; index < LINALG_KF_MATRICES; ++index) {
+        matrix_delete(matrices[index]);
+    }
+
+    memset(kf, 0, sizeof(*kf));
+
+    return LINALG_KF_ERR_OK;
+}
+
+// Copies the lower triangle of P over the upper one, so that the products
+// below can read whole rows while only the lower triangle is trusted.
+static void linalg_kf_mirror(matrix_data_t* p, matrix_size_t n)
+{
+    for (matrix_size_t row = 1UL; row < n; ++row) {
+        for (matrix_size_t column = 0UL; column < row; ++column) {
+            p[column * n + row] = p[row * n + column];
+        }
+    }
+}
+
+// P = F P F^T + Q. F P goes to scratch, then only the lower triangle of the
+// symmetric result is computed and mirrored, halving the second product.
+static void linalg_kf_propagate(linalg_kf_t* kf,
+                                matrix_t const* transition,
+                                matrix_t const* process_noise)
+{
+    matrix_size_t n = kf->state_size;
+    matrix_data_t const* f = transition->data;
+    matrix_data_t const* q = process_noise->data;
+    matrix_data_t* p = kf->covariance.data;
+    matrix_data_t* fp = kf->scratch.data;
+
+    linalg_kf_mirror(p, n);
+
+    for (matrix_size_t row = 0UL; row < n; ++row) {
+        matrix_data_t* fp_row = &fp[row * n];
+        memset(fp_row, 0, sizeof(matrix_data_t) * n);
+
+        for (matrix_size_t common = 0UL; common < n; ++common) {
+            matrix_data_t factor = f[row * n + common];
+            matrix_data_t const* p_row = &p[common * n];
+
+            for (matrix_size_t column = 0UL; column < n; ++column) {
+                fp_row[column] += factor * p_row[column];
+            }
+        }
+    }
+
+    for (matrix_size_t row = 0UL; row < n; ++row) {
+        matrix_data_t const* fp_row = &fp[row * n];
+
+        for (matrix_size_t column = 0UL; column <= row; ++column) {
+            matrix_data_t const* f_row = &f[column * n];
+            matrix_data_t sum = q[row * n + column];
+
+            for (matrix_size_t common = 0UL; common < n; ++common) {
+                sum += fp_row[common] * f_row[common];
+            }
+
+            p[row * n + column] = sum;
+            p[column * n + row] = sum;
+        }
+    }
+}
+
+linalg_kf_err_t linalg_kf_predict(linalg_kf_t* kf,
+                                  matrix_t const* transition,
+                                  matrix_t const* process_noise)
+{
+    if (kf == NULL || transition == NULL || process_noise == NULL) {
+        return LINALG_KF_ERR_NULL;
+    }
+
+    matrix_size_t n = kf->state_size;
+
+    LINALG_PROFILE_FUNCTION(linalg_kf_predict,
+                            3UL * n * n * n + 2UL * n * n,
+                            sizeof(matrix_data_t) * 5UL * n * n);
+
+    if (!linalg_kf_has_shape(transition, n, n) ||
+        !linalg_kf_has_shape(process_noise, n, n)) {
+        return LINALG_KF_ERR_DIMENSION;
+    }
+
+    matrix_data_t const* f = transition->data;
+    matrix_data_t* x = kf->state.data;
+    matrix_data_t* fx = kf->scratch.data;
+
+    for (matrix_size_t row = 0UL; row < n; ++row) {
+        matrix_data_t sum = 0.0F;
+
+        for (matrix_size_t column = 0UL; column < n; ++column) {
+            sum += f[row * n + column] * x[column];
+        }
+
+        fx[row] = sum;
+    }
+
+    memcpy(x, fx, sizeof(matrix_data_t) * n);
+
+    linalg_kf_propagate(kf, transition, process_noise);
+
+    return LINALG_KF_ERR_OK;
+}
+
+linalg_kf_err_t linalg_kf_predict_covariance(linalg_kf_t* kf,
+                                             matrix_t const* transition,
+                                             matrix_t const* process_noise)
+{
+    if (kf == NULL || transition == NULL || process_noise == NULL) {
+        return LINALG_KF_ERR_NULL;
+    }
+
+    matrix_size_t n = kf->state_size;
+
+    LINALG_PROFILE_FUNCTION(linalg_kf_predict_covariance,
+                            3UL * n * n * n,
+                            sizeof(matrix_data_t) * 5UL * n * n);
+
+    if (!linalg_kf_has_shape(transition, n, n) ||
+        !linalg_kf_has_shape(process_noise, n, n)) {
+        return LINALG_KF_ERR_DIMENSION;
+    }
+
+    linalg_kf_propagate(kf, transition, process_noise);
+
+    return LINALG_KF_ERR_OK;
+}
+
+// In-place lower Cholesky factorization reading only the lower triangle.
+static bool linalg_kf_cholesky(matrix_data_t* s, matrix_size_t m)
+{
+    for (matrix_size_t column = 0UL; column < m; ++column) {
+        matrix_data_t* pivot_row = &s[column * m];
+        matrix_data_t diagonal = pivot_row[column];
+
+        for (matrix_size_t common = 0UL; common < column; ++common) {
+            diagonal -= pivot_row[common] * pivot_row[common];
+        }
+
+        if (!(diagonal > 0.0F)) {
+            return false;
+        }
+
+        diagonal = sqrtf(diagonal);
+        pivot_row[column] = diagonal;
+
+        matrix_data_t diagonal_inv = 1.0F / diagonal;
+
+        for (matrix_size_t row = column + 1UL; row < m; ++row) {
+            matrix_data_t* s_row = &s[row * m];
+            matrix_data_t sum = s_row[column];
+
+            for (matrix_size_t common = 0UL; common < column; ++common) {
+                sum -= s_row[common] * pivot_row[common];
+            }
+
+            s_row[column] = sum * diagonal_inv;
+        }
+    }
+
+    return true;
+}
+
+// Gain rows are solved as L L^T K^T = H P with whole-row updates, so every
+// inner loop runs contiguously over state_size elements.
+static void linalg_kf_solve_gain(linalg_kf_t* kf)
+{
+    matrix_size_t n = kf->state_size;
+    matrix_size_t m = kf->measurement_size;
+    matrix_data_t const* l = kf->innovation_covariance.data;
+    matrix_data_t* kt = kf->gain.data;
+
+    memcpy(kt, kf->cross_covariance.data, sizeof(matrix_data_t) * m * n);
+
+    for (matrix_size_t row = 0UL; row < m; ++row) {
+        matrix_data_t* kt_row = &kt[row * n];
+
+        for (matrix_size_t common = 0UL; common < row; ++common) {
+            matrix_data_t factor = l[row * m + common];
+            matrix_data_t const* kt_common = &kt[common * n];
+
+            for (matrix_size_t column = 0UL; column < n; ++column) {
+                kt_row[column] -= factor * kt_common[column];
+            }
+        }
+
+        matrix_data_t diagonal_inv = 1.0F / l[row * m + row];
+
+        for (matrix_size_t column = 0UL; column < n; ++column) {
+            kt_row[column] *= diagonal_inv;
+        }
+    }
+
+    for (matrix_size_t row = m; row-- > 0UL;) {
+        matrix_data_t* kt_row = &kt[row * n];
+
+        for (matrix_size_t common = row + 1UL; common < m; ++common) {
+            matrix_data_t factor = l[common * m + row];
+            matrix_data_t const* kt_common = &kt[common * n];
+
+            for (matrix_size_t column = 0UL; column < n; ++column) {
+                kt_row[column] -= factor * kt_common[column];
+            }
+        }
+
+        matrix_data_t diagonal_inv = 1.0F / l[row * m + row];
+
+        for (matrix_size_t column = 0UL; column < n; ++column) {
+            kt_row[column] *= diagonal_inv;
+        }
+    }
+}
+
+linalg_kf_err_t linalg_kf_update_innovation(linalg_kf_t* kf,
+                                            matrix_t const* innovation,
+                                            matrix_t const* observation,
+                                            matrix_t const* measurement_noise)
+{
+    if (kf == NULL || innovation == NULL || observation == NULL ||
+        measurement_noise == NULL) {
+        return LINALG_KF_ERR_NULL;
+    }
+
+    matrix_size_t n = kf->state_size;
+    matrix_size_t m = kf->measurement_size;
+
+    LINALG_PROFILE_FUNCTION(linalg_kf_update_innovation,
+                            3UL * m * n * n + 3UL * m * m * n + m * m * m / 3UL,
+                            sizeof(matrix_data_t) *
+                                (3UL * n * n + 4UL * m * n + 2UL * m * m));
+
+    if (!linalg_kf_has_shape(innovation, m, 1UL) ||
+        !linalg_kf_has_shape(observation, m, n) ||
+        !linalg_kf_has_shape(measurement_noise, m, m)) {
+        return LINALG_KF_ERR_DIMENSION;
+    }
+
+    if (innovation != &kf->innovation) {
+        memcpy(kf->innovation.data, innovation->data, sizeof(matrix_data_t) * m);
+    }
+
+    matrix_data_t const* h = observation->data;
+    matrix_data_t const* r = measurement_noise->data;
+    matrix_data_t* p = kf->covariance.data;
+    matrix_data_t* hp = kf->cross_covariance.data;
+    matrix_data_t* s = kf->innovation_covariance.data;
+
+    linalg_kf_mirror(p, n);
+
+    // H P, which equals (P H^T)^T because P is symmetric.
+    for (matrix_size_t row = 0UL; row < m; ++row) {
+        matrix_data_t* hp_row = &hp[row * n];
+        memset(hp_row, 0, sizeof(matrix_data_t) * n);
+
+        for (matrix_size_t common = 0UL; common < n; ++common) {
+            matrix_data_t factor = h[row * n + common];
+            matrix_data_t const* p_row = &p[common * n];
+
+            for (matrix_size_t column = 0UL; column < n; ++column) {
+                hp_row[column] += factor * p_row[column];
+            }
+        }
+    }
+
+    // Lower triangle of S = H P H^T + R.
+    for (matrix_size_t row = 0UL; row < m; ++row) {
+        matrix_data_t const* h_row = &h[row * n];
+
+        for (matrix_size_t column = 0UL; column <= row; ++column) {
+            matrix_data_t const* hp_row = &hp[column * n];
+            matrix_data_t sum = r[row * m + column];
+
+            for (matrix_size_t common = 0UL; common < n; ++common) {
+                sum += h_row[common] * hp_row[common];
+            }
+
+            s[row * m + column] = sum;
+        }
+    }
+
+    if (!linalg_kf_cholesky(s, m)) {
+        return LINALG_KF_ERR_INDEFINITE;
+    }
+
+    linalg_kf_solve_gain(kf);
+
+    matrix_data_t const* kt = kf->gain.data;
+    matrix_data_t const* y = kf->innovation.data;
+    matrix_data_t* x = kf->state.data;
+
+    for (matrix_size_t row = 0UL; row < m; ++row) {
+        matrix_data_t const* kt_row = &kt[row * n];
+
+        for (matrix_size_t column = 0UL; column < n; ++column) {
+            x[column] += kt_row[column] * y[row];
+        }
+    }
+
+    // P -= K H P on the lower triangle, mirrored to keep P symmetric.
+    for (matrix_size_t row = 0UL; row < n; ++row) {
+        matrix_data_t* p_row = &p[row * n];
+
+        for (matrix_size_t common = 0UL; common < m; ++common) {
+            matrix_data_t factor = kt[common * n + row];
+            matrix_data_t const* hp_row = &hp[common * n];
+
+            for (matrix_size_t column = 0UL; column <= row; ++column) {
+                p_row[column] -= factor * hp_row[column];
+            }
+        }
+
+        for (matrix_size_t column = 0UL; column < row; ++column) {
+            p[column * n + row] = p_row[column];
+        }
+    }
+
+    return LINALG_KF_ERR_OK;
+}
+
+linalg_kf_err_t linalg_kf_update(linalg_kf_t* kf,
+                                 matrix_t const* measurement,
+                                 matrix_t const* observation,
+                                 matrix_t const* measurement_noise)
+{
+    if (kf == NULL || measurement == NULL || observation == NULL ||
+        measurement_noise == NULL) {
+        return LINALG_KF_ERR_NULL;
+    }
+
+    matrix_size_t n = kf->state_size;
+    matrix_size_t m = kf->measurement_size;
+
+    LINALG_PROFILE_FUNCTION(linalg_kf_update,
+                            2UL * m * n,
+                            sizeof(matrix_data_t) * (m * n + n + 2UL * m));
+
+    if (!linalg_kf_has_shape(measurement, m, 1UL) ||
+        !linalg_kf_has_shape(observation, m, n)) {
+        return LINALG_KF_ERR_DIMENSION;
+    }
+
+    matrix_data_t const* z = measurement->data;
+    matrix_data_t const* h = observation->data;
+    matrix_data_t const* x = kf->state.data;
+    matrix_data_t* y = kf->innovation.data;
+
+    for (matrix_size_t row = 0UL; row < m; ++row) {
+        matrix_data_t sum = z[row];
+
+        for (matrix_size_t column = 0UL; column < n; ++column) {
+            sum -= h[row * n + column] * x[column];
+        }
+
+        y[row] = sum;
+    }
+
+    return linalg_kf_update_innovation(kf,
+                                       &kf->innovation,
+                                       observation,
+                                       measurement_noise);
+}
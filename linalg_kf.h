@@ -0,0 +1,77 @@
+#ifndef LINALG_LINALG_KF_H
+#define LINALG_LINALG_KF_H
+
+#include "matrix.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    LINALG_KF_ERR_OK = 0,
+    LINALG_KF_ERR_FAIL,
+    LINALG_KF_ERR_NULL,
+    LINALG_KF_ERR_ALLOC,
+    LINALG_KF_ERR_DIMENSION,
+    LINALG_KF_ERR_INDEFINITE,
+} linalg_kf_err_t;
+
+// Kalman filter with every workspace matrix allocated once at initialization,
+// so predict and update never allocate. state is state_size x 1 and
+// covariance state_size x state_size; both start at zero and may be written
+// directly between steps. Only the lower triangles of covariance and of the
+// noise matrices are read; each step copies the lower triangle of covariance
+// over the upper one, so covariance is kept exactly symmetric.
+//
+// After an update, innovation holds z - H x, innovation_covariance the lower
+// Cholesky factor of H P H^T + R, and gain the transposed Kalman gain.
+typedef struct {
+    matrix_size_t state_size;
+    matrix_size_t measurement_size;
+    matrix_t state;
+    matrix_t covariance;
+    matrix_t innovation;
+    matrix_t innovation_covariance;
+    matrix_t gain;
+    matrix_t cross_covariance;
+    matrix_t scratch;
+} linalg_kf_t;
+
+linalg_kf_err_t linalg_kf_initialize(linalg_kf_t* kf,
+                                     matrix_size_t state_size,
+                                     matrix_size_t measurement_size,
+                                     matrix_allocator_t const* allocator);
+
+linalg_kf_err_t linalg_kf_deinitialize(linalg_kf_t* kf);
+
+// x = F x, P = F P F^T + Q.
+linalg_kf_err_t linalg_kf_predict(linalg_kf_t* kf,
+                                  matrix_t const* transition,
+                                  matrix_t const* process_noise);
+
+// P = F P F^T + Q only, for extended filters that propagate the state
+// through their own nonlinear model.
+linalg_kf_err_t linalg_kf_predict_covariance(linalg_kf_t* kf,
+                                             matrix_t const* transition,
+                                             matrix_t const* process_noise);
+
+// Corrects with measurement z (measurement_size x 1) observed through H.
+// The innovation covariance is factored by Cholesky instead of inverted;
+// LINALG_KF_ERR_INDEFINITE leaves state and covariance unchanged.
+linalg_kf_err_t linalg_kf_update(linalg_kf_t* kf,
+                                 matrix_t const* measurement,
+                                 matrix_t const* observation,
+                                 matrix_t const* measurement_noise);
+
+// Same as linalg_kf_update with a precomputed innovation, such as z - h(x)
+// for an extended filter. innovation may be kf->innovation.
+linalg_kf_err_t linalg_kf_update_innovation(linalg_kf_t* kf,
+                                            matrix_t const* innovation,
+                                            matrix_t const* observation,
+                                            matrix_t const* measurement_noise);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_LINALG_KF_H
@@ -0,0 +1,927 @@
+#include "linalg_krylov.h"
+#include "linalg_profile.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+static vector_data_t linalg_krylov_dot(vector_data_t const* a,
+                                       vector_data_t const* b,
+                                       vector_size_t size)
+{
+    vector_data_t sum = 0.0F;
+
+    for (vector_size_t index = 0UL; index < size; ++index) {
+        sum += a[index] * b[index];
+    }
+
+    return sum;
+}
+
+static vector_data_t linalg_krylov_norm(vector_data_t const* a,
+                                        vector_size_t size)
+{
+    return sqrtf(linalg_krylov_dot(a, a, size));
+}
+
+// y += alpha x.
+static void linalg_krylov_axpy(vector_data_t alpha,
+                               vector_data_t const* x,
+                               vector_data_t* y,
+                               vector_size_t size)
+{
+    for (vector_size_t index = 0UL; index < size; ++index) {
+        y[index] += alpha * x[index];
+    }
+}
+
+// A vector_t over storage owned by someone else, such as a column of the
+// GMRES basis.
+static vector_t linalg_krylov_view(vector_data_t* data, vector_size_t size)
+{
+    vector_t view;
+    memset(&view, 0, sizeof(view));
+    view.data = data;
+    view.size = size;
+
+    return view;
+}
+
+static void linalg_operator_apply_matrix(void* user,
+                                         vector_t const* x,
+                                         vector_t* y)
+{
+    matrix_t const* matrix = user;
+
+    for (matrix_size_t row = 0UL; row < matrix->rows; ++row) {
+        y->data[row] = linalg_krylov_dot(&MATRIX_INDEX(matrix, row, 0UL),
+                                         x->data,
+                                         matrix->columns);
+    }
+}
+
+static void linalg_operator_apply_csr(void* user,
+                                      vector_t const* x,
+                                      vector_t* y)
+{
+    // y already has the right size, so the product cannot fail.
+    matrix_csr_vector_product(user, x, y);
+}
+
+linalg_krylov_err_t linalg_operator_from_matrix(linalg_operator_t* op,
+                                                matrix_t const* matrix)
+{
+    if (op == NULL || matrix == NULL) {
+        return LINALG_KRYLOV_ERR_NULL;
+    }
+
+    if (matrix->rows != matrix->columns) {
+        return LINALG_KRYLOV_ERR_DIMENSION;
+    }
+
+    op->user = (void*)matrix;
+    op->apply = linalg_operator_apply_matrix;
+    op->size = matrix->rows;
+
+    return LINALG_KRYLOV_ERR_OK;
+}
+
+linalg_krylov_err_t linalg_operator_from_csr(linalg_operator_t* op,
+                                             matrix_csr_t const* csr)
+{
+    if (op == NULL || csr == NULL) {
+        return LINALG_KRYLOV_ERR_NULL;
+    }
+
+    if (csr->rows != csr->columns) {
+        return LINALG_KRYLOV_ERR_DIMENSION;
+    }
+
+    op->user = (void*)csr;
+    op->apply = linalg_operator_apply_csr;
+    op->size = csr->rows;
+
+    return LINALG_KRYLOV_ERR_OK;
+}
+
+// Entry of column column in row row of a sorted matrix, or SIZE_MAX.
+static matrix_size_t linalg_preconditioner_find(matrix_csr_t const* csr,
+                                                matrix_size_t row,
+                                                matrix_size_t column)
+{
+    for (matrix_size_t entry = csr->row_offsets[row];
+         entry < csr->row_offsets[row + 1UL];
+         ++entry) {
+        if (csr->column_indices[entry] == column) {
+            return entry;
+        }
+    }
+
+    return SIZE_MAX;
+}
+
+static bool linalg_preconditioner_jacobi(linalg_preconditioner_t* pc,
+                                         matrix_csr_t const* csr)
+{
+    for (matrix_size_t row = 0UL; row < csr->rows; ++row) {
+        matrix_size_t entry = linalg_preconditioner_find(csr, row, row);
+        if (entry == SIZE_MAX || csr->data[entry] == 0.0F) {
+            return false;
+        }
+
+        pc->inverse_diagonal.data[row] = 1.0F / csr->data[entry];
+    }
+
+    return true;
+}
+
+// IKJ variant of ILU(0): row row is eliminated by the rows above it in
+// column order, and only updates that land on an existing entry of row row
+// are kept. position maps a column to its entry in row row.
+static bool linalg_preconditioner_ilu0(linalg_preconditioner_t* pc,
+                                       matrix_size_t* position)
+{
+    matrix_csr_t* lu = &pc->factor;
+    matrix_data_t* inverse_diagonal = pc->inverse_diagonal.data;
+
+    for (matrix_size_t column = 0UL; column < lu->rows; ++column) {
+        position[column] = SIZE_MAX;
+    }
+
+    for (matrix_size_t row = 0UL; row < lu->rows; ++row) {
+        matrix_size_t begin = lu->row_offsets[row];
+        matrix_size_t end = lu->row_offsets[row + 1UL];
+
+        for (matrix_size_t entry = begin; entry < end; ++entry) {
+            position[lu->column_indices[entry]] = entry;
+        }
+
+        for (matrix_size_t entry = begin; entry < end; ++entry) {
+            matrix_size_t k = lu->column_indices[entry];
+            if (k >= row) {
+                break;
+            }
+
+            matrix_data_t multiplier = lu->data[entry] * inverse_diagonal[k];
+            lu->data[entry] = multiplier;
+
+            for (matrix_size_t upper = lu->row_offsets[k];
+                 upper < lu->row_offsets[k + 1UL];
+                 ++upper) {
+                matrix_size_t column = lu->column_indices[upper];
+
+                if (column > k && position[column] != SIZE_MAX) {
+                    lu->data[position[column]] -=
+                        multiplier * lu->data[upper];
+                }
+            }
+        }
+
+        matrix_size_t diagonal = position[row];
+
+        for (matrix_size_t entry = begin; entry < end; ++entry) {
+            position[lu->column_indices[entry]] = SIZE_MAX;
+        }
+
+        if (diagonal == SIZE_MAX || lu->data[diagonal] == 0.0F) {
+            return false;
+        }
+
+        inverse_diagonal[row] = 1.0F / lu->data[diagonal];
+    }
+
+    return true;
+}
+
+// Row-oriented IC(0) on the lower triangle: l_rk for k < r subtracts the
+// overlap of rows r and k left of column k, found by merging the two
+// sorted rows.
+static bool linalg_preconditioner_ic0(linalg_preconditioner_t* pc)
+{
+    matrix_csr_t* l = &pc->factor;
+    matrix_data_t* inverse_diagonal = pc->inverse_diagonal.data;
+
+    for (matrix_size_t row = 0UL; row < l->rows; ++row) {
+        matrix_size_t begin = l->row_offsets[row];
+        matrix_size_t end = l->row_offsets[row + 1UL];
+
+        if (begin == end || l->column_indices[end - 1UL] != row) {
+            return false;
+        }
+
+        for (matrix_size_t entry = begin; entry < end; ++entry) {
+            matrix_size_t k = l->column_indices[entry];
+            matrix_data_t sum = l->data[entry];
+            matrix_size_t other = l->row_offsets[k];
+            matrix_size_t other_end = l->row_offsets[k + 1UL] - 1UL;
+
+            for (matrix_size_t mine = begin; mine < entry;) {
+                if (other >= other_end) {
+                    break;
+                }
+
+                matrix_size_t mine_column = l->column_indices[mine];
+                matrix_size_t other_column = l->column_indices[other];
+
+                if (mine_column == other_column) {
+                    sum -= l->data[mine] * l->data[other];
+                    ++mine;
+                    ++other;
+                } else if (mine_column < other_column) {
+                    ++mine;
+                } else {
+                    ++other;
+                }
+            }
+
+            if (k < row) {
+                l->data[entry] = sum * inverse_diagonal[k];
+            } else if (sum > 0.0F) {
+                l->data[entry] = sqrtf(sum);
+                inverse_diagonal[row] = 1.0F / l->data[entry];
+            } else {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static matrix_err_t linalg_preconditioner_copy(matrix_csr_t const* csr,
+                                               bool lower,
+                                               matrix_csr_t* factor)
+{
+    matrix_size_t nonzeros = 0UL;
+
+    for (matrix_size_t row = 0UL; row < csr->rows; ++row) {
+        for (matrix_size_t entry = csr->row_offsets[row];
+             entry < csr->row_offsets[row + 1UL];
+             ++entry) {
+            if (!lower || csr->column_indices[entry] <= row) {
+                ++nonzeros;
+            }
+        }
+    }
+
+    matrix_err_t err =
+        matrix_csr_create(factor, csr->rows, csr->columns, nonzeros);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    matrix_size_t target = 0UL;
+
+    for (matrix_size_t row = 0UL; row < csr->rows; ++row) {
+        factor->row_offsets[row] = target;
+
+        for (matrix_size_t entry = csr->row_offsets[row];
+             entry < csr->row_offsets[row + 1UL];
+             ++entry) {
+            if (!lower || csr->column_indices[entry] <= row) {
+                factor->column_indices[target] = csr->column_indices[entry];
+                factor->data[target] = csr->data[entry];
+                ++target;
+            }
+        }
+    }
+
+    factor->row_offsets[csr->rows] = target;
+
+    return MATRIX_ERR_OK;
+}
+
+linalg_krylov_err_t linalg_preconditioner_initialize(
+    linalg_preconditioner_t* preconditioner,
+    linalg_preconditioner_kind_t kind,
+    matrix_csr_t const* csr,
+    matrix_allocator_t const* allocator)
+{
+    if (preconditioner == NULL || csr == NULL || allocator == NULL) {
+        return LINALG_KRYLOV_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        linalg_preconditioner_initialize,
+        kind == LINALG_PRECONDITIONER_JACOBI ? csr->rows : 0UL,
+        (sizeof(matrix_data_t) + sizeof(matrix_size_t)) * csr->nonzeros);
+
+    if (csr->rows != csr->columns) {
+        return LINALG_KRYLOV_ERR_DIMENSION;
+    }
+
+    if (kind != LINALG_PRECONDITIONER_JACOBI &&
+        kind != LINALG_PRECONDITIONER_ILU0 &&
+        kind != LINALG_PRECONDITIONER_IC0) {
+        return LINALG_KRYLOV_ERR_FAIL;
+    }
+
+    memset(preconditioner, 0, sizeof(*preconditioner));
+    preconditioner->kind = kind;
+    matrix_csr_initialize(&preconditioner->factor, allocator);
+    matrix_initialize(&preconditioner->inverse_diagonal, allocator);
+
+    if (matrix_create(&preconditioner->inverse_diagonal, csr->rows, 1UL) !=
+            MATRIX_ERR_OK ||
+        (kind != LINALG_PRECONDITIONER_JACOBI &&
+         linalg_preconditioner_copy(csr,
+                                    kind == LINALG_PRECONDITIONER_IC0,
+                                    &preconditioner->factor) !=
+             MATRIX_ERR_OK)) {
+        linalg_preconditioner_deinitialize(preconditioner);
+        return LINALG_KRYLOV_ERR_ALLOC;
+    }
+
+    bool factored = true;
+
+    if (kind == LINALG_PRECONDITIONER_JACOBI) {
+        factored = linalg_preconditioner_jacobi(preconditioner, csr);
+    } else if (kind == LINALG_PRECONDITIONER_IC0) {
+        factored = linalg_preconditioner_ic0(preconditioner);
+    } else {
+        matrix_data_t* position =
+            allocator->allocate == NULL
+                ? NULL
+                : allocator->allocate(allocator->user,
+                                      sizeof(matrix_size_t) * csr->rows);
+        if (position == NULL) {
+            linalg_preconditioner_deinitialize(preconditioner);
+            return LINALG_KRYLOV_ERR_ALLOC;
+        }
+
+        factored = linalg_preconditioner_ilu0(
+            preconditioner, (matrix_size_t*)(void*)position);
+
+        if (allocator->deallocate != NULL) {
+            allocator->deallocate(allocator->user, position);
+        }
+    }
+
+    if (!factored) {
+        linalg_preconditioner_deinitialize(preconditioner);
+        return LINALG_KRYLOV_ERR_SINGULAR;
+    }
+
+    return LINALG_KRYLOV_ERR_OK;
+}
+
+linalg_krylov_err_t linalg_preconditioner_deinitialize(
+    linalg_preconditioner_t* preconditioner)
+{
+    if (preconditioner == NULL) {
+        return LINALG_KRYLOV_ERR_NULL;
+    }
+
+    matrix_csr_delete(&preconditioner->factor);
+    matrix_delete(&preconditioner->inverse_diagonal);
+    memset(preconditioner, 0, sizeof(*preconditioner));
+
+    return LINALG_KRYLOV_ERR_OK;
+}
+
+static void linalg_preconditioner_apply(void* user,
+                                        vector_t const* x,
+                                        vector_t* y)
+{
+    linalg_preconditioner_t const* pc = user;
+    matrix_csr_t const* factor = &pc->factor;
+    matrix_data_t const* inverse_diagonal = pc->inverse_diagonal.data;
+    vector_size_t size = x->size;
+    vector_data_t* z = y->data;
+
+    if (pc->kind == LINALG_PRECONDITIONER_JACOBI) {
+        for (vector_size_t row = 0UL; row < size; ++row) {
+            z[row] = inverse_diagonal[row] * x->data[row];
+        }
+
+        return;
+    }
+
+    bool cholesky = pc->kind == LINALG_PRECONDITIONER_IC0;
+
+    for (vector_size_t row = 0UL; row < size; ++row) {
+        vector_data_t sum = x->data[row];
+
+        for (matrix_size_t entry = factor->row_offsets[row];
+             entry < factor->row_offsets[row + 1UL] &&
+             factor->column_indices[entry] < row;
+             ++entry) {
+            sum -= factor->data[entry] * z[factor->column_indices[entry]];
+        }
+
+        z[row] = cholesky ? sum * inverse_diagonal[row] : sum;
+    }
+
+    for (vector_size_t row = size; row-- > 0UL;) {
+        matrix_size_t begin = factor->row_offsets[row];
+        matrix_size_t end = factor->row_offsets[row + 1UL];
+
+        if (cholesky) {
+            // Row row of L is column row of L^T, so the finished z[row] is
+            // eliminated from the rows above it.
+            vector_data_t value = z[row] * inverse_diagonal[row];
+            z[row] = value;
+
+            for (matrix_size_t entry = begin; entry + 1UL < end; ++entry) {
+                z[factor->column_indices[entry]] -=
+                    factor->data[entry] * value;
+            }
+        } else {
+            vector_data_t sum = z[row];
+
+            for (matrix_size_t entry = end; entry > begin; --entry) {
+                matrix_size_t column = factor->column_indices[entry - 1UL];
+                if (column <= row) {
+                    break;
+                }
+
+                sum -= factor->data[entry - 1UL] * z[column];
+            }
+
+            z[row] = sum * inverse_diagonal[row];
+        }
+    }
+}
+
+linalg_krylov_err_t linalg_preconditioner_operator(
+    linalg_preconditioner_t const* preconditioner,
+    linalg_operator_t* op)
+{
+    if (preconditioner == NULL || op == NULL) {
+        return LINALG_KRYLOV_ERR_NULL;
+    }
+
+    op->user = (void*)preconditioner;
+    op->apply = linalg_preconditioner_apply;
+    op->size = preconditioner->inverse_diagonal.rows;
+
+    return LINALG_KRYLOV_ERR_OK;
+}
+
+static matrix_size_t linalg_krylov_work_count(linalg_krylov_method_t method)
+{
+    switch (method) {
+    case LINALG_KRYLOV_CG:
+        return 4UL;
+    case LINALG_KRYLOV_BICGSTAB:
+        return 8UL;
+    case LINALG_KRYLOV_GMRES:
+        return 2UL;
+    default:
+        return 0UL;
+    }
+}
+
+linalg_krylov_err_t linalg_krylov_initialize(
+    linalg_krylov_t* krylov,
+    linalg_krylov_method_t method,
+    vector_size_t size,
+    matrix_size_t max_iterations,
+    matrix_size_t restart,
+    vector_allocator_t const* allocator)
+{
+    if (krylov == NULL || allocator == NULL) {
+        return LINALG_KRYLOV_ERR_NULL;
+    }
+
+    if (size == 0UL || (method == LINALG_KRYLOV_GMRES && restart == 0UL)) {
+        return LINALG_KRYLOV_ERR_DIMENSION;
+    }
+
+    matrix_size_t work_count = linalg_krylov_work_count(method);
+    if (work_count == 0UL) {
+        return LINALG_KRYLOV_ERR_FAIL;
+    }
+
+    memset(krylov, 0, sizeof(*krylov));
+    krylov->method = method;
+    krylov->size = size;
+    krylov->restart = method == LINALG_KRYLOV_GMRES ? restart : 0UL;
+    krylov->max_iterations = max_iterations;
+    krylov->tolerance = 1E-5F;
+
+    vector_initialize(&krylov->history, allocator);
+    vector_initialize(&krylov->basis, allocator);
+    vector_initialize(&krylov->hessenberg, allocator);
+
+    for (size_t index = 0UL; index < LINALG_KRYLOV_WORK; ++index) {
+        vector_initialize(&krylov->work[index], allocator);
+    }
+
+    bool created =
+        vector_create_with_zeros(&krylov->history, max_iterations + 1UL) ==
+        VECTOR_ERR_OK;
+
+    for (size_t index = 0UL; created && index < work_count; ++index) {
+        created = vector_create_with_zeros(&krylov->work[index], size) ==
+                  VECTOR_ERR_OK;
+    }
+
+    // The basis holds restart + 1 vectors back to back. The Hessenberg
+    // matrix is stored by columns of restart + 1 rows and followed by the
+    // rotation cosines, sines and the rotated right-hand side.
+    if (created && method == LINALG_KRYLOV_GMRES) {
+        created = vector_create_with_zeros(&krylov->basis,
+                                           size * (restart + 1UL)) ==
+                      VECTOR_ERR_OK &&
+                  vector_create_with_zeros(&krylov->hessenberg,
+                                           (restart + 1UL) * (restart + 3UL)) ==
+                      VECTOR_ERR_OK;
+    }
+
+    if (!created) {
+        linalg_krylov_deinitialize(krylov);
+        return LINALG_KRYLOV_ERR_ALLOC;
+    }
+
+    return LINALG_KRYLOV_ERR_OK;
+}
+
+linalg_krylov_err_t linalg_krylov_deinitialize(linalg_krylov_t* krylov)
+{
+    if (krylov == NULL) {
+        return LINALG_KRYLOV_ERR_NULL;
+    }
+
+    vector_delete(&krylov->history);
+    vector_delete(&krylov->basis);
+    vector_delete(&krylov->hessenberg);
+
+    for (size_t index = 0UL; index < LINALG_KRYLOV_WORK; ++index) {
+        vector_delete(&krylov->work[index]);
+    }
+
+    memset(krylov, 0, sizeof(*krylov));
+
+    return LINALG_KRYLOV_ERR_OK;
+}
+
+static void linalg_krylov_precondition(linalg_operator_t const* pc,
+                                       vector_t const* x,
+                                       vector_t* y)
+{
+    if (pc == NULL) {
+        memcpy(y->data, x->data, sizeof(vector_data_t) * x->size);
+    } else {
+        pc->apply(pc->user, x, y);
+    }
+}
+
+// Records the relative residual after iteration; true once converged.
+static bool linalg_krylov_record(linalg_krylov_t* krylov,
+                                 matrix_size_t iteration,
+                                 vector_data_t residual)
+{
+    krylov->iterations = iteration;
+    krylov->residual = residual;
+    krylov->history.data[iteration] = residual;
+
+    return residual <= krylov->tolerance;
+}
+
+// r = b - A x.
+static void linalg_krylov_residual(linalg_operator_t const* op,
+                                   vector_t const* rhs,
+                                   vector_t const* solution,
+                                   vector_t* residual)
+{
+    op->apply(op->user, solution, residual);
+
+    for (vector_size_t index = 0UL; index < rhs->size; ++index) {
+        residual->data[index] = rhs->data[index] - residual->data[index];
+    }
+}
+
+static linalg_krylov_err_t linalg_krylov_cg(linalg_krylov_t* krylov,
+                                            linalg_operator_t const* op,
+                                            linalg_operator_t const* pc,
+                                            vector_t const* rhs,
+                                            vector_t* solution,
+                                            vector_data_t rhs_norm)
+{
+    vector_size_t n = krylov->size;
+    vector_t* r = &krylov->work[0U];
+    vector_t* z = &krylov->work[1U];
+    vector_t* p = &krylov->work[2U];
+    vector_t* q = &krylov->work[3U];
+    vector_data_t* x = solution->data;
+
+    linalg_krylov_residual(op, rhs, solution, r);
+    if (linalg_krylov_record(krylov,
+                             0UL,
+                             linalg_krylov_norm(r->data, n) / rhs_norm)) {
+        return LINALG_KRYLOV_ERR_OK;
+    }
+
+    linalg_krylov_precondition(pc, r, z);
+    memcpy(p->data, z->data, sizeof(vector_data_t) * n);
+    vector_data_t rz = linalg_krylov_dot(r->data, z->data, n);
+
+    for (matrix_size_t iteration = 1UL; iteration <= krylov->max_iterations;
+         ++iteration) {
+        op->apply(op->user, p, q);
+
+        vector_data_t pq = linalg_krylov_dot(p->data, q->data, n);
+        if (!(pq > 0.0F)) {
+            return LINALG_KRYLOV_ERR_BREAKDOWN;
+        }
+
+        vector_data_t alpha = rz / pq;
+        linalg_krylov_axpy(alpha, p->data, x, n);
+        linalg_krylov_axpy(-alpha, q->data, r->data, n);
+
+        if (linalg_krylov_record(krylov,
+                                 iteration,
+                                 linalg_krylov_norm(r->data, n) / rhs_norm)) {
+            return LINALG_KRYLOV_ERR_OK;
+        }
+
+        linalg_krylov_precondition(pc, r, z);
+
+        vector_data_t rz_next = linalg_krylov_dot(r->data, z->data, n);
+        vector_data_t beta = rz_next / rz;
+        rz = rz_next;
+
+        for (vector_size_t index = 0UL; index < n; ++index) {
+            p->data[index] = z->data[index] + beta * p->data[index];
+        }
+    }
+
+    return LINALG_KRYLOV_ERR_NOT_CONVERGED;
+}
+
+static linalg_krylov_err_t linalg_krylov_bicgstab(
+    linalg_krylov_t* krylov,
+    linalg_operator_t const* op,
+    linalg_operator_t const* pc,
+    vector_t const* rhs,
+    vector_t* solution,
+    vector_data_t rhs_norm)
+{
+    vector_size_t n = krylov->size;
+    vector_t* r = &krylov->work[0U];
+    vector_t* shadow = &krylov->work[1U];
+    vector_t* p = &krylov->work[2U];
+    vector_t* v = &krylov->work[3U];
+    vector_t* s = &krylov->work[4U];
+    vector_t* t = &krylov->work[5U];
+    vector_t* p_hat = &krylov->work[6U];
+    vector_t* s_hat = &krylov->work[7U];
+    vector_data_t* x = solution->data;
+
+    linalg_krylov_residual(op, rhs, solution, r);
+    if (linalg_krylov_record(krylov,
+                             0UL,
+                             linalg_krylov_norm(r->data, n) / rhs_norm)) {
+        return LINALG_KRYLOV_ERR_OK;
+    }
+
+    memcpy(shadow->data, r->data, sizeof(vector_data_t) * n);
+    memset(p->data, 0, sizeof(vector_data_t) * n);
+    memset(v->data, 0, sizeof(vector_data_t) * n);
+
+    vector_data_t rho = 1.0F;
+    vector_data_t alpha = 1.0F;
+    vector_data_t omega = 1.0F;
+
+    for (matrix_size_t iteration = 1UL; iteration <= krylov->max_iterations;
+         ++iteration) {
+        vector_data_t rho_next = linalg_krylov_dot(shadow->data, r->data, n);
+        if (rho_next == 0.0F) {
+            return LINALG_KRYLOV_ERR_BREAKDOWN;
+        }
+
+        vector_data_t beta = (rho_next / rho) * (alpha / omega);
+        rho = rho_next;
+
+        for (vector_size_t index = 0UL; index < n; ++index) {
+            p->data[index] =
+                r->data[index] +
+                beta * (p->data[index] - omega * v->data[index]);
+        }
+
+        linalg_krylov_precondition(pc, p, p_hat);
+        op->apply(op->user, p_hat, v);
+
+        vector_data_t shadow_v = linalg_krylov_dot(shadow->data, v->data, n);
+        if (shadow_v == 0.0F) {
+            return LINALG_KRYLOV_ERR_BREAKDOWN;
+        }
+
+        alpha = rho / shadow_v;
+
+        for (vector_size_t index = 0UL; index < n; ++index) {
+            s->data[index] = r->data[index] - alpha * v->data[index];
+        }
+
+        vector_data_t s_norm = linalg_krylov_norm(s->data, n) / rhs_norm;
+        if (s_norm <= krylov->tolerance) {
+            linalg_krylov_axpy(alpha, p_hat->data, x, n);
+            linalg_krylov_record(krylov, iteration, s_norm);
+            return LINALG_KRYLOV_ERR_OK;
+        }
+
+        linalg_krylov_precondition(pc, s, s_hat);
+        op->apply(op->user, s_hat, t);
+
+        vector_data_t tt = linalg_krylov_dot(t->data, t->data, n);
+        if (tt == 0.0F) {
+            return LINALG_KRYLOV_ERR_BREAKDOWN;
+        }
+
+        omega = linalg_krylov_dot(t->data, s->data, n) / tt;
+
+        for (vector_size_t index = 0UL; index < n; ++index) {
+            x[index] += alpha * p_hat->data[index] + omega * s_hat->data[index];
+            r->data[index] = s->data[index] - omega * t->data[index];
+        }
+
+        if (linalg_krylov_record(krylov,
+                                 iteration,
+                                 linalg_krylov_norm(r->data, n) / rhs_norm)) {
+            return LINALG_KRYLOV_ERR_OK;
+        }
+
+        if (omega == 0.0F) {
+            return LINALG_KRYLOV_ERR_BREAKDOWN;
+        }
+    }
+
+    return LINALG_KRYLOV_ERR_NOT_CONVERGED;
+}
+
+// Right-preconditioned GMRES(m) with modified Gram-Schmidt. The least
+// squares problem is kept triangular by Givens rotations, so the residual
+// norm of every iteration is read off the rotated right-hand side g.
+static linalg_krylov_err_t linalg_krylov_gmres(linalg_krylov_t* krylov,
+                                               linalg_operator_t const* op,
+                                               linalg_operator_t const* pc,
+                                               vector_t const* rhs,
+                                               vector_t* solution,
+                                               vector_data_t rhs_norm)
+{
+    vector_size_t n = krylov->size;
+    matrix_size_t m = krylov->restart;
+    matrix_size_t stride = m + 1UL;
+    vector_t* w = &krylov->work[0U];
+    vector_t* z = &krylov->work[1U];
+    vector_data_t* basis = krylov->basis.data;
+    vector_data_t* h = krylov->hessenberg.data;
+    vector_data_t* cosines = h + m * stride;
+    vector_data_t* sines = cosines + m;
+    vector_data_t* g = sines + m;
+    vector_data_t* x = solution->data;
+
+    vector_t first = linalg_krylov_view(basis, n);
+    linalg_krylov_residual(op, rhs, solution, &first);
+
+    vector_data_t beta = linalg_krylov_norm(basis, n);
+    if (linalg_krylov_record(krylov, 0UL, beta / rhs_norm)) {
+        return LINALG_KRYLOV_ERR_OK;
+    }
+
+    matrix_size_t iteration = 0UL;
+
+    while (iteration < krylov->max_iterations) {
+        for (vector_size_t index = 0UL; index < n; ++index) {
+            basis[index] /= beta;
+        }
+
+        memset(g, 0, sizeof(vector_data_t) * stride);
+        g[0U] = beta;
+
+        matrix_size_t k = 0UL;
+        bool converged = false;
+
+        while (k < m && iteration < krylov->max_iterations && !converged) {
+            vector_t column = linalg_krylov_view(&basis[k * n], n);
+            vector_data_t* hk = &h[k * stride];
+
+            linalg_krylov_precondition(pc, &column, z);
+            op->apply(op->user, z, w);
+
+            for (matrix_size_t i = 0UL; i <= k; ++i) {
+                hk[i] = linalg_krylov_dot(w->data, &basis[i * n], n);
+                linalg_krylov_axpy(-hk[i], &basis[i * n], w->data, n);
+            }
+
+            vector_data_t w_norm = linalg_krylov_norm(w->data, n);
+            hk[k + 1UL] = w_norm;
+
+            if (w_norm > 0.0F) {
+                vector_data_t* next = &basis[(k + 1UL) * n];
+
+                for (vector_size_t index = 0UL; index < n; ++index) {
+                    next[index] = w->data[index] / w_norm;
+                }
+            }
+
+            for (matrix_size_t i = 0UL; i < k; ++i) {
+                vector_data_t top = hk[i];
+                hk[i] = cosines[i] * top + sines[i] * hk[i + 1UL];
+                hk[i + 1UL] = cosines[i] * hk[i + 1UL] - sines[i] * top;
+            }
+
+            vector_data_t length = hypotf(hk[k], hk[k + 1UL]);
+            if (length == 0.0F) {
+                return LINALG_KRYLOV_ERR_BREAKDOWN;
+            }
+
+            cosines[k] = hk[k] / length;
+            sines[k] = hk[k + 1UL] / length;
+            hk[k] = length;
+            hk[k + 1UL] = 0.0F;
+            g[k + 1UL] = -sines[k] * g[k];
+            g[k] *= cosines[k];
+
+            ++k;
+            ++iteration;
+
+            // A zero w_norm means the Krylov space is invariant and already
+            // holds the solution.
+            converged = linalg_krylov_record(krylov,
+                                             iteration,
+                                             fabsf(g[k]) / rhs_norm) ||
+                        w_norm == 0.0F;
+        }
+
+        // Back substitution leaves y in g, then x += M^-1 V y.
+        for (matrix_size_t i = k; i-- > 0UL;) {
+            vector_data_t sum = g[i];
+
+            for (matrix_size_t j = i + 1UL; j < k; ++j) {
+                sum -= h[j * stride + i] * g[j];
+            }
+
+            g[i] = sum / h[i * stride + i];
+        }
+
+        memset(w->data, 0, sizeof(vector_data_t) * n);
+
+        for (matrix_size_t i = 0UL; i < k; ++i) {
+            linalg_krylov_axpy(g[i], &basis[i * n], w->data, n);
+        }
+
+        linalg_krylov_precondition(pc, w, z);
+        linalg_krylov_axpy(1.0F, z->data, x, n);
+
+        if (krylov->residual <= krylov->tolerance) {
+            return LINALG_KRYLOV_ERR_OK;
+        }
+
+        linalg_krylov_residual(op, rhs, solution, &first);
+        beta = linalg_krylov_norm(basis, n);
+
+        if (beta / rhs_norm <= krylov->tolerance) {
+            krylov->residual = beta / rhs_norm;
+            krylov->history.data[iteration] = krylov->residual;
+            return LINALG_KRYLOV_ERR_OK;
+        }
+    }
+
+    return LINALG_KRYLOV_ERR_NOT_CONVERGED;
+}
+
+linalg_krylov_err_t linalg_krylov_solve(linalg_krylov_t* krylov,
+                                        linalg_operator_t const* op,
+                                        linalg_operator_t const* preconditioner,
+                                        vector_t const* rhs,
+                                        vector_t* solution)
+{
+    if (krylov == NULL || op == NULL || rhs == NULL || solution == NULL) {
+        return LINALG_KRYLOV_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(linalg_krylov_solve, 0, 0);
+
+    vector_size_t n = krylov->size;
+
+    if (op->size != n || rhs->size != n || solution->size != n ||
+        (preconditioner != NULL && preconditioner->size != n) ||
+        krylov->history.size < krylov->max_iterations + 1UL) {
+        return LINALG_KRYLOV_ERR_DIMENSION;
+    }
+
+    krylov->iterations = 0UL;
+
+    vector_data_t rhs_norm = linalg_krylov_norm(rhs->data, n);
+    if (rhs_norm == 0.0F) {
+        memset(solution->data, 0, sizeof(vector_data_t) * n);
+        linalg_krylov_record(krylov, 0UL, 0.0F);
+        return LINALG_KRYLOV_ERR_OK;
+    }
+
+    switch (krylov->method) {
+    case LINALG_KRYLOV_CG:
+        return linalg_krylov_cg(
+            krylov, op, preconditioner, rhs, solution, rhs_norm);
+    case LINALG_KRYLOV_BICGSTAB:
+        return linalg_krylov_bicgstab(
+            krylov, op, preconditioner, rhs, solution, rhs_norm);
+    case LINALG_KRYLOV_GMRES:
+        return linalg_krylov_gmres(
+            krylov, op, preconditioner, rhs, solution, rhs_norm);
+    default:
+        return LINALG_KRYLOV_ERR_FAIL;
+    }
+}
@@ -0,0 +1,140 @@
+#ifndef LINALG_LINALG_KRYLOV_H
+#define LINALG_LINALG_KRYLOV_H
+
+#include "matrix.h"
+#include "matrix_sparse.h"
+#include "vector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    LINALG_KRYLOV_ERR_OK = 0,
+    LINALG_KRYLOV_ERR_FAIL,
+    LINALG_KRYLOV_ERR_NULL,
+    LINALG_KRYLOV_ERR_ALLOC,
+    LINALG_KRYLOV_ERR_DIMENSION,
+    LINALG_KRYLOV_ERR_SINGULAR,
+    LINALG_KRYLOV_ERR_BREAKDOWN,
+    LINALG_KRYLOV_ERR_NOT_CONVERGED,
+} linalg_krylov_err_t;
+
+// A square linear map y = A x given only by its action, so a solver never
+// needs A itself. apply writes all size elements of y, which is never x.
+typedef struct {
+    void* user;
+    void (*apply)(void* user, vector_t const* x, vector_t* y);
+    vector_size_t size;
+} linalg_operator_t;
+
+// Operators over a square dense or sparse matrix, which is only read and
+// must outlive the operator.
+linalg_krylov_err_t linalg_operator_from_matrix(linalg_operator_t* op,
+                                                matrix_t const* matrix);
+
+linalg_krylov_err_t linalg_operator_from_csr(linalg_operator_t* op,
+                                             matrix_csr_t const* csr);
+
+typedef enum {
+    // M = diag(A).
+    LINALG_PRECONDITIONER_JACOBI = 0,
+    // M = L U restricted to the sparsity pattern of A.
+    LINALG_PRECONDITIONER_ILU0,
+    // M = L L^T restricted to the pattern of the lower triangle of a
+    // symmetric positive definite A.
+    LINALG_PRECONDITIONER_IC0,
+} linalg_preconditioner_kind_t;
+
+// Preconditioner built once from a sparse matrix, applied as
+// z = M^-1 r through linalg_preconditioner_operator. Dense systems can be
+// converted with matrix_csr_from_matrix. ILU(0) and IC(0) need the diagonal
+// stored in every row.
+typedef struct {
+    linalg_preconditioner_kind_t kind;
+    matrix_csr_t factor;
+    matrix_t inverse_diagonal;
+} linalg_preconditioner_t;
+
+// Returns LINALG_KRYLOV_ERR_SINGULAR on a zero pivot or, for IC(0), a
+// non-positive one.
+linalg_krylov_err_t linalg_preconditioner_initialize(
+    linalg_preconditioner_t* preconditioner,
+    linalg_preconditioner_kind_t kind,
+    matrix_csr_t const* csr,
+    matrix_allocator_t const* allocator);
+
+linalg_krylov_err_t linalg_preconditioner_deinitialize(
+    linalg_preconditioner_t* preconditioner);
+
+// preconditioner must outlive op.
+linalg_krylov_err_t linalg_preconditioner_operator(
+    linalg_preconditioner_t const* preconditioner,
+    linalg_operator_t* op);
+
+typedef enum {
+    // Conjugate gradient, for symmetric positive definite A and M.
+    LINALG_KRYLOV_CG = 0,
+    // Stabilized biconjugate gradient, right preconditioned.
+    LINALG_KRYLOV_BICGSTAB,
+    // GMRES restarted every restart iterations, right preconditioned.
+    LINALG_KRYLOV_GMRES,
+} linalg_krylov_method_t;
+
+#define LINALG_KRYLOV_WORK 8U
+
+// Iterative solver for A x = b. Every work vector, including the GMRES basis
+// and Hessenberg matrix, is allocated at initialization, so solves never
+// allocate.
+//
+// tolerance is the relative residual ||b - A x|| / ||b|| to reach and starts
+// at 1E-5 and may be written directly between solves. max_iterations may
+// likewise be lowered, but not raised above the value given at
+// initialization, which sizes history; solves then fail with
+// LINALG_KRYLOV_ERR_DIMENSION.
+// After a solve, iterations holds the iterations performed, residual the
+// last relative residual and history[0 .. iterations] the relative residual
+// before the first and after every iteration. Recurrence-based methods
+// track an updated rather than recomputed residual.
+typedef struct {
+    linalg_krylov_method_t method;
+    vector_size_t size;
+    matrix_size_t restart;
+    matrix_size_t max_iterations;
+    matrix_data_t tolerance;
+    matrix_size_t iterations;
+    matrix_data_t residual;
+    vector_t history;
+    vector_t work[LINALG_KRYLOV_WORK];
+    vector_t basis;
+    vector_t hessenberg;
+} linalg_krylov_t;
+
+// restart is only used by GMRES and must then be nonzero.
+linalg_krylov_err_t linalg_krylov_initialize(
+    linalg_krylov_t* krylov,
+    linalg_krylov_method_t method,
+    vector_size_t size,
+    matrix_size_t max_iterations,
+    matrix_size_t restart,
+    vector_allocator_t const* allocator);
+
+linalg_krylov_err_t linalg_krylov_deinitialize(linalg_krylov_t* krylov);
+
+// Solves op x = rhs starting from the guess in solution, which receives the
+// result. preconditioner applies M^-1 and may be NULL. Returns
+// LINALG_KRYLOV_ERR_NOT_CONVERGED if tolerance is not reached within
+// max_iterations and LINALG_KRYLOV_ERR_BREAKDOWN if the method cannot
+// continue, such as CG on an indefinite system; solution then holds the
+// last iterate.
+linalg_krylov_err_t linalg_krylov_solve(linalg_krylov_t* krylov,
+                                        linalg_operator_t const* op,
+                                        linalg_operator_t const* preconditioner,
+                                        vector_t const* rhs,
+                                        vector_t* solution);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_LINALG_KRYLOV_H
@@ -0,0 +1,437 @@
+#include "linalg_pool.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LINALG_POOL_POSIX
+#include <pthread.h>
+#endif
+
+#define LINALG_POOL_THREAD_SLOTS 4U
+
+// Prepended to every block; next is only meaningful while the block is free.
+typedef union {
+    struct {
+        size_t size_class;
+        void* next;
+    } info;
+    max_align_t align;
+} linalg_pool_header_t;
+
+struct linalg_pool_cache {
+    linalg_pool_header_t* blocks[LINALG_POOL_CLASSES];
+    size_t counts[LINALG_POOL_CLASSES];
+    bool owned;
+    linalg_pool_cache_t* next;
+};
+
+typedef struct {
+    uint64_t pool_id;
+    linalg_pool_cache_t* cache;
+} linalg_pool_slot_t;
+
+static _Atomic uint64_t linalg_pool_next_id = 1ULL;
+
+// Every initialized pool, so a thread evicting a cache from its slots can
+// tell whether the cache's pool, and with it the cache, still exists.
+static atomic_flag linalg_pool_registry_lock = ATOMIC_FLAG_INIT;
+static linalg_pool_t* linalg_pool_registry = NULL;
+
+static _Thread_local linalg_pool_slot_t
+    linalg_pool_slots[LINALG_POOL_THREAD_SLOTS];
+static _Thread_local size_t linalg_pool_next_slot = 0UL;
+
+static size_t linalg_pool_class(size_t size)
+{
+    size_t size_class = 0UL;
+    size_t class_size = LINALG_POOL_MIN_SIZE;
+    while (class_size < size && size_class < LINALG_POOL_CLASSES) {
+        class_size <<= 1U;
+        ++size_class;
+    }
+
+    return size_class;
+}
+
+static void linalg_pool_spin_lock(atomic_flag* lock)
+{
+    while (atomic_flag_test_and_set_explicit(lock, memory_order_acquire)) {
+    }
+}
+
+static void linalg_pool_spin_unlock(atomic_flag* lock)
+{
+    atomic_flag_clear_explicit(lock, memory_order_release);
+}
+
+static void linalg_pool_lock(linalg_pool_t* pool)
+{
+    linalg_pool_spin_lock(&pool->lock);
+}
+
+static void linalg_pool_unlock(linalg_pool_t* pool)
+{
+    linalg_pool_spin_unlock(&pool->lock);
+}
+
+static void linalg_pool_free_list(linalg_pool_header_t* block)
+{
+    while (block != NULL) {
+        linalg_pool_header_t* next = block->info.next;
+        free(block);
+        block = next;
+    }
+}
+
+// Hands the cache in an evicted slot back to its pool: its blocks go to the
+// shared lists and the cache waits, unowned, for the next thread that needs
+// one. A cache whose pool has been deinitialized was freed with the pool
+// and is left alone. Called with the registry locked.
+static void linalg_pool_release(linalg_pool_slot_t const* slot)
+{
+    linalg_pool_t* pool = linalg_pool_registry;
+    while (pool != NULL && pool->id != slot->pool_id) {
+        pool = pool->next;
+    }
+
+    if (pool == NULL) {
+        return;
+    }
+
+    linalg_pool_cache_t* cache = slot->cache;
+
+    linalg_pool_lock(pool);
+    for (size_t size_class = 0UL; size_class < LINALG_POOL_CLASSES;
+         ++size_class) {
+        while (cache->blocks[size_class] != NULL) {
+            linalg_pool_header_t* block = cache->blocks[size_class];
+            cache->blocks[size_class] = block->info.next;
+            block->info.next = pool->free_lists[size_class];
+            pool->free_lists[size_class] = block;
+        }
+        cache->counts[size_class] = 0UL;
+    }
+    cache->owned = false;
+    linalg_pool_unlock(pool);
+}
+
+#ifdef LINALG_POOL_POSIX
+
+static pthread_once_t linalg_pool_exit_once = PTHREAD_ONCE_INIT;
+static pthread_key_t linalg_pool_exit_key;
+static bool linalg_pool_exit_ready = false;
+
+// Releases an exiting thread's caches so that other threads can take them
+// over instead of the pool growing a new cache per short-lived thread.
+static void linalg_pool_thread_exit(void* slots)
+{
+    linalg_pool_slot_t* slot = slots;
+
+    linalg_pool_spin_lock(&linalg_pool_registry_lock);
+    for (size_t index = 0UL; index < LINALG_POOL_THREAD_SLOTS; ++index) {
+        if (slot[index].cache != NULL) {
+            linalg_pool_release(&slot[index]);
+            memset(&slot[index], 0, sizeof(slot[index]));
+        }
+    }
+    linalg_pool_spin_unlock(&linalg_pool_registry_lock);
+}
+
+static void linalg_pool_exit_create(void)
+{
+    linalg_pool_exit_ready = pthread_key_create(&linalg_pool_exit_key,
+                                                linalg_pool_thread_exit) == 0;
+}
+
+static void linalg_pool_watch_exit(void)
+{
+    if (pthread_once(&linalg_pool_exit_once, linalg_pool_exit_create) == 0 &&
+        linalg_pool_exit_ready &&
+        pthread_getspecific(linalg_pool_exit_key) == NULL) {
+        pthread_setspecific(linalg_pool_exit_key, linalg_pool_slots);
+    }
+}
+
+#endif // LINALG_POOL_POSIX
+
+// Finds this thread's cache for pool. A thread serves at most
+// LINALG_POOL_THREAD_SLOTS pools from cache; on a miss the oldest slot is
+// released and the thread takes over an unowned cache of pool, so a pool
+// never holds more caches than threads using it at once.
+static linalg_pool_cache_t* linalg_pool_cache(linalg_pool_t* pool)
+{
+    for (size_t slot = 0UL; slot < LINALG_POOL_THREAD_SLOTS; ++slot) {
+        if (linalg_pool_slots[slot].cache != NULL &&
+            linalg_pool_slots[slot].pool_id == pool->id) {
+            return linalg_pool_slots[slot].cache;
+        }
+    }
+
+    linalg_pool_slot_t* slot = &linalg_pool_slots[linalg_pool_next_slot];
+    linalg_pool_next_slot =
+        (linalg_pool_next_slot + 1UL) % LINALG_POOL_THREAD_SLOTS;
+
+    linalg_pool_spin_lock(&linalg_pool_registry_lock);
+
+    if (slot->cache != NULL) {
+        linalg_pool_release(slot);
+        memset(slot, 0, sizeof(*slot));
+    }
+
+    linalg_pool_lock(pool);
+    linalg_pool_cache_t* cache = pool->caches;
+    while (cache != NULL && cache->owned) {
+        cache = cache->next;
+    }
+
+    if (cache == NULL) {
+        cache = calloc(1UL, sizeof(*cache));
+        if (cache != NULL) {
+            cache->next = pool->caches;
+            pool->caches = cache;
+        }
+    }
+
+    if (cache != NULL) {
+        cache->owned = true;
+        slot->pool_id = pool->id;
+        slot->cache = cache;
+    }
+    linalg_pool_unlock(pool);
+
+    linalg_pool_spin_unlock(&linalg_pool_registry_lock);
+
+#ifdef LINALG_POOL_POSIX
+    if (cache != NULL) {
+        linalg_pool_watch_exit();
+    }
+#endif
+
+    return cache;
+}
+
+static void linalg_pool_refill(linalg_pool_t* pool,
+                               linalg_pool_cache_t* cache,
+                               size_t size_class)
+{
+    linalg_pool_lock(pool);
+    while (pool->free_lists[size_class] != NULL &&
+           cache->counts[size_class] < LINALG_POOL_CACHE_BLOCKS / 2U) {
+        linalg_pool_header_t* block = pool->free_lists[size_class];
+        pool->free_lists[size_class] = block->info.next;
+        block->info.next = cache->blocks[size_class];
+        cache->blocks[size_class] = block;
+        ++cache->counts[size_class];
+    }
+    linalg_pool_unlock(pool);
+}
+
+static void linalg_pool_spill(linalg_pool_t* pool,
+                              linalg_pool_cache_t* cache,
+                              size_t size_class)
+{
+    linalg_pool_lock(pool);
+    while (cache->counts[size_class] > LINALG_POOL_CACHE_BLOCKS / 2U) {
+        linalg_pool_header_t* block = cache->blocks[size_class];
+        cache->blocks[size_class] = block->info.next;
+        --cache->counts[size_class];
+        block->info.next = pool->free_lists[size_class];
+        pool->free_lists[size_class] = block;
+    }
+    linalg_pool_unlock(pool);
+}
+
+static void* linalg_pool_allocate(linalg_pool_t* pool, size_t size)
+{
+    size_t size_class = linalg_pool_class(size);
+    linalg_pool_header_t* block = NULL;
+
+    if (size_class < LINALG_POOL_CLASSES) {
+        linalg_pool_cache_t* cache = linalg_pool_cache(pool);
+        if (cache != NULL) {
+            if (cache->counts[size_class] == 0UL) {
+                linalg_pool_refill(pool, cache, size_class);
+            }
+            if (cache->counts[size_class] != 0UL) {
+                block = cache->blocks[size_class];
+                cache->blocks[size_class] = block->info.next;
+                --cache->counts[size_class];
+            }
+        }
+    }
+
+    if (block != NULL) {
+        atomic_fetch_add_explicit(&pool->hits, 1ULL, memory_order_relaxed);
+    } else {
+        size_t block_size = size_class < LINALG_POOL_CLASSES
+                                ? LINALG_POOL_MIN_SIZE << size_class
+                                : size;
+        block = malloc(sizeof(*block) + block_size);
+        if (block == NULL) {
+            return NULL;
+        }
+        block->info.size_class = size_class;
+        atomic_fetch_add_explicit(&pool->misses, 1ULL, memory_order_relaxed);
+    }
+
+    block->info.next = NULL;
+    atomic_fetch_add_explicit(&pool->live, 1ULL, memory_order_relaxed);
+
+    return block + 1;
+}
+
+static void linalg_pool_deallocate(linalg_pool_t* pool, void* data)
+{
+    if (data == NULL) {
+        return;
+    }
+
+    linalg_pool_header_t* block = (linalg_pool_header_t*)data - 1;
+    size_t size_class = block->info.size_class;
+
+    atomic_fetch_sub_explicit(&pool->live, 1ULL, memory_order_relaxed);
+
+    if (size_class >= LINALG_POOL_CLASSES) {
+        free(block);
+        return;
+    }
+
+    linalg_pool_cache_t* cache = linalg_pool_cache(pool);
+    if (cache == NULL) {
+        linalg_pool_lock(pool);
+        block->info.next = pool->free_lists[size_class];
+        pool->free_lists[size_class] = block;
+        linalg_pool_unlock(pool);
+        return;
+    }
+
+    block->info.next = cache->blocks[size_class];
+    cache->blocks[size_class] = block;
+    if (++cache->counts[size_class] >= LINALG_POOL_CACHE_BLOCKS) {
+        linalg_pool_spill(pool, cache, size_class);
+    }
+}
+
+static matrix_data_t* linalg_pool_matrix_allocate(void* user,
+                                                  matrix_size_t size)
+{
+    return linalg_pool_allocate(user, size);
+}
+
+static void linalg_pool_matrix_deallocate(void* user, matrix_data_t* data)
+{
+    linalg_pool_deallocate(user, data);
+}
+
+static vector_data_t* linalg_pool_vector_allocate(void* user,
+                                                  vector_size_t size)
+{
+    return linalg_pool_allocate(user, size);
+}
+
+static void linalg_pool_vector_deallocate(void* user, vector_data_t* data)
+{
+    linalg_pool_deallocate(user, data);
+}
+
+linalg_pool_err_t linalg_pool_initialize(linalg_pool_t* pool)
+{
+    if (pool == NULL) {
+        return LINALG_POOL_ERR_NULL;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    atomic_flag_clear(&pool->lock);
+    pool->id = atomic_fetch_add_explicit(&linalg_pool_next_id,
+                                         1ULL,
+                                         memory_order_relaxed);
+
+    linalg_pool_spin_lock(&linalg_pool_registry_lock);
+    pool->next = linalg_pool_registry;
+    linalg_pool_registry = pool;
+    linalg_pool_spin_unlock(&linalg_pool_registry_lock);
+
+    return LINALG_POOL_ERR_OK;
+}
+
+linalg_pool_err_t linalg_pool_deinitialize(linalg_pool_t* pool)
+{
+    if (pool == NULL) {
+        return LINALG_POOL_ERR_NULL;
+    }
+
+    if (atomic_load_explicit(&pool->live, memory_order_relaxed) != 0ULL) {
+        return LINALG_POOL_ERR_BUSY;
+    }
+
+    // Holding the registry keeps threads from releasing caches into the
+    // pool while they are freed.
+    linalg_pool_spin_lock(&linalg_pool_registry_lock);
+
+    linalg_pool_t** link = &linalg_pool_registry;
+    while (*link != NULL && *link != pool) {
+        link = &(*link)->next;
+    }
+    if (*link != NULL) {
+        *link = pool->next;
+    }
+
+    for (size_t size_class = 0UL; size_class < LINALG_POOL_CLASSES;
+         ++size_class) {
+        linalg_pool_free_list(pool->free_lists[size_class]);
+    }
+
+    linalg_pool_cache_t* cache = pool->caches;
+    while (cache != NULL) {
+        linalg_pool_cache_t* next = cache->next;
+        for (size_t size_class = 0UL; size_class < LINALG_POOL_CLASSES;
+             ++size_class) {
+            linalg_pool_free_list(cache->blocks[size_class]);
+        }
+        free(cache);
+        cache = next;
+    }
+
+    for (size_t slot = 0UL; slot < LINALG_POOL_THREAD_SLOTS; ++slot) {
+        if (linalg_pool_slots[slot].pool_id == pool->id) {
+            memset(&linalg_pool_slots[slot],
+                   0,
+                   sizeof(linalg_pool_slots[slot]));
+        }
+    }
+
+    linalg_pool_spin_unlock(&linalg_pool_registry_lock);
+
+    memset(pool, 0, sizeof(*pool));
+
+    return LINALG_POOL_ERR_OK;
+}
+
+linalg_pool_err_t linalg_pool_matrix_allocator(linalg_pool_t* pool,
+                                               matrix_allocator_t* allocator)
+{
+    if (pool == NULL || allocator == NULL) {
+        return LINALG_POOL_ERR_NULL;
+    }
+
+    allocator->user = pool;
+    allocator->allocate = linalg_pool_matrix_allocate;
+    allocator->deallocate = linalg_pool_matrix_deallocate;
+
+    return LINALG_POOL_ERR_OK;
+}
+
+linalg_pool_err_t linalg_pool_vector_allocator(linalg_pool_t* pool,
+                                               vector_allocator_t* allocator)
+{
+    if (pool == NULL || allocator == NULL) {
+        return LINALG_POOL_ERR_NULL;
+    }
+
+    allocator->user = pool;
+    allocator->allocate = linalg_pool_vector_allocate;
+    allocator->deallocate = linalg_pool_vector_deallocate;
+
+    return LINALG_POOL_ERR_OK;
+}
@@ -0,0 +1,62 @@
+#ifndef LINALG_LINALG_POOL_H
+#define LINALG_LINALG_POOL_H
+
+#include "matrix.h"
+#include "vector.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Size classes are powers of two from LINALG_POOL_MIN_SIZE bytes; larger
+// requests bypass the pool and go straight to malloc.
+#define LINALG_POOL_MIN_SIZE 64UL
+#define LINALG_POOL_CLASSES 15U
+#define LINALG_POOL_MAX_SIZE \
+    (LINALG_POOL_MIN_SIZE << (LINALG_POOL_CLASSES - 1U))
+
+// Blocks a thread keeps per class before spilling half to the shared lists.
+// On POSIX systems a thread's caches are handed back when it exits.
+#define LINALG_POOL_CACHE_BLOCKS 16U
+
+typedef enum {
+    LINALG_POOL_ERR_OK = 0,
+    LINALG_POOL_ERR_FAIL,
+    LINALG_POOL_ERR_NULL,
+    LINALG_POOL_ERR_BUSY,
+} linalg_pool_err_t;
+
+typedef struct linalg_pool_cache linalg_pool_cache_t;
+
+typedef struct linalg_pool {
+    uint64_t id;
+    atomic_flag lock;
+    void* free_lists[LINALG_POOL_CLASSES];
+    linalg_pool_cache_t* caches;
+    struct linalg_pool* next;
+    _Atomic uint64_t live;
+    _Atomic uint64_t hits;
+    _Atomic uint64_t misses;
+} linalg_pool_t;
+
+linalg_pool_err_t linalg_pool_initialize(linalg_pool_t* pool);
+
+// Returns every cached block to malloc, including those held in other
+// threads' caches, so no thread may use the pool concurrently. Fails with
+// LINALG_POOL_ERR_BUSY while blocks are still handed out.
+linalg_pool_err_t linalg_pool_deinitialize(linalg_pool_t* pool);
+
+linalg_pool_err_t linalg_pool_matrix_allocator(linalg_pool_t* pool,
+                                               matrix_allocator_t* allocator);
+
+linalg_pool_err_t linalg_pool_vector_allocator(linalg_pool_t* pool,
+                                               vector_allocator_t* allocator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_LINALG_POOL_H
@@ -0,0 +1,101 @@
+#include "linalg_profile.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define LINALG_PROFILE_NAME(NAME) #NAME,
+
+static char const* const linalg_profile_names[LINALG_PROFILE_ID_NUM] = {
+    LINALG_PROFILE_FUNCTIONS(LINALG_PROFILE_NAME)};
+
+#undef LINALG_PROFILE_NAME
+
+#ifdef LINALG_PROFILE
+
+_Thread_local linalg_profile_table_t* linalg_profile_table = NULL;
+
+static _Atomic(linalg_profile_table_t*) linalg_profile_tables = NULL;
+
+linalg_profile_table_t* linalg_profile_table_create(void)
+{
+    linalg_profile_table_t* table = calloc(1UL, sizeof(*table));
+    if (table == NULL) {
+        return NULL;
+    }
+
+    table->next =
+        atomic_load_explicit(&linalg_profile_tables, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&linalg_profile_tables,
+                                                  &table->next,
+                                                  table,
+                                                  memory_order_release,
+                                                  memory_order_relaxed)) {
+    }
+
+    linalg_profile_table = table;
+
+    return table;
+}
+
+#endif // LINALG_PROFILE
+
+linalg_profile_err_t linalg_profile_snapshot(
+    linalg_profile_snapshot_t* snapshot)
+{
+    if (snapshot == NULL) {
+        return LINALG_PROFILE_ERR_NULL;
+    }
+
+    memset(snapshot, 0, sizeof(*snapshot));
+
+    for (size_t id = 0UL; id < LINALG_PROFILE_ID_NUM; ++id) {
+        snapshot->entries[id].name = linalg_profile_names[id];
+    }
+
+#ifdef LINALG_PROFILE
+    for (linalg_profile_table_t* table =
+             atomic_load_explicit(&linalg_profile_tables, memory_order_acquire);
+         table != NULL;
+         table = table->next) {
+        for (size_t id = 0UL; id < LINALG_PROFILE_ID_NUM; ++id) {
+            linalg_profile_counter_t* counter = &table->counters[id];
+            linalg_profile_entry_t* entry = &snapshot->entries[id];
+
+            entry->calls +=
+                atomic_load_explicit(&counter->calls, memory_order_relaxed);
+            entry->cycles +=
+                atomic_load_explicit(&counter->cycles, memory_order_relaxed);
+            entry->flops +=
+                atomic_load_explicit(&counter->flops, memory_order_relaxed);
+            entry->bytes +=
+                atomic_load_explicit(&counter->bytes, memory_order_relaxed);
+        }
+    }
+
+    return LINALG_PROFILE_ERR_OK;
+#else
+    return LINALG_PROFILE_ERR_DISABLED;
+#endif
+}
+
+linalg_profile_err_t linalg_profile_reset(void)
+{
+#ifdef LINALG_PROFILE
+    for (linalg_profile_table_t* table =
+             atomic_load_explicit(&linalg_profile_tables, memory_order_acquire);
+         table != NULL;
+         table = table->next) {
+        for (size_t id = 0UL; id < LINALG_PROFILE_ID_NUM; ++id) {
+            linalg_profile_counter_t* counter = &table->counters[id];
+
+            atomic_store_explicit(&counter->calls, 0ULL, memory_order_relaxed);
+            atomic_store_explicit(&counter->cycles, 0ULL, memory_order_relaxed);
+            atomic_store_explicit(&counter->flops, 0ULL, memory_order_relaxed);
+            atomic_store_explicit(&counter->bytes, 0ULL, memory_order_relaxed);
+        }
+    }
+
+    return LINALG_PROFILE_ERR_OK;
+#else
+    return LINALG_PROFILE_ERR_DISABLED;
+#endif
+}
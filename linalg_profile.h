@@ -0,0 +1,361 @@
+#ifndef LINALG_LINALG_PROFILE_H
+#define LINALG_LINALG_PROFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Functions stamped out by linalg_fixed_impl.h for matrixN and vectorN.
+#define LINALG_PROFILE_FIXED_FUNCTIONS(X, N) \
+    X(vector##N##_fill_with_zeros) \
+    X(vector##N##_fill_with_array) \
+    X(vector##N##_sum) \
+    X(vector##N##_difference) \
+    X(vector##N##_scale) \
+    X(vector##N##_dot) \
+    X(vector##N##_print) \
+    X(matrix##N##_fill_with_zeros) \
+    X(matrix##N##_fill_with_identity) \
+    X(matrix##N##_fill_with_array) \
+    X(matrix##N##_transpose) \
+    X(matrix##N##_det) \
+    X(matrix##N##_inverse) \
+    X(matrix##N##_sum) \
+    X(matrix##N##_difference) \
+    X(matrix##N##_scale) \
+    X(matrix##N##_product) \
+    X(matrix##N##_trace) \
+    X(matrix##N##_vector_product) \
+    X(matrix##N##_solve) \
+    X(matrix##N##_print)
+
+#define LINALG_PROFILE_FUNCTIONS(X) \
+    X(matrix_initialize) \
+    X(matrix_deinitialize) \
+    X(matrix_create) \
+    X(matrix_create_with_zeros) \
+    X(matrix_create_with_array) \
+    X(matrix_delete) \
+    X(matrix_resize) \
+    X(matrix_resize_with_zeros) \
+    X(matrix_resize_with_array) \
+    X(matrix_fill_with_zeros) \
+    X(matrix_fill_with_array) \
+    X(matrix_copy) \
+    X(matrix_move) \
+    X(matrix_minor) \
+    X(matrix_complement) \
+    X(matrix_adjoint) \
+    X(matrix_transpose) \
+    X(matrix_transpose_in_place) \
+    X(matrix_det) \
+    X(matrix_inverse) \
+    X(matrix_upper_triangular) \
+    X(matrix_lower_triangular) \
+    X(matrix_row_echelon_form) \
+    X(matrix_sum) \
+    X(matrix_difference) \
+    X(matrix_scale) \
+    X(matrix_product) \
+    X(matrix_product_transposed) \
+    X(matrix_gram) \
+    X(matrix_division) \
+    X(matrix_power) \
+    X(matrix_trace) \
+    X(matrix_rank) \
+    X(matrix_eigvals) \
+    X(matrix_print) \
+    X(matrix_save) \
+    X(matrix_map) \
+    X(matrix_ooc_product) \
+    X(matrix_band_initialize) \
+    X(matrix_band_create) \
+    X(matrix_band_delete) \
+    X(matrix_band_from_matrix) \
+    X(matrix_band_to_matrix) \
+    X(matrix_band_product) \
+    X(matrix_band_lu) \
+    X(matrix_band_lu_solve) \
+    X(matrix_band_cholesky) \
+    X(matrix_band_cholesky_solve) \
+    X(matrix_tridiagonal_solve) \
+    X(matrix_tridiagonal_solve_batch) \
+    X(matrix_lu) \
+    X(matrix_lu_solve) \
+    X(matrix_lu_update) \
+    X(matrix_cholesky_solve) \
+    X(matrix_cholesky_update) \
+    X(matrix_cholesky_downdate) \
+    X(matrix_inverse_update) \
+    X(matrix_batch_initialize) \
+    X(matrix_batch_create) \
+    X(matrix_batch_delete) \
+    X(matrix_batch_resize) \
+    X(matrix_batch_set) \
+    X(matrix_batch_get) \
+    X(matrix_batch_product) \
+    X(matrix_batch_sum) \
+    X(matrix_batch_scale) \
+    X(matrix_sym_initialize) \
+    X(matrix_sym_create) \
+    X(matrix_sym_delete) \
+    X(matrix_sym_resize) \
+    X(matrix_sym_from_matrix) \
+    X(matrix_sym_to_matrix) \
+    X(matrix_sym_product) \
+    X(matrix_sym_rank_update) \
+    X(matrix_sym_cholesky) \
+    X(matrix_tri_initialize) \
+    X(matrix_tri_create) \
+    X(matrix_tri_delete) \
+    X(matrix_tri_resize) \
+    X(matrix_tri_from_matrix) \
+    X(matrix_tri_to_matrix) \
+    X(matrix_tri_solve) \
+    X(matrix_csr_initialize) \
+    X(matrix_csr_create) \
+    X(matrix_csr_delete) \
+    X(matrix_csr_from_matrix) \
+    X(matrix_csr_to_matrix) \
+    X(matrix_csr_vector_product) \
+    X(matrix_write_text) \
+    X(matrix_format_text) \
+    X(matrix_read_text) \
+    X(matrix_parse_text) \
+    X(vector_initialize) \
+    X(vector_deinitialize) \
+    X(vector_create) \
+    X(vector_create_with_zeros) \
+    X(vector_create_with_array) \
+    X(vector_delete) \
+    X(vector_resize) \
+    X(vector_resize_with_zeros) \
+    X(vector_resize_with_array) \
+    X(vector_fill_with_zeros) \
+    X(vector_fill_with_array) \
+    X(vector_copy) \
+    X(vector_move) \
+    X(vector_sum) \
+    X(vector_difference) \
+    X(vector_scale) \
+    X(vector_dot) \
+    X(vector_dot_reduced) \
+    X(vector_cross) \
+    X(vector_print) \
+    X(vector_write_text) \
+    X(vector_format_text) \
+    X(vector_read_text) \
+    X(vector_parse_text) \
+    X(matrix3_fill_with_zeros) \
+    X(matrix3_fill_with_array) \
+    X(matrix3_minor) \
+    X(matrix3_complement) \
+    X(matrix3_adjoint) \
+    X(matrix3_transpose) \
+    X(matrix3_det) \
+    X(matrix3_inverse) \
+    X(matrix3_inverse_batch) \
+    X(matrix3_upper_triangular) \
+    X(matrix3_lower_triangular) \
+    X(matrix3_row_echelon_form) \
+    X(matrix3_sum) \
+    X(matrix3_difference) \
+    X(matrix3_scale) \
+    X(matrix3_product) \
+    X(matrix3_division) \
+    X(matrix3_power) \
+    X(matrix3_trace) \
+    X(matrix3_rank) \
+    X(matrix3_eigvals) \
+    X(matrix3_vector_product) \
+    X(matrix3_print) \
+    X(vector3_fill_with_zeros) \
+    X(vector3_fill_with_array) \
+    X(vector3_sum) \
+    X(vector3_difference) \
+    X(vector3_scale) \
+    X(vector3_dot) \
+    X(vector3_cross) \
+    X(vector3_normalized) \
+    X(vector3_normalized_fast) \
+    X(vector3_normalized_fast_batch) \
+    X(vector3_magnitude) \
+    X(vector3_negated) \
+    X(vector3_print) \
+    X(quaternion3_fill_with_zeros) \
+    X(quaternion3_fill_with_elements) \
+    X(quaternion3_sum) \
+    X(quaternion3_difference) \
+    X(quaternion3_hamilton) \
+    X(quaternion3_scale) \
+    X(quaternion3_conjugate) \
+    X(quaternion3_inverse) \
+    X(quaternion3_normalized) \
+    X(quaternion3_normalized_fast) \
+    X(quaternion3_normalized_fast_batch) \
+    X(quaternion3_magnitude) \
+    X(quaternion3_dot) \
+    X(transform3_fill_with_arrays) \
+    X(transform3_fill_with_zeros) \
+    X(transform3_compose) \
+    X(transform3_inverse) \
+    X(transform3_rigid_inverse) \
+    X(transform3_rigid_inverse_batch) \
+    X(transform3_vector_transformation) \
+    X(transform3_print) \
+    X(transform3_packed_from_transform) \
+    X(transform3_packed_to_transform) \
+    X(transform3_packed_compose) \
+    X(transform3_packed_inverse) \
+    X(transform3_packed_rigid_inverse) \
+    X(transform3_packed_vector_transformation) \
+    X(linalg_kf_predict) \
+    X(linalg_kf_predict_covariance) \
+    X(linalg_kf_update) \
+    X(linalg_kf_update_innovation) \
+    X(linalg_rls_update) \
+    X(linalg_rls_update_batch) \
+    X(linalg_rls_predict) \
+    X(linalg_preconditioner_initialize) \
+    X(linalg_krylov_solve) \
+    X(linalg_expr_evaluate) \
+    LINALG_PROFILE_FIXED_FUNCTIONS(X, 2) \
+    LINALG_PROFILE_FIXED_FUNCTIONS(X, 4) \
+    LINALG_PROFILE_FIXED_FUNCTIONS(X, 6) \
+    LINALG_PROFILE_FIXED_FUNCTIONS(X, 9)
+
+typedef enum {
+    LINALG_PROFILE_ERR_OK = 0,
+    LINALG_PROFILE_ERR_FAIL,
+    LINALG_PROFILE_ERR_NULL,
+    LINALG_PROFILE_ERR_DISABLED,
+} linalg_profile_err_t;
+
+#define LINALG_PROFILE_ID(NAME) LINALG_PROFILE_ID_##NAME,
+
+typedef enum {
+    LINALG_PROFILE_FUNCTIONS(LINALG_PROFILE_ID) LINALG_PROFILE_ID_NUM
+} linalg_profile_id_t;
+
+#undef LINALG_PROFILE_ID
+
+typedef struct {
+    char const* name;
+    uint64_t calls;
+    uint64_t cycles;
+    uint64_t flops;
+    uint64_t bytes;
+} linalg_profile_entry_t;
+
+typedef struct {
+    linalg_profile_entry_t entries[LINALG_PROFILE_ID_NUM];
+} linalg_profile_snapshot_t;
+
+linalg_profile_err_t linalg_profile_snapshot(
+    linalg_profile_snapshot_t* snapshot);
+
+// Zeroes every thread's counters. Safe while profiled threads are running,
+// though a call that ends during the reset may land on either side of it.
+linalg_profile_err_t linalg_profile_reset(void);
+
+#ifdef LINALG_PROFILE
+
+#include <stdatomic.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+typedef struct {
+    _Atomic uint64_t calls;
+    _Atomic uint64_t cycles;
+    _Atomic uint64_t flops;
+    _Atomic uint64_t bytes;
+} linalg_profile_counter_t;
+
+typedef struct linalg_profile_table {
+    linalg_profile_counter_t counters[LINALG_PROFILE_ID_NUM];
+    struct linalg_profile_table* next;
+} linalg_profile_table_t;
+
+typedef struct {
+    linalg_profile_id_t id;
+    uint64_t flops;
+    uint64_t bytes;
+    uint64_t start;
+} linalg_profile_scope_t;
+
+extern _Thread_local linalg_profile_table_t* linalg_profile_table;
+
+linalg_profile_table_t* linalg_profile_table_create(void);
+
+static inline uint64_t linalg_profile_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec time;
+    timespec_get(&time, TIME_UTC);
+
+    return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+#endif
+}
+
+// A read-modify-write rather than a load and store, so that a concurrent
+// linalg_profile_reset is never overwritten with the pre-reset total.
+static inline void linalg_profile_add(_Atomic uint64_t* counter,
+                                      uint64_t value)
+{
+    atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+}
+
+static inline linalg_profile_scope_t linalg_profile_scope_begin(
+    linalg_profile_id_t id,
+    uint64_t flops,
+    uint64_t bytes)
+{
+    return (linalg_profile_scope_t){id, flops, bytes, linalg_profile_cycles()};
+}
+
+static inline void linalg_profile_scope_end(linalg_profile_scope_t* scope)
+{
+    uint64_t cycles = linalg_profile_cycles() - scope->start;
+
+    linalg_profile_table_t* table = linalg_profile_table;
+    if (table == NULL) {
+        table = linalg_profile_table_create();
+        if (table == NULL) {
+            return;
+        }
+    }
+
+    linalg_profile_counter_t* counter = &table->counters[scope->id];
+    linalg_profile_add(&counter->calls, 1ULL);
+    linalg_profile_add(&counter->cycles, cycles);
+    linalg_profile_add(&counter->flops, scope->flops);
+    linalg_profile_add(&counter->bytes, scope->bytes);
+}
+
+#define LINALG_PROFILE_FUNCTION(NAME, FLOPS, BYTES)                      \
+    linalg_profile_scope_t linalg_profile_scope                          \
+        __attribute__((cleanup(linalg_profile_scope_end))) =             \
+            linalg_profile_scope_begin(LINALG_PROFILE_ID_##NAME,         \
+                                       (uint64_t)(FLOPS),                \
+                                       (uint64_t)(BYTES))
+
+#else
+
+#define LINALG_PROFILE_FUNCTION(NAME, FLOPS, BYTES) ((void)0)
+
+#endif // LINALG_PROFILE
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_LINALG_PROFILE_H
@@ -0,0 +1,489 @@
+#include "linalg_reduce.h"
+#include <stdbool.h>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#define LINALG_REDUCE_SSE
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LINALG_REDUCE_POSIX
+#include <pthread.h>
+#endif
+
+// Interleaved accumulators per slice; two SSE registers.
+#define LINALG_REDUCE_LANES 8UL
+// Pairwise recursion stops at leaves of this many elements.
+#define LINALG_REDUCE_LEAF 128UL
+// Slice lengths are a multiple of this, so leaves never straddle slices.
+#define LINALG_REDUCE_BLOCK 1024UL
+// Compensated reductions of fewer terms are summed in double instead.
+#define LINALG_REDUCE_SHORT 16UL
+
+typedef struct {
+    float sum;
+    float error;
+} linalg_reduce_partial_t;
+
+// Reduces the slices [begin, end) of the terms data1[i] or, when data2 is
+// set, data1[i] * data2[i].
+typedef struct {
+    linalg_reduction_t reduction;
+    float const* data1;
+    size_t stride1;
+    float const* data2;
+    size_t stride2;
+    size_t size;
+    size_t slice;
+    size_t begin;
+    size_t end;
+    linalg_reduce_partial_t* partials;
+} linalg_reduce_task_t;
+
+static inline float linalg_reduce_term(linalg_reduce_task_t const* task,
+                                       size_t index)
+{
+    float value = task->data1[index * task->stride1];
+
+    return task->data2 != NULL ? value * task->data2[index * task->stride2]
+                               : value;
+}
+
+// sum + value = total + error exactly, whatever their magnitudes.
+static inline void linalg_reduce_two_sum(float* sum, float* error, float value)
+{
+    float total = *sum + value;
+    float recovered = total - *sum;
+
+    *error += (*sum - (total - recovered)) + (value - recovered);
+    *sum = total;
+}
+
+#ifdef LINALG_REDUCE_SSE
+// Elements index .. index + 3, gathered one by one when strided.
+static inline __m128 linalg_reduce_gather(float const* data,
+                                          size_t stride,
+                                          size_t index)
+{
+    if (stride == 1UL) {
+        return _mm_loadu_ps(&data[index]);
+    }
+
+    return _mm_setr_ps(data[index * stride],
+                       data[(index + 1UL) * stride],
+                       data[(index + 2UL) * stride],
+                       data[(index + 3UL) * stride]);
+}
+
+// Terms index .. index + 3.
+static inline __m128 linalg_reduce_load(linalg_reduce_task_t const* task,
+                                        size_t index)
+{
+    __m128 value = linalg_reduce_gather(task->data1, task->stride1, index);
+
+    return task->data2 != NULL
+               ? _mm_mul_ps(value,
+                            linalg_reduce_gather(
+                                task->data2, task->stride2, index))
+               : value;
+}
+
+static inline void linalg_reduce_two_sum_ps(__m128* sum,
+                                            __m128* error,
+                                            __m128 value)
+{
+    __m128 total = _mm_add_ps(*sum, value);
+    __m128 recovered = _mm_sub_ps(total, *sum);
+
+    *error = _mm_add_ps(
+        *error,
+        _mm_add_ps(_mm_sub_ps(*sum, _mm_sub_ps(total, recovered)),
+                   _mm_sub_ps(value, recovered)));
+    *sum = total;
+}
+#endif
+
+// The lanes below take whole blocks of eight terms, last - first being a
+// multiple of eight. The SIMD paths run lanes 0-3 and 4-7 in two registers
+// and fold them there with the same operations as the scalar loops, so both
+// paths give the same bits.
+static float linalg_reduce_leaf_lanes(linalg_reduce_task_t const* task,
+                                      size_t first,
+                                      size_t last)
+{
+#ifdef LINALG_REDUCE_SSE
+    __m128 low = _mm_setzero_ps();
+    __m128 high = _mm_setzero_ps();
+
+    for (size_t index = first; index < last; index += LINALG_REDUCE_LANES) {
+        low = _mm_add_ps(low, linalg_reduce_load(task, index));
+        high = _mm_add_ps(high, linalg_reduce_load(task, index + 4UL));
+    }
+
+    // (0 + 1, 2 + 3, 4 + 5, 6 + 7), then the same tree as below.
+    __m128 pairs = _mm_add_ps(
+        _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)),
+        _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)));
+    __m128 quads = _mm_add_ps(
+        pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return _mm_cvtss_f32(_mm_add_ss(quads, _mm_movehl_ps(quads, quads)));
+#else
+    float sums[LINALG_REDUCE_LANES] = {0.0F};
+
+    for (size_t index = first; index < last; ++index) {
+        sums[(index - first) % LINALG_REDUCE_LANES] +=
+            linalg_reduce_term(task, index);
+    }
+
+    return ((sums[0U] + sums[1U]) + (sums[2U] + sums[3U])) +
+           ((sums[4U] + sums[5U]) + (sums[6U] + sums[7U]));
+#endif
+}
+
+// Start of the terms left over after the whole blocks of [first, last).
+static inline size_t linalg_reduce_blocks_end(size_t first, size_t last)
+{
+    return first + (last - first) / LINALG_REDUCE_LANES * LINALG_REDUCE_LANES;
+}
+
+// The fewer than eight terms after the blocks are added in order once the
+// lanes are folded, so short ranges, such as those of vector3_dot, skip the
+// lanes altogether.
+static float linalg_reduce_leaf(linalg_reduce_task_t const* task,
+                                size_t first,
+                                size_t last)
+{
+    size_t index = linalg_reduce_blocks_end(first, last);
+    float sum = index > first ? linalg_reduce_leaf_lanes(task, first, index)
+                              : 0.0F;
+
+    for (; index < last; ++index) {
+        sum += linalg_reduce_term(task, index);
+    }
+
+    return sum;
+}
+
+static float linalg_reduce_pairwise(linalg_reduce_task_t const* task,
+                                    size_t first,
+                                    size_t last)
+{
+    size_t size = last - first;
+
+    if (size <= LINALG_REDUCE_LEAF) {
+        return linalg_reduce_leaf(task, first, last);
+    }
+
+    size_t half = (size / 2UL + LINALG_REDUCE_LEAF - 1UL) /
+                  LINALG_REDUCE_LEAF * LINALG_REDUCE_LEAF;
+
+    return linalg_reduce_pairwise(task, first, first + half) +
+           linalg_reduce_pairwise(task, first + half, last);
+}
+
+static linalg_reduce_partial_t linalg_reduce_compensated_lanes(
+    linalg_reduce_task_t const* task,
+    size_t first,
+    size_t last)
+{
+#ifdef LINALG_REDUCE_SSE
+    __m128 sum_low = _mm_setzero_ps();
+    __m128 sum_high = _mm_setzero_ps();
+    __m128 error_low = _mm_setzero_ps();
+    __m128 error_high = _mm_setzero_ps();
+
+    for (size_t index = first; index < last; index += LINALG_REDUCE_LANES) {
+        linalg_reduce_two_sum_ps(
+            &sum_low, &error_low, linalg_reduce_load(task, index));
+        linalg_reduce_two_sum_ps(
+            &sum_high, &error_high, linalg_reduce_load(task, index + 4UL));
+    }
+
+    // The fold below, on the registers.
+    linalg_reduce_two_sum_ps(&sum_low, &error_low, sum_high);
+    error_low = _mm_add_ps(error_low, error_high);
+
+    linalg_reduce_two_sum_ps(
+        &sum_low, &error_low, _mm_movehl_ps(sum_low, sum_low));
+    error_low = _mm_add_ps(error_low, _mm_movehl_ps(error_low, error_low));
+
+    linalg_reduce_two_sum_ps(
+        &sum_low,
+        &error_low,
+        _mm_shuffle_ps(sum_low, sum_low, _MM_SHUFFLE(1, 1, 1, 1)));
+    error_low = _mm_add_ps(
+        error_low,
+        _mm_shuffle_ps(error_low, error_low, _MM_SHUFFLE(1, 1, 1, 1)));
+
+    linalg_reduce_partial_t partial = {_mm_cvtss_f32(sum_low),
+                                       _mm_cvtss_f32(error_low)};
+
+    return partial;
+#else
+    float sums[LINALG_REDUCE_LANES] = {0.0F};
+    float errors[LINALG_REDUCE_LANES] = {0.0F};
+
+    for (size_t index = first; index < last; ++index) {
+        size_t lane = (index - first) % LINALG_REDUCE_LANES;
+
+        linalg_reduce_two_sum(
+            &sums[lane], &errors[lane], linalg_reduce_term(task, index));
+    }
+
+    // Lanes are folded in halves, a balanced tree like linalg_reduce_leaf's.
+    for (size_t width = LINALG_REDUCE_LANES / 2UL; width > 0UL; width /= 2UL) {
+        for (size_t lane = 0UL; lane < width; ++lane) {
+            linalg_reduce_two_sum(
+                &sums[lane], &errors[lane], sums[lane + width]);
+            errors[lane] += errors[lane + width];
+        }
+    }
+
+    linalg_reduce_partial_t partial = {sums[0U], errors[0U]};
+
+    return partial;
+#endif
+}
+
+// Terms index .. last - 1 summed in double. A product of two floats is
+// exact in double, and a few terms round there far below float precision,
+// which a TwoSum chain over them would only match at twice the cost per
+// term.
+static double linalg_reduce_double(linalg_reduce_task_t const* task,
+                                   size_t index,
+                                   size_t last)
+{
+    double sum = 0.0;
+
+    for (; index < last; ++index) {
+        double value = (double)task->data1[index * task->stride1];
+
+        sum += task->data2 != NULL
+                   ? value * (double)task->data2[index * task->stride2]
+                   : value;
+    }
+
+    return sum;
+}
+
+// As linalg_reduce_leaf, with the terms after the blocks summed apart and
+// carried into the folded sum and error.
+static linalg_reduce_partial_t linalg_reduce_compensated(
+    linalg_reduce_task_t const* task,
+    size_t first,
+    size_t last)
+{
+    linalg_reduce_partial_t partial = {0.0F, 0.0F};
+    size_t index = linalg_reduce_blocks_end(first, last);
+
+    if (index > first) {
+        partial = linalg_reduce_compensated_lanes(task, first, index);
+    }
+
+    if (index < last) {
+        double tail = linalg_reduce_double(task, index, last);
+        float high = (float)tail;
+
+        linalg_reduce_two_sum(&partial.sum, &partial.error, high);
+        partial.error += (float)(tail - (double)high);
+    }
+
+    return partial;
+}
+
+static linalg_reduce_partial_t linalg_reduce_slice(
+    linalg_reduce_task_t const* task,
+    size_t first,
+    size_t last)
+{
+    if (task->reduction == LINALG_REDUCTION_PAIRWISE) {
+        linalg_reduce_partial_t partial = {
+            linalg_reduce_pairwise(task, first, last),
+            0.0F,
+        };
+
+        return partial;
+    }
+
+    return linalg_reduce_compensated(task, first, last);
+}
+
+static void linalg_reduce_run_range(linalg_reduce_task_t const* task)
+{
+    for (size_t slice = task->begin; slice < task->end; ++slice) {
+        size_t first = slice * task->slice;
+        size_t last = first + task->slice < task->size ? first + task->slice
+                                                       : task->size;
+
+        task->partials[slice] = linalg_reduce_slice(task, first, last);
+    }
+}
+
+#ifdef LINALG_REDUCE_POSIX
+static void* linalg_reduce_thread(void* argument)
+{
+    linalg_reduce_run_range(argument);
+    return NULL;
+}
+#endif
+
+// Same splitting as matrix_batch: one contiguous range of slices per
+// thread, and threads that fail to start have their range run on the
+// calling thread instead.
+static void linalg_reduce_run(linalg_reduce_task_t const* task,
+                              size_t count,
+                              size_t threads)
+{
+#ifdef LINALG_REDUCE_POSIX
+    if (threads > count) {
+        threads = count;
+    }
+#else
+    threads = 1UL;
+#endif
+
+    if (threads <= 1UL) {
+        linalg_reduce_task_t range = *task;
+        range.begin = 0UL;
+        range.end = count;
+        linalg_reduce_run_range(&range);
+        return;
+    }
+
+#ifdef LINALG_REDUCE_POSIX
+    linalg_reduce_task_t ranges[LINALG_REDUCE_MAX_THREADS];
+    pthread_t handles[LINALG_REDUCE_MAX_THREADS];
+    bool started[LINALG_REDUCE_MAX_THREADS];
+
+    for (size_t thread = 0UL; thread < threads; ++thread) {
+        ranges[thread] = *task;
+        ranges[thread].begin = count * thread / threads;
+        ranges[thread].end = count * (thread + 1UL) / threads;
+    }
+
+    for (size_t thread = 1UL; thread < threads; ++thread) {
+        started[thread] = pthread_create(&handles[thread],
+                                         NULL,
+                                         linalg_reduce_thread,
+                                         &ranges[thread]) == 0;
+    }
+
+    linalg_reduce_run_range(&ranges[0UL]);
+
+    for (size_t thread = 1UL; thread < threads; ++thread) {
+        if (started[thread]) {
+            pthread_join(handles[thread], NULL);
+        } else {
+            linalg_reduce_run_range(&ranges[thread]);
+        }
+    }
+#endif
+}
+
+static float linalg_reduce_combine_pairwise(
+    linalg_reduce_partial_t const* partials,
+    size_t count)
+{
+    if (count == 1UL) {
+        return partials[0UL].sum;
+    }
+
+    size_t half = (count + 1UL) / 2UL;
+
+    return linalg_reduce_combine_pairwise(partials, half) +
+           linalg_reduce_combine_pairwise(&partials[half], count - half);
+}
+
+static float linalg_reduce(linalg_reduce_task_t* task, size_t threads)
+{
+    bool pairwise = task->reduction == LINALG_REDUCTION_PAIRWISE;
+    bool compensated = task->reduction == LINALG_REDUCTION_COMPENSATED;
+
+    // Short inputs skip the lanes and slices, whose setup and fold would
+    // dominate: a short compensated reduction is summed in double, and a
+    // pairwise one shorter than the lanes is the naive loop anyway.
+    if (compensated && task->size < LINALG_REDUCE_SHORT) {
+        return (float)linalg_reduce_double(task, 0UL, task->size);
+    }
+
+    if (!compensated && (!pairwise || task->size < LINALG_REDUCE_LANES)) {
+        float sum = 0.0F;
+
+        for (size_t index = 0UL; index < task->size; ++index) {
+            sum += linalg_reduce_term(task, index);
+        }
+
+        return sum;
+    }
+
+    // A single slice needs neither threads nor partials, and is common
+    // enough to skip them.
+    if (task->size <= LINALG_REDUCE_BLOCK) {
+        linalg_reduce_partial_t partial =
+            linalg_reduce_slice(task, 0UL, task->size);
+
+        return partial.sum + partial.error;
+    }
+
+    size_t slice = (task->size + LINALG_REDUCE_MAX_THREADS - 1UL) /
+                   LINALG_REDUCE_MAX_THREADS;
+    slice = (slice + LINALG_REDUCE_BLOCK - 1UL) / LINALG_REDUCE_BLOCK *
+            LINALG_REDUCE_BLOCK;
+
+    size_t count = (task->size + slice - 1UL) / slice;
+    linalg_reduce_partial_t partials[LINALG_REDUCE_MAX_THREADS];
+
+    task->slice = slice;
+    task->partials = partials;
+    linalg_reduce_run(task, count, threads);
+
+    if (task->reduction == LINALG_REDUCTION_PAIRWISE) {
+        return linalg_reduce_combine_pairwise(partials, count);
+    }
+
+    linalg_reduce_partial_t total = {0.0F, 0.0F};
+
+    for (size_t index = 0UL; index < count; ++index) {
+        linalg_reduce_two_sum(&total.sum, &total.error, partials[index].sum);
+        total.error += partials[index].error;
+    }
+
+    return total.sum + total.error;
+}
+
+float linalg_reduce_sum(linalg_reduction_t reduction,
+                        float const* data,
+                        size_t stride,
+                        size_t size,
+                        size_t threads)
+{
+    linalg_reduce_task_t task = {
+        .reduction = reduction,
+        .data1 = data,
+        .stride1 = stride,
+        .size = size,
+    };
+
+    return linalg_reduce(&task, threads);
+}
+
+float linalg_reduce_dot(linalg_reduction_t reduction,
+                        float const* data1,
+                        size_t stride1,
+                        float const* data2,
+                        size_t stride2,
+                        size_t size,
+                        size_t threads)
+{
+    linalg_reduce_task_t task = {
+        .reduction = reduction,
+        .data1 = data1,
+        .stride1 = stride1,
+        .data2 = data2,
+        .stride2 = stride2,
+        .size = size,
+    };
+
+    return linalg_reduce(&task, threads);
+}
@@ -0,0 +1,72 @@
+#ifndef LINALG_LINALG_REDUCE_H
+#define LINALG_LINALG_REDUCE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    // Left to right in a single accumulator, as a plain loop would.
+    LINALG_REDUCTION_NAIVE = 0,
+    // Pairwise summation; error grows with log(size) rather than size.
+    LINALG_REDUCTION_PAIRWISE,
+    // Compensated summation: the rounding error of every addition is
+    // recovered exactly with TwoSum and added back at the end, so the error
+    // does not grow with size. Fewer than 16 elements, and the last ones
+    // short of a multiple of eight, are summed in double instead, where
+    // products of floats are exact.
+    LINALG_REDUCTION_COMPENSATED,
+} linalg_reduction_t;
+
+// Reduction used by vector_dot, vector3_dot, matrix_trace and
+// matrix_product, chosen with the LINALG_REDUCTION CMake option. The option
+// defines LINALG_REDUCTION_DEFAULT_PAIRWISE or _COMPENSATED, or _NAIVE which
+// is also assumed without either, so that the choice can be tested in #if:
+// the naive default keeps those functions' plain inline loops.
+#if defined(LINALG_REDUCTION_DEFAULT_PAIRWISE)
+#define LINALG_REDUCTION_DEFAULT LINALG_REDUCTION_PAIRWISE
+#elif defined(LINALG_REDUCTION_DEFAULT_COMPENSATED)
+#define LINALG_REDUCTION_DEFAULT LINALG_REDUCTION_COMPENSATED
+#else
+#ifndef LINALG_REDUCTION_DEFAULT_NAIVE
+#define LINALG_REDUCTION_DEFAULT_NAIVE
+#endif
+#define LINALG_REDUCTION_DEFAULT LINALG_REDUCTION_NAIVE
+#endif
+
+#define LINALG_REDUCE_MAX_THREADS 64UL
+
+// Sum of size elements stride apart, and sum of the products of size pairs
+// of elements. For pairwise and compensated reductions the elements are cut
+// into at most LINALG_REDUCE_MAX_THREADS slices whose bounds depend on size
+// alone; each slice is accumulated in eight interleaved lanes, any last
+// elements short of a multiple of eight are added after them, and the slice
+// results are combined in a fixed order. The result is therefore the same
+// bits for any stride, any threads and with or without SIMD, and threads
+// only decides how many slices run concurrently. Naive reductions always
+// run sequentially on the calling thread.
+//
+// Bit-for-bit agreement between builds needs floating point contraction to
+// stay off, which is the default in ISO C mode. These are building blocks
+// of the functions above and are not profiled.
+float linalg_reduce_sum(linalg_reduction_t reduction,
+                        float const* data,
+                        size_t stride,
+                        size_t size,
+                        size_t threads);
+
+float linalg_reduce_dot(linalg_reduction_t reduction,
+                        float const* data1,
+                        size_t stride1,
+                        float const* data2,
+                        size_t stride2,
+                        size_t size,
+                        size_t threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_LINALG_REDUCE_H
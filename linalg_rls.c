@@ -0,0 +1,307 @@
+#include "linalg_rls.h"
+#include "linalg_profile.h"
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define LINALG_RLS_MATRICES 4U
+
+static void linalg_rls_matrices(linalg_rls_t* rls,
+                                matrix_t* (*matrices)[LINALG_RLS_MATRICES])
+{
+    (*matrices)[0U] = &rls->parameters;
+    (*matrices)[1U] = &rls->covariance;
+    (*matrices)[2U] = &rls->gain;
+    (*matrices)[3U] = &rls->scratch;
+}
+
+linalg_rls_err_t linalg_rls_initialize(linalg_rls_t* rls,
+                                       matrix_size_t size,
+                                       linalg_rls_form_t form,
+                                       matrix_data_t forgetting,
+                                       matrix_data_t initial_variance,
+                                       matrix_allocator_t const* allocator)
+{
+    if (rls == NULL || allocator == NULL) {
+        return LINALG_RLS_ERR_NULL;
+    }
+
+    if (size == 0UL) {
+        return LINALG_RLS_ERR_DIMENSION;
+    }
+
+    if (!(forgetting > 0.0F && forgetting <= 1.0F) ||
+        !(initial_variance > 0.0F) ||
+        (form != LINALG_RLS_FORM_COVARIANCE &&
+         form != LINALG_RLS_FORM_SQUARE_ROOT)) {
+        return LINALG_RLS_ERR_FAIL;
+    }
+
+    memset(rls, 0, sizeof(*rls));
+    rls->size = size;
+    rls->form = form;
+    rls->forgetting = forgetting;
+
+    matrix_t* matrices[LINALG_RLS_MATRICES];
+    linalg_rls_matrices(rls, &matrices);
+
+    matrix_size_t const shapes[LINALG_RLS_MATRICES][2U] = {
+        {size, 1UL},
+        {size, size},
+        {size, 1UL},
+        {size, 1UL},
+    };
+
+    for (size_t index = 0UL; index < LINALG_RLS_MATRICES; ++index) {
+        matrix_initialize(matrices[index], allocator);
+
+        if (matrix_create_with_zeros(matrices[index],
+                                     shapes[index][0U],
+                                     shapes[index][1U]) != MATRIX_ERR_OK) {
+            linalg_rls_deinitialize(rls);
+            return LINALG_RLS_ERR_ALLOC;
+        }
+    }
+
+    matrix_data_t diagonal = form == LINALG_RLS_FORM_SQUARE_ROOT
+                                 ? sqrtf(initial_variance)
+                                 : initial_variance;
+
+    for (matrix_size_t row = 0UL; row < size; ++row) {
+        MATRIX_INDEX(&rls->covariance, row, row) = diagonal;
+    }
+
+    return LINALG_RLS_ERR_OK;
+}
+
+linalg_rls_err_t linalg_rls_deinitialize(linalg_rls_t* rls)
+{
+    if (rls == NULL) {
+        return LINALG_RLS_ERR_NULL;
+    }
+
+    matrix_t* matrices[LINALG_RLS_MATRICES];
+    linalg_rls_matrices(rls, &matrices);
+
+    for (size_t index = 0UL; index < LINALG_RLS_MATRICES; ++index) {
+        matrix_delete(matrices[index]);
+    }
+
+    memset(rls, 0, sizeof(*rls));
+
+    return LINALG_RLS_ERR_OK;
+}
+
+static matrix_data_t linalg_rls_dot(matrix_data_t const* a,
+                                    matrix_data_t const* b,
+                                    matrix_size_t size)
+{
+    matrix_data_t sum = 0.0F;
+
+    for (matrix_size_t index = 0UL; index < size; ++index) {
+        sum += a[index] * b[index];
+    }
+
+    return sum;
+}
+
+// k = P phi / (forgetting + phi^T P phi) and
+// P = (P - k (P phi)^T) / forgetting on the lower triangle, mirrored.
+static bool linalg_rls_step_covariance(linalg_rls_t* rls,
+                                       matrix_data_t const* phi)
+{
+    matrix_size_t n = rls->size;
+    matrix_data_t* p = rls->covariance.data;
+    matrix_data_t* p_phi = rls->scratch.data;
+    matrix_data_t* k = rls->gain.data;
+
+    for (matrix_size_t row = 0UL; row < n; ++row) {
+        p_phi[row] = linalg_rls_dot(&p[row * n], phi, n);
+    }
+
+    matrix_data_t alpha = rls->forgetting + linalg_rls_dot(phi, p_phi, n);
+    if (!(alpha > 0.0F)) {
+        return false;
+    }
+
+    matrix_data_t alpha_inv = 1.0F / alpha;
+    matrix_data_t forgetting_inv = 1.0F / rls->forgetting;
+
+    for (matrix_size_t row = 0UL; row < n; ++row) {
+        k[row] = p_phi[row] * alpha_inv;
+    }
+
+    for (matrix_size_t row = 0UL; row < n; ++row) {
+        matrix_data_t* p_row = &p[row * n];
+        matrix_data_t factor = p_phi[row];
+
+        for (matrix_size_t column = 0UL; column <= row; ++column) {
+            p_row[column] =
+                (p_row[column] - factor * k[column]) * forgetting_inv;
+        }
+
+        for (matrix_size_t column = 0UL; column < row; ++column) {
+            p[column * n + row] = p_row[column];
+        }
+    }
+
+    return true;
+}
+
+// Array form of the update: the rows [1, 0] and [R phi / sqrt(forgetting),
+// R / sqrt(forgetting)] are rotated, last row first, until the first column
+// is zero below the top. The top row then holds [gamma, h^T] with
+// gamma^2 = 1 + phi^T P phi / forgetting and k = h / gamma, and the rows
+// below hold the updated R. Rotating from the last row keeps R upper
+// triangular, and every rotation runs along a row of R.
+static void linalg_rls_step_square_root(linalg_rls_t* rls,
+                                        matrix_data_t const* phi)
+{
+    matrix_size_t n = rls->size;
+    matrix_data_t* r = rls->covariance.data;
+    matrix_data_t* f = rls->scratch.data;
+    matrix_data_t* h = rls->gain.data;
+    matrix_data_t scale = 1.0F / sqrtf(rls->forgetting);
+
+    for (matrix_size_t row = 0UL; row < n; ++row) {
+        f[row] = scale * linalg_rls_dot(&r[row * n + row], &phi[row],
+                                        n - row);
+    }
+
+    memset(h, 0, sizeof(matrix_data_t) * n);
+    matrix_data_t gamma = 1.0F;
+
+    for (matrix_size_t row = n; row-- > 0UL;) {
+        matrix_data_t length = hypotf(gamma, f[row]);
+        matrix_data_t c = gamma / length;
+        matrix_data_t s = f[row] / length;
+        matrix_data_t* r_row = &r[row * n];
+        gamma = length;
+
+        for (matrix_size_t column = row; column < n; ++column) {
+            matrix_data_t top = h[column];
+            matrix_data_t value = scale * r_row[column];
+
+            h[column] = c * top + s * value;
+            r_row[column] = c * value - s * top;
+        }
+    }
+
+    matrix_data_t gamma_inv = 1.0F / gamma;
+
+    for (matrix_size_t row = 0UL; row < n; ++row) {
+        h[row] *= gamma_inv;
+    }
+}
+
+static bool linalg_rls_step(linalg_rls_t* rls,
+                            matrix_data_t const* phi,
+                            matrix_data_t y)
+{
+    matrix_data_t* theta = rls->parameters.data;
+    matrix_data_t error = y - linalg_rls_dot(phi, theta, rls->size);
+
+    if (rls->form == LINALG_RLS_FORM_SQUARE_ROOT) {
+        linalg_rls_step_square_root(rls, phi);
+    } else if (!linalg_rls_step_covariance(rls, phi)) {
+        return false;
+    }
+
+    matrix_data_t const* k = rls->gain.data;
+
+    for (matrix_size_t row = 0UL; row < rls->size; ++row) {
+        theta[row] += k[row] * error;
+    }
+
+    rls->error = error;
+
+    return true;
+}
+
+linalg_rls_err_t linalg_rls_update(linalg_rls_t* rls,
+                                   matrix_t const* regressor,
+                                   matrix_data_t observation)
+{
+    if (rls == NULL || regressor == NULL) {
+        return LINALG_RLS_ERR_NULL;
+    }
+
+    matrix_size_t n = rls->size;
+
+    LINALG_PROFILE_FUNCTION(linalg_rls_update,
+                            4UL * n * n,
+                            2UL * sizeof(matrix_data_t) * n * n);
+
+    if (regressor->rows != n || regressor->columns != 1UL) {
+        return LINALG_RLS_ERR_DIMENSION;
+    }
+
+    if (!linalg_rls_step(rls, regressor->data, observation)) {
+        return LINALG_RLS_ERR_INDEFINITE;
+    }
+
+    return LINALG_RLS_ERR_OK;
+}
+
+linalg_rls_err_t linalg_rls_update_batch(linalg_rls_t* rls,
+                                         matrix_t const* regressors,
+                                         matrix_t const* observations,
+                                         matrix_t* errors)
+{
+    if (rls == NULL || regressors == NULL || observations == NULL) {
+        return LINALG_RLS_ERR_NULL;
+    }
+
+    matrix_size_t n = rls->size;
+    matrix_size_t count = regressors->rows;
+
+    LINALG_PROFILE_FUNCTION(linalg_rls_update_batch,
+                            4UL * count * n * n,
+                            2UL * sizeof(matrix_data_t) * count * n * n);
+
+    if (regressors->columns != n || observations->rows != count ||
+        observations->columns != 1UL) {
+        return LINALG_RLS_ERR_DIMENSION;
+    }
+
+    if (errors != NULL &&
+        matrix_resize(errors, count, 1UL) != MATRIX_ERR_OK) {
+        return LINALG_RLS_ERR_ALLOC;
+    }
+
+    for (matrix_size_t sample = 0UL; sample < count; ++sample) {
+        if (!linalg_rls_step(rls,
+                             &MATRIX_INDEX(regressors, sample, 0UL),
+                             observations->data[sample])) {
+            return LINALG_RLS_ERR_INDEFINITE;
+        }
+
+        if (errors != NULL) {
+            errors->data[sample] = rls->error;
+        }
+    }
+
+    return LINALG_RLS_ERR_OK;
+}
+
+linalg_rls_err_t linalg_rls_predict(linalg_rls_t const* rls,
+                                    matrix_t const* regressor,
+                                    matrix_data_t* prediction)
+{
+    if (rls == NULL || regressor == NULL || prediction == NULL) {
+        return LINALG_RLS_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(linalg_rls_predict,
+                            2UL * rls->size,
+                            2UL * sizeof(matrix_data_t) * rls->size);
+
+    if (regressor->rows != rls->size || regressor->columns != 1UL) {
+        return LINALG_RLS_ERR_DIMENSION;
+    }
+
+    *prediction =
+        linalg_rls_dot(regressor->data, rls->parameters.data, rls->size);
+
+    return LINALG_RLS_ERR_OK;
+}
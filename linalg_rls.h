@@ -0,0 +1,84 @@
+#ifndef LINALG_LINALG_RLS_H
+#define LINALG_LINALG_RLS_H
+
+#include "matrix.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    LINALG_RLS_ERR_OK = 0,
+    LINALG_RLS_ERR_FAIL,
+    LINALG_RLS_ERR_NULL,
+    LINALG_RLS_ERR_ALLOC,
+    LINALG_RLS_ERR_DIMENSION,
+    LINALG_RLS_ERR_INDEFINITE,
+} linalg_rls_err_t;
+
+typedef enum {
+    // covariance holds P itself, kept exactly symmetric.
+    LINALG_RLS_FORM_COVARIANCE = 0,
+    // covariance holds the upper triangular R with P = R^T R, updated by
+    // Givens rotations so that P stays positive definite under rounding.
+    LINALG_RLS_FORM_SQUARE_ROOT,
+} linalg_rls_form_t;
+
+// Recursive least squares estimate of parameters theta in y = phi^T theta
+// with exponential forgetting: each sample minimizes
+// sum_i forgetting^(t - i) (y_i - phi_i^T theta)^2. Every workspace matrix
+// is allocated once at initialization, so updates never allocate and cost
+// O(size^2) per sample.
+//
+// parameters is size x 1 and starts at zero, covariance starts at
+// initial_variance times the identity; both may be written directly between
+// updates. After an update, gain holds the gain vector and error the a
+// priori error y - phi^T theta.
+typedef struct {
+    matrix_size_t size;
+    linalg_rls_form_t form;
+    matrix_data_t forgetting;
+    matrix_data_t error;
+    matrix_t parameters;
+    matrix_t covariance;
+    matrix_t gain;
+    matrix_t scratch;
+} linalg_rls_t;
+
+// forgetting must be in (0, 1] and initial_variance positive, otherwise
+// LINALG_RLS_ERR_FAIL.
+linalg_rls_err_t linalg_rls_initialize(linalg_rls_t* rls,
+                                       matrix_size_t size,
+                                       linalg_rls_form_t form,
+                                       matrix_data_t forgetting,
+                                       matrix_data_t initial_variance,
+                                       matrix_allocator_t const* allocator);
+
+linalg_rls_err_t linalg_rls_deinitialize(linalg_rls_t* rls);
+
+// Folds in one sample with regressor phi (size x 1) and observation y. In
+// covariance form LINALG_RLS_ERR_INDEFINITE, raised when rounding has made
+// P indefinite, leaves the estimator unchanged.
+linalg_rls_err_t linalg_rls_update(linalg_rls_t* rls,
+                                   matrix_t const* regressor,
+                                   matrix_data_t observation);
+
+// Folds in a block of samples in order: row i of regressors (count x size)
+// is the regressor of observation i (count x 1). If errors is not NULL it
+// is resized to count x 1 and receives the a priori error of every sample.
+// Stops at the first failing sample, which is left out along with the rest.
+linalg_rls_err_t linalg_rls_update_batch(linalg_rls_t* rls,
+                                         matrix_t const* regressors,
+                                         matrix_t const* observations,
+                                         matrix_t* errors);
+
+// prediction = phi^T theta.
+linalg_rls_err_t linalg_rls_predict(linalg_rls_t const* rls,
+                                    matrix_t const* regressor,
+                                    matrix_data_t* prediction);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_LINALG_RLS_H
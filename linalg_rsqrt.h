@@ -0,0 +1,30 @@
+#ifndef LINALG_LINALG_RSQRT_H
+#define LINALG_LINALG_RSQRT_H
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#else
+#include <math.h>
+#endif
+
+// Hardware reciprocal square root estimate refined by one Newton-Raphson
+// step. Maximum relative error is about 3e-7 with SSE and 2.5e-5 with NEON;
+// other targets fall back to an exact 1 / sqrtf.
+static inline float linalg_rsqrt(float value)
+{
+#if defined(__SSE__)
+    float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+
+    return estimate * (1.5F - 0.5F * value * estimate * estimate);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    float estimate = vrsqrtes_f32(value);
+
+    return estimate * vrsqrtss_f32(value * estimate, estimate);
+#else
+    return 1.0F / sqrtf(value);
+#endif
+}
+
+#endif // LINALG_LINALG_RSQRT_H
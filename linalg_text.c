@@ -0,0 +1,900 @@
+#include "linalg_text.h"
+#include "linalg_profile.h"
+#include <float.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LINALG_TEXT_STAGING_SIZE 65536UL
+#define LINALG_TEXT_READ_SIZE 65536UL
+#define LINALG_TEXT_MAX_TOKEN 128UL
+
+// A double result closer than this (relative) to a float rounding boundary
+// is not trusted and the conversion is left to strtof, which rounds exactly.
+#define LINALG_TEXT_TOLERANCE 0x1p-44
+
+typedef struct {
+    FILE* stream;
+    char* buffer;
+    size_t capacity;
+    size_t length;
+    size_t staged;
+    bool failed;
+    char staging[LINALG_TEXT_STAGING_SIZE];
+} linalg_text_sink_t;
+
+typedef struct {
+    char const* cursor;
+    char const* end;
+    char delimiter;
+    bool done;
+} linalg_text_fields_t;
+
+static double const linalg_text_powers[] = {
+    1E0,  1E1,  1E2,  1E3,  1E4,  1E5,  1E6,  1E7,  1E8,  1E9,  1E10, 1E11,
+    1E12, 1E13, 1E14, 1E15, 1E16, 1E17, 1E18, 1E19, 1E20, 1E21, 1E22,
+};
+
+static uint32_t linalg_text_bits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    return bits;
+}
+
+static float linalg_text_float(uint32_t bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+static bool linalg_text_is_digit(char character)
+{
+    return character >= '0' && character <= '9';
+}
+
+static bool linalg_text_is_blank(char character)
+{
+    return character == ' ' || character == '\t';
+}
+
+// Powers up to 1E22 are exact, so each step rounds once.
+static double linalg_text_scale(double value, int exponent)
+{
+    while (exponent > 22) {
+        value *= 1E22;
+        exponent -= 22;
+    }
+    while (exponent < -22) {
+        value /= 1E22;
+        exponent += 22;
+    }
+
+    return exponent >= 0 ? value * linalg_text_powers[exponent]
+                         : value / linalg_text_powers[-exponent];
+}
+
+// Converts mantissa * 10^exponent to the nearest float through double and
+// returns false when the double error could have changed the rounding.
+static bool linalg_text_decimal(uint64_t mantissa, int exponent, float* value)
+{
+    if (mantissa == 0UL) {
+        *value = 0.0F;
+        return true;
+    }
+
+    if (exponent < -80 || exponent > 60) {
+        return false;
+    }
+
+    double scaled = linalg_text_scale((double)mantissa, exponent);
+    if (scaled < (double)FLT_MIN || scaled > (double)FLT_MAX) {
+        return false;
+    }
+
+    float result = (float)scaled;
+    uint32_t bits = linalg_text_bits(result);
+    double low =
+        ((double)result + (double)linalg_text_float(bits - 1U)) * 0.5;
+    double high =
+        ((double)result + (double)linalg_text_float(bits + 1U)) * 0.5;
+    double tolerance = scaled * LINALG_TEXT_TOLERANCE;
+    if (scaled - low <= tolerance || high - scaled <= tolerance) {
+        return false;
+    }
+
+    *value = result;
+
+    return true;
+}
+
+static bool linalg_text_strtof(char const* begin, char const* end, float* value)
+{
+    size_t size = (size_t)(end - begin);
+    if (size >= LINALG_TEXT_MAX_TOKEN) {
+        return false;
+    }
+
+    char token[LINALG_TEXT_MAX_TOKEN];
+    memcpy(token, begin, size);
+    token[size] = '\0';
+
+    char* stop = NULL;
+    float result = strtof(token, &stop);
+    if (stop != token + size) {
+        return false;
+    }
+
+    *value = result;
+
+    return true;
+}
+
+bool linalg_text_parse_float(char const* begin,
+                             char const* end,
+                             float* value)
+{
+    if (begin == NULL || end == NULL || value == NULL || begin >= end) {
+        return false;
+    }
+
+    char const* cursor = begin;
+    bool negative = false;
+    if (*cursor == '+' || *cursor == '-') {
+        negative = *cursor == '-';
+        ++cursor;
+    }
+
+    uint64_t mantissa = 0UL;
+    int exponent = 0;
+    int digits = 0;
+    bool any = false;
+    bool truncated = false;
+
+    for (; cursor < end && linalg_text_is_digit(*cursor); ++cursor) {
+        uint64_t digit = (uint64_t)(*cursor - '0');
+        any = true;
+        if (digits < 19) {
+            if (mantissa != 0UL || digit != 0UL) {
+                mantissa = mantissa * 10UL + digit;
+                ++digits;
+            }
+        } else {
+            ++exponent;
+            truncated |= digit != 0UL;
+        }
+    }
+
+    if (cursor < end && *cursor == '.') {
+        for (++cursor; cursor < end && linalg_text_is_digit(*cursor);
+             ++cursor) {
+            uint64_t digit = (uint64_t)(*cursor - '0');
+            any = true;
+            if (digits < 19) {
+                if (mantissa != 0UL || digit != 0UL) {
+                    mantissa = mantissa * 10UL + digit;
+                    ++digits;
+                }
+                --exponent;
+            } else {
+                truncated |= digit != 0UL;
+            }
+        }
+    }
+
+    if (!any) {
+        // nan, inf and infinity in any case
+        return linalg_text_strtof(begin, end, value);
+    }
+
+    if (cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+        ++cursor;
+        bool exponent_negative = false;
+        if (cursor < end && (*cursor == '+' || *cursor == '-')) {
+            exponent_negative = *cursor == '-';
+            ++cursor;
+        }
+        if (cursor == end || !linalg_text_is_digit(*cursor)) {
+            return false;
+        }
+
+        int written = 0;
+        for (; cursor < end && linalg_text_is_digit(*cursor); ++cursor) {
+            if (written < 10000) {
+                written = written * 10 + (*cursor - '0');
+            }
+        }
+        exponent += exponent_negative ? -written : written;
+    }
+
+    if (cursor != end) {
+        return false;
+    }
+
+    float result;
+    if (truncated || !linalg_text_decimal(mantissa, exponent, &result)) {
+        return linalg_text_strtof(begin, end, value);
+    }
+
+    *value = negative ? -result : result;
+
+    return true;
+}
+
+// Writes digits * 10^exponent without a sign, in fixed notation for decimal
+// exponents -5 through 8 and scientific notation otherwise.
+static size_t linalg_text_write_decimal(char* buffer,
+                                        uint64_t digits,
+                                        int exponent)
+{
+    while (digits % 10UL == 0UL) {
+        digits /= 10UL;
+        ++exponent;
+    }
+
+    char reversed[20U];
+    int count = 0;
+    do {
+        reversed[count++] = (char)('0' + digits % 10UL);
+        digits /= 10UL;
+    } while (digits != 0UL);
+
+    int leading = exponent + count - 1;
+    char* out = buffer;
+
+    if (leading >= -5 && leading < 0) {
+        *out++ = '0';
+        *out++ = '.';
+        for (int zero = 0; zero < -leading - 1; ++zero) {
+            *out++ = '0';
+        }
+        for (int index = count - 1; index >= 0; --index) {
+            *out++ = reversed[index];
+        }
+    } else if (leading >= 0 && leading < 9) {
+        for (int index = count - 1; index >= 0; --index) {
+            *out++ = reversed[index];
+            if (index == count - leading - 1 && index != 0) {
+                *out++ = '.';
+            }
+        }
+        for (int zero = 0; zero < exponent; ++zero) {
+            *out++ = '0';
+        }
+    } else {
+        *out++ = reversed[count - 1];
+        if (count > 1) {
+            *out++ = '.';
+            for (int index = count - 2; index >= 0; --index) {
+                *out++ = reversed[index];
+            }
+        }
+        *out++ = 'e';
+        if (leading < 0) {
+            *out++ = '-';
+            leading = -leading;
+        }
+        if (leading >= 10) {
+            *out++ = (char)('0' + leading / 10);
+        }
+        *out++ = (char)('0' + leading % 10);
+    }
+
+    return (size_t)(out - buffer);
+}
+
+static bool linalg_text_round_trips(uint64_t digits,
+                                    int exponent,
+                                    float magnitude)
+{
+    float parsed;
+    if (!linalg_text_decimal(digits, exponent, &parsed)) {
+        char text[LINALG_TEXT_FLOAT_SIZE];
+        text[linalg_text_write_decimal(text, digits, exponent)] = '\0';
+        parsed = strtof(text, NULL);
+    }
+
+    return linalg_text_bits(parsed) == linalg_text_bits(magnitude);
+}
+
+size_t linalg_text_format_float(float value, char* buffer)
+{
+    if (buffer == NULL) {
+        return 0UL;
+    }
+
+    uint32_t bits = linalg_text_bits(value);
+    uint32_t magnitude_bits = bits & 0x7FFFFFFFU;
+    char* out = buffer;
+
+    if (magnitude_bits > 0x7F800000U) {
+        memcpy(out, "nan", 4UL);
+        return 3UL;
+    }
+
+    if ((bits >> 31U) != 0U) {
+        *out++ = '-';
+    }
+
+    if (magnitude_bits == 0x7F800000U) {
+        memcpy(out, "inf", 4UL);
+        return (size_t)(out - buffer) + 3UL;
+    }
+
+    if (magnitude_bits == 0U) {
+        memcpy(out, "0", 2UL);
+        return (size_t)(out - buffer) + 1UL;
+    }
+
+    float magnitude = linalg_text_float(magnitude_bits);
+
+    // Nine significant digits always round-trip. Shorter candidates, nearer
+    // neighbour first, are compared against the float's rounding interval
+    // scaled like the digits; only those within the scaling error of an edge
+    // need an exact check.
+    int binary = (int)(magnitude_bits >> 23U) - 127;
+    int leading = (int)((double)binary * 0.30102999566398120);
+    double scaled;
+    for (;;) {
+        scaled = linalg_text_scale((double)magnitude, 8 - leading);
+        if (scaled >= 999999999.5) {
+            ++leading;
+        } else if (scaled < 99999999.5) {
+            --leading;
+        } else {
+            break;
+        }
+    }
+    uint64_t digits9 = (uint64_t)(scaled + 0.5);
+
+    double below = (double)linalg_text_float(magnitude_bits - 1U);
+    double above = magnitude_bits == 0x7F7FFFFFU
+                       ? 2.0 * (double)magnitude - below
+                       : (double)linalg_text_float(magnitude_bits + 1U);
+    double low =
+        linalg_text_scale(((double)magnitude + below) * 0.5, 8 - leading);
+    double high =
+        linalg_text_scale(((double)magnitude + above) * 0.5, 8 - leading);
+    double margin = scaled * LINALG_TEXT_TOLERANCE;
+
+    uint64_t divisor = 100000000UL;
+    for (int count = 1; count <= 9; ++count, divisor /= 10UL) {
+        uint64_t low_digits = digits9 / divisor;
+        uint64_t remainder = digits9 % divisor;
+        uint64_t candidates[2U] = {low_digits, low_digits + 1UL};
+        if (2UL * remainder >= divisor) {
+            candidates[0] = low_digits + 1UL;
+            candidates[1] = low_digits;
+        }
+
+        int exponent = leading - count + 1;
+        for (size_t index = 0UL; index < (remainder == 0UL ? 1UL : 2UL);
+             ++index) {
+            uint64_t candidate = candidates[index];
+            double position = (double)(candidate * divisor);
+            if (position <= low - margin || position >= high + margin) {
+                continue;
+            }
+            if ((position < low + margin || position > high - margin) &&
+                !linalg_text_round_trips(candidate, exponent, magnitude)) {
+                continue;
+            }
+
+            size_t length = linalg_text_write_decimal(out, candidate, exponent);
+            out[length] = '\0';
+            return (size_t)(out - buffer) + length;
+        }
+    }
+
+    int length =
+        snprintf(out, LINALG_TEXT_FLOAT_SIZE - 1U, "%.9g", (double)magnitude);
+
+    return (size_t)(out - buffer) + (size_t)length;
+}
+
+static void linalg_text_flush(linalg_text_sink_t* sink)
+{
+    if (sink->stream != NULL && sink->staged != 0UL) {
+        if (fwrite(sink->staging, 1UL, sink->staged, sink->stream) !=
+            sink->staged) {
+            sink->failed = true;
+        }
+        sink->staged = 0UL;
+    }
+}
+
+static void linalg_text_put(linalg_text_sink_t* sink,
+                            char const* text,
+                            size_t size)
+{
+    if (sink->stream != NULL) {
+        if (sink->staged + size > LINALG_TEXT_STAGING_SIZE) {
+            linalg_text_flush(sink);
+        }
+        memcpy(sink->staging + sink->staged, text, size);
+        sink->staged += size;
+    } else if (sink->length + size <= sink->capacity) {
+        memcpy(sink->buffer + sink->length, text, size);
+    }
+
+    sink->length += size;
+}
+
+static void linalg_text_put_values(linalg_text_sink_t* sink,
+                                   float const* data,
+                                   size_t count,
+                                   size_t columns,
+                                   char delimiter)
+{
+    char text[LINALG_TEXT_FLOAT_SIZE + 1U];
+
+    for (size_t index = 0UL; index < count; ++index) {
+        size_t length = linalg_text_format_float(data[index], text);
+        text[length++] = (index + 1UL) % columns == 0UL ? '\n' : delimiter;
+        linalg_text_put(sink, text, length);
+    }
+}
+
+static bool linalg_text_delimiter(char delimiter)
+{
+    return delimiter != '\0' && delimiter != '\n' && delimiter != '\r' &&
+           delimiter != '.' && delimiter != '+' && delimiter != '-' &&
+           delimiter != 'e' && delimiter != 'E' &&
+           !linalg_text_is_digit(delimiter);
+}
+
+static char const* linalg_text_line(char const* cursor,
+                                    char const* end,
+                                    char const** line_end)
+{
+    char const* newline = memchr(cursor, '\n', (size_t)(end - cursor));
+    char const* stop = newline == NULL ? end : newline;
+
+    *line_end = stop;
+    if (stop > cursor && stop[-1] == '\r') {
+        --*line_end;
+    }
+
+    return newline == NULL ? end : newline + 1;
+}
+
+static bool linalg_text_blank(char const* begin, char const* end)
+{
+    for (; begin < end; ++begin) {
+        if (!linalg_text_is_blank(*begin)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool linalg_text_field(linalg_text_fields_t* fields,
+                              char const** begin,
+                              char const** end)
+{
+    char const* cursor = fields->cursor;
+
+    if (fields->delimiter == LINALG_TEXT_SPACE) {
+        while (cursor < fields->end && linalg_text_is_blank(*cursor)) {
+            ++cursor;
+        }
+        if (cursor == fields->end) {
+            return false;
+        }
+
+        *begin = cursor;
+        while (cursor < fields->end && !linalg_text_is_blank(*cursor)) {
+            ++cursor;
+        }
+        *end = cursor;
+        fields->cursor = cursor;
+
+        return true;
+    }
+
+    if (fields->done) {
+        return false;
+    }
+
+    char const* stop =
+        memchr(cursor, fields->delimiter, (size_t)(fields->end - cursor));
+    if (stop == NULL) {
+        stop = fields->end;
+        fields->done = true;
+    } else {
+        fields->cursor = stop + 1;
+    }
+
+    while (cursor < stop && linalg_text_is_blank(*cursor)) {
+        ++cursor;
+    }
+    *begin = cursor;
+    while (stop > cursor && linalg_text_is_blank(stop[-1])) {
+        --stop;
+    }
+    *end = stop;
+
+    return true;
+}
+
+// Counts non-blank lines and their fields. With uniform set every line must
+// have as many fields as the first.
+static bool linalg_text_shape(char const* buffer,
+                              size_t length,
+                              char delimiter,
+                              bool uniform,
+                              size_t* rows,
+                              size_t* columns,
+                              size_t* count)
+{
+    char const* end = buffer + length;
+    *rows = 0UL;
+    *columns = 0UL;
+    *count = 0UL;
+
+    for (char const* cursor = buffer; cursor < end;) {
+        char const* line_end;
+        char const* line = cursor;
+        cursor = linalg_text_line(cursor, end, &line_end);
+        if (linalg_text_blank(line, line_end)) {
+            continue;
+        }
+
+        linalg_text_fields_t fields = {line, line_end, delimiter, false};
+        char const* field_begin;
+        char const* field_end;
+        size_t line_fields = 0UL;
+        while (linalg_text_field(&fields, &field_begin, &field_end)) {
+            ++line_fields;
+        }
+
+        if (uniform && *rows != 0UL && line_fields != *columns) {
+            return false;
+        }
+
+        *columns = line_fields;
+        *count += line_fields;
+        ++*rows;
+    }
+
+    return true;
+}
+
+static bool linalg_text_fill(char const* buffer,
+                             size_t length,
+                             char delimiter,
+                             float* data)
+{
+    char const* end = buffer + length;
+
+    for (char const* cursor = buffer; cursor < end;) {
+        char const* line_end;
+        char const* line = cursor;
+        cursor = linalg_text_line(cursor, end, &line_end);
+        if (linalg_text_blank(line, line_end)) {
+            continue;
+        }
+
+        linalg_text_fields_t fields = {line, line_end, delimiter, false};
+        char const* field_begin;
+        char const* field_end;
+        while (linalg_text_field(&fields, &field_begin, &field_end)) {
+            if (!linalg_text_parse_float(field_begin, field_end, data++)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Reads the rest of stream into a malloc'ed buffer.
+static char* linalg_text_slurp(FILE* stream, size_t* length)
+{
+    size_t capacity = LINALG_TEXT_READ_SIZE;
+    size_t size = 0UL;
+    char* buffer = malloc(capacity);
+    if (buffer == NULL) {
+        return NULL;
+    }
+
+    for (;;) {
+        if (size == capacity) {
+            char* grown = realloc(buffer, capacity * 2UL);
+            if (grown == NULL) {
+                free(buffer);
+                return NULL;
+            }
+            buffer = grown;
+            capacity *= 2UL;
+        }
+
+        size_t count = fread(buffer + size, 1UL, capacity - size, stream);
+        size += count;
+        if (count == 0UL) {
+            break;
+        }
+    }
+
+    *length = size;
+
+    return buffer;
+}
+
+matrix_err_t matrix_write_text(matrix_t const* matrix,
+                               FILE* stream,
+                               char delimiter)
+{
+    if (matrix == NULL || stream == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_write_text,
+        0,
+        sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
+    if (!linalg_text_delimiter(delimiter)) {
+        return MATRIX_ERR_FAIL;
+    }
+
+    linalg_text_sink_t sink;
+    sink.stream = stream;
+    sink.length = 0UL;
+    sink.staged = 0UL;
+    sink.failed = false;
+
+    if (matrix->columns != 0UL) {
+        linalg_text_put_values(&sink,
+                               matrix->data,
+                               matrix->rows * matrix->columns,
+                               matrix->columns,
+                               delimiter);
+    }
+    linalg_text_flush(&sink);
+
+    return sink.failed ? MATRIX_ERR_IO : MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_format_text(matrix_t const* matrix,
+                                char* buffer,
+                                size_t capacity,
+                                size_t* length,
+                                char delimiter)
+{
+    if (matrix == NULL || (buffer == NULL && capacity != 0UL) ||
+        length == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_format_text,
+        0,
+        sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
+    if (!linalg_text_delimiter(delimiter)) {
+        return MATRIX_ERR_FAIL;
+    }
+
+    linalg_text_sink_t sink;
+    sink.stream = NULL;
+    sink.buffer = buffer;
+    sink.capacity = capacity;
+    sink.length = 0UL;
+
+    if (matrix->columns != 0UL) {
+        linalg_text_put_values(&sink,
+                               matrix->data,
+                               matrix->rows * matrix->columns,
+                               matrix->columns,
+                               delimiter);
+    }
+
+    *length = sink.length;
+    if (sink.length < capacity) {
+        buffer[sink.length] = '\0';
+    }
+
+    return sink.length <= capacity ? MATRIX_ERR_OK : MATRIX_ERR_FAIL;
+}
+
+matrix_err_t matrix_read_text(matrix_t* matrix, FILE* stream, char delimiter)
+{
+    if (matrix == NULL || stream == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_read_text, 0, 0);
+
+    size_t length = 0UL;
+    char* buffer = linalg_text_slurp(stream, &length);
+    if (buffer == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+    if (ferror(stream)) {
+        free(buffer);
+        return MATRIX_ERR_IO;
+    }
+
+    matrix_err_t err = matrix_parse_text(matrix, buffer, length, delimiter);
+    free(buffer);
+
+    return err;
+}
+
+matrix_err_t matrix_parse_text(matrix_t* matrix,
+                               char const* buffer,
+                               size_t length,
+                               char delimiter)
+{
+    if (matrix == NULL || (buffer == NULL && length != 0UL)) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_parse_text, 0, length);
+
+    if (!linalg_text_delimiter(delimiter)) {
+        return MATRIX_ERR_FAIL;
+    }
+
+    size_t rows, columns, count;
+    if (!linalg_text_shape(
+            buffer, length, delimiter, true, &rows, &columns, &count)) {
+        return MATRIX_ERR_FORMAT;
+    }
+
+    // Parsed aside so that matrix survives a malformed field.
+    matrix_t temp;
+    matrix_initialize(&temp, &matrix->allocator);
+
+    matrix_err_t err = matrix_create(&temp, rows, columns);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    if (!linalg_text_fill(buffer, length, delimiter, temp.data)) {
+        matrix_delete(&temp);
+        return MATRIX_ERR_FORMAT;
+    }
+
+    matrix_delete(matrix);
+    *matrix = temp;
+
+    return MATRIX_ERR_OK;
+}
+
+vector_err_t vector_write_text(vector_t const* vector,
+                               FILE* stream,
+                               char delimiter)
+{
+    if (vector == NULL || stream == NULL) {
+        return VECTOR_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        vector_write_text, 0, sizeof(vector_data_t) * vector->size);
+
+    if (!linalg_text_delimiter(delimiter)) {
+        return VECTOR_ERR_FAIL;
+    }
+
+    linalg_text_sink_t sink;
+    sink.stream = stream;
+    sink.length = 0UL;
+    sink.staged = 0UL;
+    sink.failed = false;
+
+    if (vector->size != 0UL) {
+        linalg_text_put_values(
+            &sink, vector->data, vector->size, vector->size, delimiter);
+    }
+    linalg_text_flush(&sink);
+
+    return sink.failed ? VECTOR_ERR_IO : VECTOR_ERR_OK;
+}
+
+vector_err_t vector_format_text(vector_t const* vector,
+                                char* buffer,
+                                size_t capacity,
+                                size_t* length,
+                                char delimiter)
+{
+    if (vector == NULL || (buffer == NULL && capacity != 0UL) ||
+        length == NULL) {
+        return VECTOR_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        vector_format_text, 0, sizeof(vector_data_t) * vector->size);
+
+    if (!linalg_text_delimiter(delimiter)) {
+        return VECTOR_ERR_FAIL;
+    }
+
+    linalg_text_sink_t sink;
+    sink.stream = NULL;
+    sink.buffer = buffer;
+    sink.capacity = capacity;
+    sink.length = 0UL;
+
+    if (vector->size != 0UL) {
+        linalg_text_put_values(
+            &sink, vector->data, vector->size, vector->size, delimiter);
+    }
+
+    *length = sink.length;
+    if (sink.length < capacity) {
+        buffer[sink.length] = '\0';
+    }
+
+    return sink.length <= capacity ? VECTOR_ERR_OK : VECTOR_ERR_FAIL;
+}
+
+vector_err_t vector_read_text(vector_t* vector, FILE* stream, char delimiter)
+{
+    if (vector == NULL || stream == NULL) {
+        return VECTOR_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(vector_read_text, 0, 0);
+
+    size_t length = 0UL;
+    char* buffer = linalg_text_slurp(stream, &length);
+    if (buffer == NULL) {
+        return VECTOR_ERR_ALLOC;
+    }
+    if (ferror(stream)) {
+        free(buffer);
+        return VECTOR_ERR_IO;
+    }
+
+    vector_err_t err = vector_parse_text(vector, buffer, length, delimiter);
+    free(buffer);
+
+    return err;
+}
+
+vector_err_t vector_parse_text(vector_t* vector,
+                               char const* buffer,
+                               size_t length,
+                               char delimiter)
+{
+    if (vector == NULL || (buffer == NULL && length != 0UL)) {
+        return VECTOR_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(vector_parse_text, 0, length);
+
+    if (!linalg_text_delimiter(delimiter)) {
+        return VECTOR_ERR_FAIL;
+    }
+
+    size_t rows, columns, count;
+    if (!linalg_text_shape(
+            buffer, length, delimiter, false, &rows, &columns, &count)) {
+        return VECTOR_ERR_FORMAT;
+    }
+
+    // Parsed aside so that vector survives a malformed field.
+    vector_t temp;
+    vector_initialize(&temp, &vector->allocator);
+
+    vector_err_t err = vector_create(&temp, count);
+    if (err != VECTOR_ERR_OK) {
+        return err;
+    }
+
+    if (!linalg_text_fill(buffer, length, delimiter, temp.data)) {
+        vector_delete(&temp);
+        return VECTOR_ERR_FORMAT;
+    }
+
+    vector_delete(vector);
+    *vector = temp;
+
+    return VECTOR_ERR_OK;
+}
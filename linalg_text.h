@@ -0,0 +1,79 @@
+#ifndef LINALG_LINALG_TEXT_H
+#define LINALG_LINALG_TEXT_H
+
+#include "matrix.h"
+#include "vector.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Enough for the longest output of linalg_text_format_float plus a NUL.
+#define LINALG_TEXT_FLOAT_SIZE 24U
+
+#define LINALG_TEXT_CSV ','
+#define LINALG_TEXT_TSV '\t'
+// Fields separated by any run of spaces and tabs.
+#define LINALG_TEXT_SPACE ' '
+
+// Writes the shortest decimal that reads back as exactly value and returns
+// its length. buffer must hold LINALG_TEXT_FLOAT_SIZE bytes.
+size_t linalg_text_format_float(float value, char* buffer);
+
+// Parses the number in [begin, end), which must contain nothing else.
+// Results are correctly rounded; NaN and infinities are accepted.
+bool linalg_text_parse_float(char const* begin,
+                             char const* end,
+                             float* value);
+
+// Matrices are written one row per line with delimiter between elements,
+// vectors as a single line. The memory variants store the required length in
+// *length and fail with ERR_FAIL if it does not fit in capacity bytes; the
+// text is NUL-terminated when there is room.
+matrix_err_t matrix_write_text(matrix_t const* matrix,
+                               FILE* stream,
+                               char delimiter);
+
+matrix_err_t matrix_format_text(matrix_t const* matrix,
+                                char* buffer,
+                                size_t capacity,
+                                size_t* length,
+                                char delimiter);
+
+// Resizes matrix to the rows and columns found in the text. Blank lines are
+// skipped and every other line must have the same number of fields. On
+// ERR_FORMAT the matrix is left as it was.
+matrix_err_t matrix_read_text(matrix_t* matrix, FILE* stream, char delimiter);
+
+matrix_err_t matrix_parse_text(matrix_t* matrix,
+                               char const* buffer,
+                               size_t length,
+                               char delimiter);
+
+vector_err_t vector_write_text(vector_t const* vector,
+                               FILE* stream,
+                               char delimiter);
+
+vector_err_t vector_format_text(vector_t const* vector,
+                                char* buffer,
+                                size_t capacity,
+                                size_t* length,
+                                char delimiter);
+
+// Reads every field on every line, so both row and column layouts load. On
+// ERR_FORMAT the vector is left as it was.
+vector_err_t vector_read_text(vector_t* vector, FILE* stream, char delimiter);
+
+vector_err_t vector_parse_text(vector_t* vector,
+                               char const* buffer,
+                               size_t length,
+                               char delimiter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_LINALG_TEXT_H
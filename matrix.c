@@ -1,7 +1,24 @@
 #include "matrix.h"
+#include "linalg_profile.h"
+#include "linalg_reduce.h"
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MATRIX_SSE
+#endif
+
+// Transposes recurse on the longer side until both sides fit in a leaf,
+// which is then walked in tiles by the micro-kernel. The leaf is small
+// enough for its source rows and destination rows to stay cached together.
+#define MATRIX_TRANSPOSE_TILE 8UL
+#define MATRIX_TRANSPOSE_LEAF 32UL
+
+// Longest matrix2 column the reduced matrix_product copies to the stack.
+#define MATRIX_PRODUCT_COLUMN 1024UL
+
 static matrix_data_t* matrix_allocate(matrix_t const* matrix,
                                       matrix_size_t size)
 {
@@ -28,6 +45,8 @@ matrix_err_t matrix_initialize(matrix_t* matrix,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_initialize, 0, 0);
+
     memset(matrix, 0, sizeof(*matrix));
     memcpy(&matrix->allocator, allocator, sizeof(*allocator));
 
@@ -40,6 +59,8 @@ matrix_err_t matrix_deinitialize(matrix_t* matrix)
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_deinitialize, 0, 0);
+
     memset(matrix, 0, sizeof(*matrix));
 
     return MATRIX_ERR_OK;
@@ -53,6 +74,8 @@ matrix_err_t matrix_create(matrix_t* matrix,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_create, 0, 0);
+
     matrix_data_t* data =
         matrix_allocate(matrix, sizeof(matrix_data_t) * rows * columns);
     if (data == NULL) {
@@ -74,6 +97,10 @@ matrix_err_t matrix_create_with_zeros(matrix_t* matrix,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_create_with_zeros,
+                            0,
+                            sizeof(matrix_data_t) * rows * columns);
+
     matrix_err_t err = matrix_create(matrix, rows, columns);
     if (err != MATRIX_ERR_OK) {
         return err;
@@ -92,6 +119,10 @@ matrix_err_t matrix_create_with_array(
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_create_with_array,
+                            0,
+                            2UL * sizeof(matrix_data_t) * rows * columns);
+
     matrix_err_t err = matrix_create(matrix, rows, columns);
     if (err != MATRIX_ERR_OK) {
         return err;
@@ -106,6 +137,8 @@ matrix_err_t matrix_delete(matrix_t* matrix)
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_delete, 0, 0);
+
     if (matrix->data != NULL) {
         matrix_deallocate(matrix, matrix->data);
     }
@@ -125,6 +158,8 @@ matrix_err_t matrix_resize(matrix_t* matrix,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_resize, 0, 0);
+
     if (matrix->data != NULL && matrix->rows == rows &&
         matrix->columns == columns) {
         return MATRIX_ERR_OK;
@@ -163,6 +198,10 @@ matrix_err_t matrix_resize_with_zeros(matrix_t* matrix,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_resize_with_zeros,
+                            0,
+                            sizeof(matrix_data_t) * rows * columns);
+
     matrix_err_t err = matrix_resize(matrix, rows, columns);
     if (err != MATRIX_ERR_OK) {
         return err;
@@ -181,6 +220,10 @@ matrix_err_t matrix_resize_with_array(
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_resize_with_array,
+                            0,
+                            2UL * sizeof(matrix_data_t) * rows * columns);
+
     matrix_err_t err = matrix_resize(matrix, rows, columns);
     if (err != MATRIX_ERR_OK) {
         return err;
@@ -195,6 +238,11 @@ matrix_err_t matrix_fill_with_zeros(matrix_t* matrix)
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_fill_with_zeros,
+        0,
+        sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
     memset(matrix->data,
            0,
            sizeof(matrix_data_t) * matrix->rows * matrix->columns);
@@ -210,6 +258,11 @@ matrix_err_t matrix_fill_with_array(
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_fill_with_array,
+        0,
+        2UL * sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
     memcpy(matrix->data,
            array,
            sizeof(matrix_data_t) * matrix->rows * matrix->columns);
@@ -223,6 +276,11 @@ matrix_err_t matrix_copy(matrix_t const* source, matrix_t* destination)
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_copy,
+        0,
+        2UL * sizeof(matrix_data_t) * source->rows * source->columns);
+
     matrix_err_t err =
         matrix_resize(destination, source->rows, source->columns);
     if (err != MATRIX_ERR_OK) {
@@ -242,6 +300,8 @@ matrix_err_t matrix_move(matrix_t* source, matrix_t* destination)
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_move, 0, 0);
+
     matrix_err_t err = matrix_delete(destination);
     if (err != MATRIX_ERR_OK) {
         return err;
@@ -267,6 +327,11 @@ matrix_err_t matrix_minor(matrix_t const* matrix,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_minor,
+        0,
+        2UL * sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
     if (matrix->rows != matrix->columns || minor_row >= matrix->rows ||
         minor_column >= matrix->columns) {
         return MATRIX_ERR_DIMENSION;
@@ -308,6 +373,8 @@ matrix_err_t matrix_complement(matrix_t const* matrix, matrix_t* complement)
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_complement, 0, 0);
+
     if (matrix->rows != matrix->columns) {
         return MATRIX_ERR_DIMENSION;
     }
@@ -352,6 +419,8 @@ matrix_err_t matrix_adjoint(matrix_t const* matrix, matrix_t* adjoint)
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_adjoint, 0, 0);
+
     if (matrix->rows != matrix->columns) {
         return MATRIX_ERR_DIMENSION;
     }
@@ -375,24 +444,338 @@ matrix_err_t matrix_adjoint(matrix_t const* matrix, matrix_t* adjoint)
     return matrix_delete(&complement);
 }
 
+#if defined(MATRIX_SSE)
+static inline void matrix_transpose_4x4(matrix_data_t const* source,
+                                        matrix_size_t source_stride,
+                                        matrix_data_t* destination,
+                                        matrix_size_t destination_stride)
+{
+    __m128 row0 = _mm_loadu_ps(&source[0UL]);
+    __m128 row1 = _mm_loadu_ps(&source[source_stride]);
+    __m128 row2 = _mm_loadu_ps(&source[2UL * source_stride]);
+    __m128 row3 = _mm_loadu_ps(&source[3UL * source_stride]);
+
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+    _mm_storeu_ps(&destination[0UL], row0);
+    _mm_storeu_ps(&destination[destination_stride], row1);
+    _mm_storeu_ps(&destination[2UL * destination_stride], row2);
+    _mm_storeu_ps(&destination[3UL * destination_stride], row3);
+}
+#endif
+
+static inline void matrix_transpose_tile(matrix_data_t const* source,
+                                         matrix_size_t source_stride,
+                                         matrix_data_t* destination,
+                                         matrix_size_t destination_stride)
+{
+#if defined(MATRIX_SSE)
+    matrix_size_t const half = MATRIX_TRANSPOSE_TILE / 2UL;
+
+    for (matrix_size_t row = 0UL; row < MATRIX_TRANSPOSE_TILE; row += half) {
+        for (matrix_size_t column = 0UL; column < MATRIX_TRANSPOSE_TILE;
+             column += half) {
+            matrix_transpose_4x4(&source[row * source_stride + column],
+                                 source_stride,
+                                 &destination[column * destination_stride +
+                                              row],
+                                 destination_stride);
+        }
+    }
+#else
+    for (matrix_size_t row = 0UL; row < MATRIX_TRANSPOSE_TILE; ++row) {
+        for (matrix_size_t column = 0UL; column < MATRIX_TRANSPOSE_TILE;
+             ++column) {
+            destination[column * destination_stride + row] =
+                source[row * source_stride + column];
+        }
+    }
+#endif
+}
+
+// Splits at a multiple of the tile size so that only the last block along
+// each side has a partial tile.
+static inline matrix_size_t matrix_transpose_split(matrix_size_t size)
+{
+    return size / 2UL / MATRIX_TRANSPOSE_TILE * MATRIX_TRANSPOSE_TILE;
+}
+
+// destination (columns x rows) = transpose of source (rows x columns).
+static void matrix_transpose_block(matrix_data_t const* source,
+                                   matrix_size_t source_stride,
+                                   matrix_data_t* destination,
+                                   matrix_size_t destination_stride,
+                                   matrix_size_t rows,
+                                   matrix_size_t columns)
+{
+    if (rows > MATRIX_TRANSPOSE_LEAF && rows >= columns) {
+        matrix_size_t half = matrix_transpose_split(rows);
+
+        matrix_transpose_block(source,
+                               source_stride,
+                               destination,
+                               destination_stride,
+                               half,
+                               columns);
+        matrix_transpose_block(&source[half * source_stride],
+                               source_stride,
+                               &destination[half],
+                               destination_stride,
+                               rows - half,
+                               columns);
+        return;
+    }
+
+    if (columns > MATRIX_TRANSPOSE_LEAF) {
+        matrix_size_t half = matrix_transpose_split(columns);
+
+        matrix_transpose_block(source,
+                               source_stride,
+                               destination,
+                               destination_stride,
+                               rows,
+                               half);
+        matrix_transpose_block(&source[half],
+                               source_stride,
+                               &destination[half * destination_stride],
+                               destination_stride,
+                               rows,
+                               columns - half);
+        return;
+    }
+
+    matrix_size_t tiled_rows = rows / MATRIX_TRANSPOSE_TILE *
+                               MATRIX_TRANSPOSE_TILE;
+    matrix_size_t tiled_columns = columns / MATRIX_TRANSPOSE_TILE *
+                                  MATRIX_TRANSPOSE_TILE;
+
+    for (matrix_size_t row = 0UL; row < tiled_rows;
+         row += MATRIX_TRANSPOSE_TILE) {
+        for (matrix_size_t column = 0UL; column < tiled_columns;
+             column += MATRIX_TRANSPOSE_TILE) {
+            matrix_transpose_tile(&source[row * source_stride + column],
+                                  source_stride,
+                                  &destination[column * destination_stride +
+                                               row],
+                                  destination_stride);
+        }
+
+        for (matrix_size_t r = row; r < row + MATRIX_TRANSPOSE_TILE; ++r) {
+            for (matrix_size_t column = tiled_columns; column < columns;
+                 ++column) {
+                destination[column * destination_stride + r] =
+                    source[r * source_stride + column];
+            }
+        }
+    }
+
+    for (matrix_size_t row = tiled_rows; row < rows; ++row) {
+        for (matrix_size_t column = 0UL; column < columns; ++column) {
+            destination[column * destination_stride + row] =
+                source[row * source_stride + column];
+        }
+    }
+}
+
+// Exchanges block1 (rows x columns) with the transpose of block2
+// (columns x rows); both blocks share the same stride and do not overlap.
+static void matrix_transpose_swap(matrix_data_t* block1,
+                                  matrix_data_t* block2,
+                                  matrix_size_t stride,
+                                  matrix_size_t rows,
+                                  matrix_size_t columns)
+{
+    if (rows > MATRIX_TRANSPOSE_LEAF && rows >= columns) {
+        matrix_size_t half = matrix_transpose_split(rows);
+
+        matrix_transpose_swap(block1, block2, stride, half, columns);
+        matrix_transpose_swap(&block1[half * stride],
+                              &block2[half],
+                              stride,
+                              rows - half,
+                              columns);
+        return;
+    }
+
+    if (columns > MATRIX_TRANSPOSE_LEAF) {
+        matrix_size_t half = matrix_transpose_split(columns);
+
+        matrix_transpose_swap(block1, block2, stride, rows, half);
+        matrix_transpose_swap(&block1[half],
+                              &block2[half * stride],
+                              stride,
+                              rows,
+                              columns - half);
+        return;
+    }
+
+    matrix_size_t tiled_rows = rows / MATRIX_TRANSPOSE_TILE *
+                               MATRIX_TRANSPOSE_TILE;
+    matrix_size_t tiled_columns = columns / MATRIX_TRANSPOSE_TILE *
+                                  MATRIX_TRANSPOSE_TILE;
+    matrix_data_t tile[MATRIX_TRANSPOSE_TILE * MATRIX_TRANSPOSE_TILE];
+
+    for (matrix_size_t row = 0UL; row < tiled_rows;
+         row += MATRIX_TRANSPOSE_TILE) {
+        for (matrix_size_t column = 0UL; column < tiled_columns;
+             column += MATRIX_TRANSPOSE_TILE) {
+            matrix_data_t* tile1 = &block1[row * stride + column];
+            matrix_data_t* tile2 = &block2[column * stride + row];
+
+            matrix_transpose_tile(tile1,
+                                  stride,
+                                  tile,
+                                  MATRIX_TRANSPOSE_TILE);
+            matrix_transpose_tile(tile2, stride, tile1, stride);
+
+            for (matrix_size_t r = 0UL; r < MATRIX_TRANSPOSE_TILE; ++r) {
+                memcpy(&tile2[r * stride],
+                       &tile[r * MATRIX_TRANSPOSE_TILE],
+                       sizeof(matrix_data_t) * MATRIX_TRANSPOSE_TILE);
+            }
+        }
+    }
+
+    for (matrix_size_t row = 0UL; row < rows; ++row) {
+        matrix_size_t first = row < tiled_rows ? tiled_columns : 0UL;
+
+        for (matrix_size_t column = first; column < columns; ++column) {
+            matrix_data_t value = block1[row * stride + column];
+            block1[row * stride + column] = block2[column * stride + row];
+            block2[column * stride + row] = value;
+        }
+    }
+}
+
+static void matrix_transpose_square(matrix_data_t* data,
+                                    matrix_size_t stride,
+                                    matrix_size_t size)
+{
+    if (size <= MATRIX_TRANSPOSE_LEAF) {
+        for (matrix_size_t row = 1UL; row < size; ++row) {
+            for (matrix_size_t column = 0UL; column < row; ++column) {
+                matrix_data_t value = data[row * stride + column];
+                data[row * stride + column] = data[column * stride + row];
+                data[column * stride + row] = value;
+            }
+        }
+        return;
+    }
+
+    matrix_size_t half = matrix_transpose_split(size);
+
+    matrix_transpose_square(data, stride, half);
+    matrix_transpose_square(&data[half * stride + half], stride, size - half);
+    matrix_transpose_swap(&data[half],
+                          &data[half * stride],
+                          stride,
+                          half,
+                          size - half);
+}
+
+// Follows the cycles of the permutation that takes index row * columns +
+// column to column * rows + row, marking visited elements in a bitmap of one
+// bit per element.
+static matrix_err_t matrix_transpose_cycles(matrix_t* matrix)
+{
+    matrix_size_t rows = matrix->rows;
+    matrix_size_t columns = matrix->columns;
+    matrix_size_t size = rows * columns;
+    matrix_size_t bytes = (size + 7UL) / 8UL;
+
+    matrix_data_t* storage = matrix_allocate(
+        matrix,
+        (bytes + sizeof(matrix_data_t) - 1UL) / sizeof(matrix_data_t) *
+            sizeof(matrix_data_t));
+    if (storage == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    unsigned char* visited = (unsigned char*)storage;
+    memset(visited, 0, bytes);
+
+    // The first and last elements are fixed points.
+    for (matrix_size_t start = 1UL; start + 1UL < size; ++start) {
+        if ((visited[start / 8UL] >> (start % 8UL)) & 1U) {
+            continue;
+        }
+
+        matrix_size_t index = start;
+        matrix_data_t value = matrix->data[start];
+
+        do {
+            index = index % columns * rows + index / columns;
+
+            matrix_data_t next = matrix->data[index];
+            matrix->data[index] = value;
+            value = next;
+
+            visited[index / 8UL] |= (unsigned char)(1U << (index % 8UL));
+        } while (index != start);
+    }
+
+    matrix_deallocate(matrix, storage);
+
+    return MATRIX_ERR_OK;
+}
+
 matrix_err_t matrix_transpose(matrix_t const* matrix, matrix_t* transpose)
 {
     if (matrix == NULL || transpose == NULL) {
         return MATRIX_ERR_NULL;
     }
 
+    if (matrix == transpose) {
+        return matrix_transpose_in_place(transpose);
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_transpose,
+        0,
+        2UL * sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
     matrix_err_t err = matrix_resize(transpose, matrix->columns, matrix->rows);
     if (err != MATRIX_ERR_OK) {
         return err;
     }
 
-    for (matrix_size_t row = 0UL; row < matrix->rows; ++row) {
-        for (matrix_size_t column = 0UL; column < matrix->columns; ++column) {
-            MATRIX_INDEX(transpose, column, row) =
-                MATRIX_INDEX(matrix, row, column);
+    matrix_transpose_block(matrix->data,
+                           matrix->columns,
+                           transpose->data,
+                           transpose->columns,
+                           matrix->rows,
+                           matrix->columns);
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_transpose_in_place(matrix_t* matrix)
+{
+    if (matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_transpose_in_place,
+        0,
+        2UL * sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
+    if (matrix->rows == matrix->columns) {
+        matrix_transpose_square(matrix->data, matrix->columns, matrix->rows);
+        return MATRIX_ERR_OK;
+    }
+
+    if (matrix->rows > 1UL && matrix->columns > 1UL) {
+        matrix_err_t err = matrix_transpose_cycles(matrix);
+        if (err != MATRIX_ERR_OK) {
+            return err;
         }
     }
 
+    matrix_size_t rows = matrix->rows;
+    matrix->rows = matrix->columns;
+    matrix->columns = rows;
+
     return MATRIX_ERR_OK;
 }
 
@@ -402,6 +785,8 @@ matrix_err_t matrix_det(matrix_t const* matrix, matrix_data_t* det)
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_det, 0, 0);
+
     if (matrix->rows != matrix->columns) {
         return MATRIX_ERR_DIMENSION;
     }
@@ -449,6 +834,8 @@ matrix_err_t matrix_inverse(matrix_t const* matrix, matrix_t* inverse)
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_inverse, 0, 0);
+
     if (matrix->rows != matrix->columns) {
         return MATRIX_ERR_DIMENSION;
     }
@@ -489,6 +876,11 @@ matrix_err_t matrix_upper_triangular(matrix_t const* matrix,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_upper_triangular,
+        matrix->rows * matrix->rows * matrix->rows / 3UL,
+        2UL * sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
     if (matrix->rows != matrix->columns) {
         return MATRIX_ERR_DIMENSION;
     }
@@ -520,6 +912,11 @@ matrix_err_t matrix_lower_triangular(matrix_t const* matrix,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_lower_triangular,
+        matrix->rows * matrix->rows * matrix->rows / 3UL,
+        2UL * sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
     if (matrix->rows != matrix->columns) {
         return MATRIX_ERR_DIMENSION;
     }
@@ -569,6 +966,11 @@ matrix_err_t matrix_row_echelon_form(matrix_t const* matrix,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_row_echelon_form,
+        0,
+        2UL * sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
     matrix_err_t err = matrix_copy(matrix, row_echelon_form);
     if (err != MATRIX_ERR_OK) {
         return err;
@@ -618,6 +1020,11 @@ matrix_err_t matrix_sum(matrix_t const* matrix1,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_sum,
+        matrix1->rows * matrix1->columns,
+        3UL * sizeof(matrix_data_t) * matrix1->rows * matrix1->columns);
+
     if (matrix1->rows != matrix2->rows ||
         matrix1->columns != matrix2->columns) {
         return MATRIX_ERR_DIMENSION;
@@ -647,6 +1054,11 @@ matrix_err_t matrix_difference(matrix_t const* matrix1,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_difference,
+        matrix1->rows * matrix1->columns,
+        3UL * sizeof(matrix_data_t) * matrix1->rows * matrix1->columns);
+
     if (matrix1->rows != matrix2->rows ||
         matrix1->columns != matrix2->columns) {
         return MATRIX_ERR_DIMENSION;
@@ -677,6 +1089,11 @@ matrix_err_t matrix_scale(matrix_t const* matrix,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_scale,
+        matrix->rows * matrix->columns,
+        2UL * sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
     matrix_err_t err = matrix_resize(scale, matrix->rows, matrix->columns);
     if (err != MATRIX_ERR_OK) {
         return err;
@@ -692,6 +1109,47 @@ matrix_err_t matrix_scale(matrix_t const* matrix,
     return MATRIX_ERR_OK;
 }
 
+#ifndef LINALG_REDUCTION_DEFAULT_NAIVE
+// Every element is the reduction of a row of matrix1 against a column of
+// matrix2. Columns of up to MATRIX_PRODUCT_COLUMN rows are copied to the
+// stack so that the reduction runs contiguous, and longer ones are read in
+// place; reductions give the same bits for any stride, so each element
+// equals the vector_dot of its row and column either way.
+static void matrix_product_reduced(matrix_t const* matrix1,
+                                   matrix_t const* matrix2,
+                                   matrix_t* product)
+{
+    matrix_data_t column_copy[MATRIX_PRODUCT_COLUMN];
+    bool copied = matrix2->rows <= MATRIX_PRODUCT_COLUMN;
+
+    for (matrix_size_t column = 0UL; column < matrix2->columns; ++column) {
+        matrix_data_t const* column_data = &MATRIX_INDEX(matrix2, 0UL, column);
+        matrix_size_t stride = matrix2->columns;
+
+        if (copied) {
+            for (matrix_size_t common = 0UL; common < matrix2->rows;
+                 ++common) {
+                column_copy[common] = column_data[common * stride];
+            }
+
+            column_data = column_copy;
+            stride = 1UL;
+        }
+
+        for (matrix_size_t row = 0UL; row < matrix1->rows; ++row) {
+            MATRIX_INDEX(product, row, column) =
+                linalg_reduce_dot(LINALG_REDUCTION_DEFAULT,
+                                  &MATRIX_INDEX(matrix1, row, 0UL),
+                                  1UL,
+                                  column_data,
+                                  stride,
+                                  matrix1->columns,
+                                  1UL);
+        }
+    }
+}
+#endif
+
 matrix_err_t matrix_product(matrix_t const* matrix1,
                             matrix_t const* matrix2,
                             matrix_t* product)
@@ -700,6 +1158,13 @@ matrix_err_t matrix_product(matrix_t const* matrix1,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_product,
+        2UL * matrix1->rows * matrix1->columns * matrix2->columns,
+        sizeof(matrix_data_t) * (matrix1->rows * matrix1->columns +
+                                 matrix2->rows * matrix2->columns +
+                                 matrix1->rows * matrix2->columns));
+
     if (matrix1->columns != matrix2->rows) {
         return MATRIX_ERR_DIMENSION;
     }
@@ -709,6 +1174,9 @@ matrix_err_t matrix_product(matrix_t const* matrix1,
         return err;
     }
 
+#ifndef LINALG_REDUCTION_DEFAULT_NAIVE
+    matrix_product_reduced(matrix1, matrix2, product);
+#else
     for (matrix_size_t row = 0UL; row < matrix1->rows; ++row) {
         for (matrix_size_t column = 0UL; column < matrix2->columns; ++column) {
             matrix_data_t sum = 0.0F;
@@ -722,6 +1190,162 @@ matrix_err_t matrix_product(matrix_t const* matrix1,
             MATRIX_INDEX(product, row, column) = sum;
         }
     }
+#endif
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_product_transposed(matrix_t const* matrix1,
+                                       matrix_op_t op1,
+                                       matrix_t const* matrix2,
+                                       matrix_op_t op2,
+                                       matrix_t* product)
+{
+    if (matrix1 == NULL || matrix2 == NULL || product == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    if (product == matrix1 || product == matrix2) {
+        return MATRIX_ERR_FAIL;
+    }
+
+    matrix_size_t rows =
+        op1 == MATRIX_OP_TRANSPOSE ? matrix1->columns : matrix1->rows;
+    matrix_size_t common =
+        op1 == MATRIX_OP_TRANSPOSE ? matrix1->rows : matrix1->columns;
+    matrix_size_t columns =
+        op2 == MATRIX_OP_TRANSPOSE ? matrix2->rows : matrix2->columns;
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_product_transposed,
+        2UL * rows * common * columns,
+        sizeof(matrix_data_t) * (matrix1->rows * matrix1->columns +
+                                 matrix2->rows * matrix2->columns +
+                                 rows * columns));
+
+    if (common != (op2 == MATRIX_OP_TRANSPOSE ? matrix2->columns
+                                              : matrix2->rows)) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_err_t err = matrix_resize(product, rows, columns);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    if (op1 == MATRIX_OP_TRANSPOSE && op2 != MATRIX_OP_TRANSPOSE) {
+        // Rows of both operands are walked together and scattered into
+        // rows of the product, so every inner loop is contiguous.
+        for (matrix_size_t index = 0UL; index < rows * columns; ++index) {
+            product->data[index] = 0.0F;
+        }
+
+        for (matrix_size_t k = 0UL; k < common; ++k) {
+            for (matrix_size_t row = 0UL; row < rows; ++row) {
+                matrix_data_t factor = MATRIX_INDEX(matrix1, k, row);
+
+                for (matrix_size_t column = 0UL; column < columns; ++column) {
+                    MATRIX_INDEX(product, row, column) +=
+                        factor * MATRIX_INDEX(matrix2, k, column);
+                }
+            }
+        }
+
+        return MATRIX_ERR_OK;
+    }
+
+    // Otherwise a dot product per element, with the transposes expressed as
+    // strides. For A * B^T both strides along k are 1.
+    matrix_size_t row_stride =
+        op1 == MATRIX_OP_TRANSPOSE ? 1UL : matrix1->columns;
+    matrix_size_t k_stride1 =
+        op1 == MATRIX_OP_TRANSPOSE ? matrix1->columns : 1UL;
+    matrix_size_t column_stride =
+        op2 == MATRIX_OP_TRANSPOSE ? matrix2->columns : 1UL;
+    matrix_size_t k_stride2 =
+        op2 == MATRIX_OP_TRANSPOSE ? 1UL : matrix2->columns;
+
+    for (matrix_size_t row = 0UL; row < rows; ++row) {
+        for (matrix_size_t column = 0UL; column < columns; ++column) {
+            matrix_data_t const* data1 = &matrix1->data[row * row_stride];
+            matrix_data_t const* data2 =
+                &matrix2->data[column * column_stride];
+            matrix_data_t sum = 0.0F;
+
+            for (matrix_size_t k = 0UL; k < common; ++k) {
+                sum += data1[k * k_stride1] * data2[k * k_stride2];
+            }
+
+            MATRIX_INDEX(product, row, column) = sum;
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_gram(matrix_t const* matrix,
+                         matrix_op_t op,
+                         matrix_t* gram)
+{
+    if (matrix == NULL || gram == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    if (matrix == gram) {
+        return MATRIX_ERR_FAIL;
+    }
+
+    matrix_size_t size =
+        op == MATRIX_OP_TRANSPOSE ? matrix->columns : matrix->rows;
+    matrix_size_t common =
+        op == MATRIX_OP_TRANSPOSE ? matrix->rows : matrix->columns;
+
+    LINALG_PROFILE_FUNCTION(matrix_gram,
+                            size * (size + 1UL) * common,
+                            sizeof(matrix_data_t) *
+                                (matrix->rows * matrix->columns +
+                                 size * size));
+
+    matrix_err_t err = matrix_resize(gram, size, size);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    if (op == MATRIX_OP_TRANSPOSE) {
+        for (matrix_size_t index = 0UL; index < size * size; ++index) {
+            gram->data[index] = 0.0F;
+        }
+
+        for (matrix_size_t k = 0UL; k < common; ++k) {
+            for (matrix_size_t row = 0UL; row < size; ++row) {
+                matrix_data_t factor = MATRIX_INDEX(matrix, k, row);
+
+                for (matrix_size_t column = 0UL; column <= row; ++column) {
+                    MATRIX_INDEX(gram, row, column) +=
+                        factor * MATRIX_INDEX(matrix, k, column);
+                }
+            }
+        }
+    } else {
+        for (matrix_size_t row = 0UL; row < size; ++row) {
+            for (matrix_size_t column = 0UL; column <= row; ++column) {
+                matrix_data_t sum = 0.0F;
+
+                for (matrix_size_t k = 0UL; k < common; ++k) {
+                    sum += MATRIX_INDEX(matrix, row, k) *
+                           MATRIX_INDEX(matrix, column, k);
+                }
+
+                MATRIX_INDEX(gram, row, column) = sum;
+            }
+        }
+    }
+
+    for (matrix_size_t row = 0UL; row < size; ++row) {
+        for (matrix_size_t column = row + 1UL; column < size; ++column) {
+            MATRIX_INDEX(gram, row, column) = MATRIX_INDEX(gram, column, row);
+        }
+    }
 
     return MATRIX_ERR_OK;
 }
@@ -734,13 +1358,28 @@ matrix_err_t matrix_division(matrix_t const* matrix1,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_division, 0, 0);
+
     matrix_t matrix2_inverse;
-    matrix_err_t err = matrix_inverse(matrix2, &matrix2_inverse);
+    matrix_err_t err =
+        matrix_initialize(&matrix2_inverse, &division->allocator);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    err = matrix_inverse(matrix2, &matrix2_inverse);
+    if (err != MATRIX_ERR_OK) {
+        matrix_delete(&matrix2_inverse);
+        return err;
+    }
+
+    err = matrix_product(matrix1, &matrix2_inverse, division);
     if (err != MATRIX_ERR_OK) {
+        matrix_delete(&matrix2_inverse);
         return err;
     }
 
-    return matrix_product(matrix1, &matrix2_inverse, division);
+    return matrix_delete(&matrix2_inverse);
 }
 
 matrix_err_t matrix_power(matrix_t const* matrix,
@@ -751,12 +1390,17 @@ matrix_err_t matrix_power(matrix_t const* matrix,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_power,
+        2UL * exponent * matrix->rows * matrix->rows * matrix->rows,
+        0);
+
     if (matrix->rows != matrix->columns) {
         return MATRIX_ERR_DIMENSION;
     }
 
     matrix_err_t err =
-        matrix_create_with_zeros(power, matrix->rows, matrix->columns);
+        matrix_resize_with_zeros(power, matrix->rows, matrix->columns);
     if (err != MATRIX_ERR_OK) {
         return err;
     }
@@ -770,16 +1414,26 @@ matrix_err_t matrix_power(matrix_t const* matrix,
     }
 
     matrix_t temp;
-    for (matrix_size_t index = 0UL; index < exponent - 1UL; ++index) {
+    err = matrix_initialize(&temp, &power->allocator);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    for (matrix_size_t index = 0UL; index < exponent; ++index) {
         err = matrix_product(matrix, power, &temp);
         if (err != MATRIX_ERR_OK) {
+            matrix_delete(&temp);
             return err;
         }
 
-        *power = temp;
+        err = matrix_copy(&temp, power);
+        if (err != MATRIX_ERR_OK) {
+            matrix_delete(&temp);
+            return err;
+        }
     }
 
-    return MATRIX_ERR_OK;
+    return matrix_delete(&temp);
 }
 
 matrix_err_t matrix_trace(matrix_t const* matrix, matrix_data_t* trace)
@@ -788,14 +1442,26 @@ matrix_err_t matrix_trace(matrix_t const* matrix, matrix_data_t* trace)
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_trace,
+                            matrix->rows,
+                            sizeof(matrix_data_t) * matrix->rows);
+
     if (matrix->rows != matrix->columns) {
         return MATRIX_ERR_DIMENSION;
     }
 
+#ifdef LINALG_REDUCTION_DEFAULT_NAIVE
     *trace = 0.0F;
     for (matrix_size_t index = 0UL; index < matrix->rows; ++index) {
         *trace += MATRIX_INDEX(matrix, index, index);
     }
+#else
+    *trace = linalg_reduce_sum(LINALG_REDUCTION_DEFAULT,
+                               matrix->data,
+                               matrix->columns + 1UL,
+                               matrix->rows,
+                               1UL);
+#endif
 
     return MATRIX_ERR_OK;
 }
@@ -806,6 +1472,8 @@ matrix_err_t matrix_rank(matrix_t const* matrix, matrix_size_t* rank)
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_rank, 0, 0);
+
     matrix_t row_echelon_form;
     matrix_err_t err = matrix_initialize(&row_echelon_form, &matrix->allocator);
     if (err != MATRIX_ERR_OK) {
@@ -827,7 +1495,7 @@ matrix_err_t matrix_rank(matrix_t const* matrix, matrix_size_t* rank)
         }
     }
 
-    return MATRIX_ERR_OK;
+    return matrix_delete(&row_echelon_form);
 }
 
 matrix_err_t matrix_eigvals(matrix_t const* matrix,
@@ -838,6 +1506,8 @@ matrix_err_t matrix_eigvals(matrix_t const* matrix,
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix_eigvals, 0, 0);
+
     return MATRIX_ERR_OK;
 }
 
@@ -847,6 +1517,11 @@ matrix_err_t matrix_print(matrix_t const* matrix, char const* endline)
         return MATRIX_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(
+        matrix_print,
+        0,
+        sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
     for (matrix_size_t row = 0UL; row < matrix->rows; ++row) {
         printf("[ ");
 
@@ -19,8 +19,15 @@ typedef enum {
     MATRIX_ERR_SINGULAR,
     MATRIX_ERR_ALLOC,
     MATRIX_ERR_DIMENSION,
+    MATRIX_ERR_IO,
+    MATRIX_ERR_FORMAT,
 } matrix_err_t;
 
+typedef enum {
+    MATRIX_OP_NONE = 0,
+    MATRIX_OP_TRANSPOSE,
+} matrix_op_t;
+
 typedef float matrix_data_t;
 typedef size_t matrix_size_t;
 
@@ -94,8 +101,15 @@ matrix_err_t matrix_complement(matrix_t const* matrix, matrix_t* complement);
 
 matrix_err_t matrix_adjoint(matrix_t const* matrix, matrix_t* adjoint);
 
+// Cache-oblivious tiled transpose. transpose may be matrix, in which case
+// this is matrix_transpose_in_place.
 matrix_err_t matrix_transpose(matrix_t const* matrix, matrix_t* transpose);
 
+// Transposes without a second buffer. Square matrices are swapped block by
+// block; rectangular ones are permuted by cycle following, which allocates a
+// bitmap of one bit per element.
+matrix_err_t matrix_transpose_in_place(matrix_t* matrix);
+
 matrix_err_t matrix_det(matrix_t const* matrix, matrix_data_t* det);
 
 matrix_err_t matrix_inverse(matrix_t const* matrix, matrix_t* inverse);
@@ -125,6 +139,23 @@ matrix_err_t matrix_product(matrix_t const* matrix1,
                             matrix_t const* matrix2,
                             matrix_t* product);
 
+// product = op1(matrix1) * op2(matrix2). Transposed operands are read in
+// place rather than copied; product must not be either operand, which fails
+// with MATRIX_ERR_FAIL.
+matrix_err_t matrix_product_transposed(matrix_t const* matrix1,
+                                       matrix_op_t op1,
+                                       matrix_t const* matrix2,
+                                       matrix_op_t op2,
+                                       matrix_t* product);
+
+// Symmetric rank-k product: gram = matrix * matrix^T, or matrix^T * matrix
+// for MATRIX_OP_TRANSPOSE. Only the lower triangle is computed and then
+// mirrored, so the result is exactly symmetric. gram must not be matrix,
+// which fails with MATRIX_ERR_FAIL.
+matrix_err_t matrix_gram(matrix_t const* matrix,
+                         matrix_op_t op,
+                         matrix_t* gram);
+
 matrix_err_t matrix_division(matrix_t const* matrix1,
                              matrix_t const* matrix2,
                              matrix_t* division);
@@ -0,0 +1,35 @@
+#include "matrix2.h"
+#include <math.h>
+
+static inline matrix2_data_t matrix2_det_unchecked(matrix2_t const* matrix)
+{
+    return matrix->data[0U][0U] * matrix->data[1U][1U] -
+           matrix->data[0U][1U] * matrix->data[1U][0U];
+}
+
+static inline matrix2_err_t matrix2_inverse_unchecked(matrix2_t const* matrix,
+                                                      matrix2_t* inverse)
+{
+    matrix2_data_t det = matrix2_det_unchecked(matrix);
+
+    if (fabsf(det) < 1E-6F) {
+        return MATRIX2_ERR_SINGULAR;
+    }
+
+    matrix2_data_t det_inv = 1.0F / det;
+    matrix2_data_t a = matrix->data[0U][0U];
+    matrix2_data_t b = matrix->data[0U][1U];
+    matrix2_data_t c = matrix->data[1U][0U];
+    matrix2_data_t d = matrix->data[1U][1U];
+
+    inverse->data[0U][0U] = d * det_inv;
+    inverse->data[0U][1U] = -b * det_inv;
+    inverse->data[1U][0U] = -c * det_inv;
+    inverse->data[1U][1U] = a * det_inv;
+
+    return MATRIX2_ERR_OK;
+}
+
+#define LINALG_FIXED_N 2
+#include "linalg_fixed_impl.h"
+#undef LINALG_FIXED_N
@@ -0,0 +1,9 @@
+#ifndef LINALG_MATRIX2_H
+#define LINALG_MATRIX2_H
+
+// 2x2 matrices and 2-element vectors, see linalg_fixed.h.
+#define LINALG_FIXED_N 2
+#include "linalg_fixed_decl.h"
+#undef LINALG_FIXED_N
+
+#endif // LINALG_MATRIX2_H
@@ -1,4 +1,5 @@
 #include "matrix3.h"
+#include "linalg_profile.h"
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
@@ -9,6 +10,8 @@ matrix3_err_t matrix3_fill_with_zeros(matrix3_t* matrix)
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_fill_with_zeros, 0, 36UL);
+
     memset(matrix->data, 0, sizeof(matrix->data));
 
     return MATRIX3_ERR_OK;
@@ -21,6 +24,8 @@ matrix3_err_t matrix3_fill_with_array(matrix3_t* matrix,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_fill_with_array, 0, 72UL);
+
     for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
         for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
             matrix->data[row][column] = (*array)[row][column];
@@ -36,6 +41,8 @@ matrix3_err_t matrix3_transpose(matrix3_t const* matrix, matrix3_t* transpose)
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_transpose, 0, 72UL);
+
     for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
         for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
             transpose->data[column][row] = matrix->data[row][column];
@@ -59,6 +66,8 @@ matrix3_err_t matrix3_det(matrix3_t const* matrix, matrix3_data_t* det)
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_det, 14UL, 40UL);
+
     matrix3_data_t a = matrix->data[0U][0U];
     matrix3_data_t b = matrix->data[0U][1U];
     matrix3_data_t c = matrix->data[0U][2U];
@@ -83,38 +92,99 @@ matrix3_err_t matrix3_det(matrix3_t const* matrix, matrix3_data_t* det)
     return MATRIX3_ERR_OK;
 }
 
+static inline void matrix3_cofactors(matrix3_t const* matrix,
+                                     matrix3_t* cofactors)
+{
+    matrix3_data_t const (*m)[3U] = matrix->data;
+
+    cofactors->data[0U][0U] =
+        matrix3_det_2x2(m[1U][1U], m[1U][2U], m[2U][1U], m[2U][2U]);
+    cofactors->data[0U][1U] =
+        matrix3_det_2x2(m[1U][2U], m[1U][0U], m[2U][2U], m[2U][0U]);
+    cofactors->data[0U][2U] =
+        matrix3_det_2x2(m[1U][0U], m[1U][1U], m[2U][0U], m[2U][1U]);
+
+    cofactors->data[1U][0U] =
+        matrix3_det_2x2(m[0U][2U], m[0U][1U], m[2U][2U], m[2U][1U]);
+    cofactors->data[1U][1U] =
+        matrix3_det_2x2(m[0U][0U], m[0U][2U], m[2U][0U], m[2U][2U]);
+    cofactors->data[1U][2U] =
+        matrix3_det_2x2(m[0U][1U], m[0U][0U], m[2U][1U], m[2U][0U]);
+
+    cofactors->data[2U][0U] =
+        matrix3_det_2x2(m[0U][1U], m[0U][2U], m[1U][1U], m[1U][2U]);
+    cofactors->data[2U][1U] =
+        matrix3_det_2x2(m[0U][2U], m[0U][0U], m[1U][2U], m[1U][0U]);
+    cofactors->data[2U][2U] =
+        matrix3_det_2x2(m[0U][0U], m[0U][1U], m[1U][0U], m[1U][1U]);
+}
+
+static inline matrix3_err_t matrix3_inverse_unchecked(matrix3_t const* matrix,
+                                                      matrix3_t* inverse)
+{
+    matrix3_t cofactors;
+    matrix3_cofactors(matrix, &cofactors);
+
+    matrix3_data_t det = matrix->data[0U][0U] * cofactors.data[0U][0U] +
+                         matrix->data[0U][1U] * cofactors.data[0U][1U] +
+                         matrix->data[0U][2U] * cofactors.data[0U][2U];
+
+    if (fabsf(det) < 1E-6F) {
+        return MATRIX3_ERR_SINGULAR;
+    }
+
+    matrix3_data_t det_inv = 1.0F / det;
+
+    for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
+        for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
+            inverse->data[row][column] = cofactors.data[column][row] * det_inv;
+        }
+    }
+
+    return MATRIX3_ERR_OK;
+}
+
 matrix3_err_t matrix3_inverse(matrix3_t const* matrix, matrix3_t* inverse)
 {
     if (matrix == NULL || inverse == NULL) {
         return MATRIX3_ERR_NULL;
     }
 
-    matrix3_data_t det;
-    matrix3_err_t err = matrix3_det(matrix, &det);
-    if (err != MATRIX3_ERR_OK) {
-        return MATRIX3_ERR_FAIL;
-    }
+    LINALG_PROFILE_FUNCTION(matrix3_inverse, 42UL, 72UL);
 
-    if (det == 0.0F) {
-        return MATRIX3_ERR_FAIL;
-    }
+    return matrix3_inverse_unchecked(matrix, inverse);
+}
 
-    matrix3_t adjoint;
-    err = matrix3_adjoint(matrix, &adjoint);
-    if (err != MATRIX3_ERR_OK) {
-        return MATRIX3_ERR_FAIL;
+matrix3_err_t matrix3_inverse_batch(matrix3_t const* matrices,
+                                    matrix3_t* inverses,
+                                    matrix3_size_t count,
+                                    matrix3_size_t* first_singular)
+{
+    if (matrices == NULL || inverses == NULL) {
+        return MATRIX3_ERR_NULL;
     }
 
-    if (fabsf(det) < 1E-6F) {
-        return MATRIX3_ERR_SINGULAR;
-    }
+    LINALG_PROFILE_FUNCTION(matrix3_inverse_batch, 42UL * count, 72UL * count);
 
-    err = matrix3_scale(&adjoint, 1.0F / det, inverse);
-    if (err != MATRIX3_ERR_OK) {
-        return MATRIX3_ERR_FAIL;
+    matrix3_err_t result = MATRIX3_ERR_OK;
+
+    // The singularity check branches per matrix. Masking it out, so that a
+    // singular matrix blends its old output back in, measured 1.5-2x slower
+    // because real batches are almost never singular and the branch is
+    // always predicted.
+    for (matrix3_size_t index = 0UL; index < count; ++index) {
+        matrix3_err_t err =
+            matrix3_inverse_unchecked(&matrices[index], &inverses[index]);
+        if (err != MATRIX3_ERR_OK && result == MATRIX3_ERR_OK) {
+            result = err;
+
+            if (first_singular != NULL) {
+                *first_singular = index;
+            }
+        }
     }
 
-    return MATRIX3_ERR_OK;
+    return result;
 }
 
 matrix3_err_t matrix3_minor(matrix3_t const* matrix,
@@ -126,6 +196,8 @@ matrix3_err_t matrix3_minor(matrix3_t const* matrix,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_minor, 0, 52UL);
+
     for (matrix3_size_t row = 0U, cof_row = 0UL; row < 3UL; ++row) {
         if (row == minor_row) {
             continue;
@@ -154,24 +226,12 @@ matrix3_err_t matrix3_complement(matrix3_t const* matrix, matrix3_t* complement)
         return MATRIX3_ERR_NULL;
     }
 
-    for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
-        for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
-            matrix3_t minor;
+    LINALG_PROFILE_FUNCTION(matrix3_complement, 27UL, 72UL);
 
-            matrix3_err_t minor_result =
-                matrix3_minor(matrix, row, column, &minor);
+    matrix3_t cofactors;
+    matrix3_cofactors(matrix, &cofactors);
 
-            if (minor_result != MATRIX3_ERR_OK) {
-                return MATRIX3_ERR_FAIL;
-            }
-
-            matrix3_data_t minor_det = minor.data[0U][0U] * minor.data[1U][1U] -
-                                       minor.data[0U][1U] * minor.data[1U][0U];
-
-            complement->data[row][column] =
-                (((row + column) & 1U) ? -1.0F : 1.0F) * minor_det;
-        }
-    }
+    *complement = cofactors;
 
     return MATRIX3_ERR_OK;
 }
@@ -182,15 +242,15 @@ matrix3_err_t matrix3_adjoint(matrix3_t const* matrix, matrix3_t* adjoint)
         return MATRIX3_ERR_NULL;
     }
 
-    matrix3_t complement;
-    matrix3_err_t err = matrix3_complement(matrix, &complement);
-    if (err != MATRIX3_ERR_OK) {
-        return MATRIX3_ERR_FAIL;
-    }
+    LINALG_PROFILE_FUNCTION(matrix3_adjoint, 27UL, 72UL);
 
-    err = matrix3_transpose(&complement, adjoint);
-    if (err != MATRIX3_ERR_OK) {
-        return MATRIX3_ERR_FAIL;
+    matrix3_t cofactors;
+    matrix3_cofactors(matrix, &cofactors);
+
+    for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
+        for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
+            adjoint->data[row][column] = cofactors.data[column][row];
+        }
     }
 
     return MATRIX3_ERR_OK;
@@ -203,6 +263,8 @@ matrix3_err_t matrix3_upper_triangular(matrix3_t const* matrix,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_upper_triangular, 14UL, 72UL);
+
     matrix3_t lower_triangular;
     matrix3_err_t err = matrix3_lower_triangular(matrix, &lower_triangular);
     if (err != MATRIX3_ERR_OK) {
@@ -219,6 +281,8 @@ matrix3_err_t matrix3_lower_triangular(matrix3_t const* matrix,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_lower_triangular, 14UL, 72UL);
+
     for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
         for (matrix3_size_t column = 0UL; column <= row; ++column) {
             matrix3_data_t sum = 0.0F;
@@ -257,6 +321,8 @@ matrix3_err_t matrix3_row_echelon_form(matrix3_t const* matrix,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_row_echelon_form, 11UL, 72UL);
+
     *row_echelon_form = *matrix;
 
     for (matrix3_size_t pivot = 0UL; pivot < 3UL; ++pivot) {
@@ -302,6 +368,8 @@ matrix3_err_t matrix3_sum(matrix3_t const* matrix1,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_sum, 9UL, 108UL);
+
     for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
         for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
             sum->data[row][column] =
@@ -320,6 +388,8 @@ matrix3_err_t matrix3_difference(matrix3_t const* matrix1,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_difference, 9UL, 108UL);
+
     for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
         for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
             difference->data[row][column] =
@@ -338,6 +408,8 @@ matrix3_err_t matrix3_scale(matrix3_t const* matrix,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_scale, 9UL, 72UL);
+
     for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
         for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
             scale->data[row][column] = matrix->data[row][column] * scalar;
@@ -355,6 +427,8 @@ matrix3_err_t matrix3_product(matrix3_t const* matrix1,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_product, 45UL, 108UL);
+
     for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
         for (matrix3_size_t column = 0UL; column < 3UL; ++column) {
             product->data[row][column] = 0.0f;
@@ -377,6 +451,8 @@ matrix3_err_t matrix3_division(matrix3_t const* matrix1,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_division, 87UL, 108UL);
+
     matrix3_t matrix2_inverse;
     matrix3_err_t err = matrix3_inverse(matrix1, &matrix2_inverse);
     if (err != MATRIX3_ERR_OK) {
@@ -394,6 +470,8 @@ matrix3_err_t matrix3_power(matrix3_t const* matrix,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_power, 45UL * exponent, 72UL);
+
     matrix3_err_t err = matrix3_fill_with_zeros(power);
     if (err != MATRIX3_ERR_OK) {
         return err;
@@ -426,6 +504,8 @@ matrix3_err_t matrix3_trace(matrix3_t const* matrix, matrix3_data_t* trace)
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_trace, 3UL, 16UL);
+
     *trace = 0.0F;
     for (matrix3_size_t index = 0UL; index < 3UL; ++index) {
         *trace += matrix->data[index][index];
@@ -440,6 +520,8 @@ matrix3_err_t matrix3_rank(matrix3_t const* matrix, matrix3_size_t* rank)
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_rank, 11UL, 40UL);
+
     matrix3_t row_echelon_form;
     matrix3_err_t err = matrix3_row_echelon_form(matrix, &row_echelon_form);
     if (err != MATRIX3_ERR_OK) {
@@ -466,6 +548,8 @@ matrix3_err_t matrix3_eigvals(matrix3_t const* matrix,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_eigvals, 0, 0);
+
     return MATRIX3_ERR_OK;
 }
 
@@ -477,6 +561,8 @@ matrix3_err_t matrix3_vector_product(matrix3_t const* matrix,
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_vector_product, 15UL, 60UL);
+
     for (matrix3_size_t row = 0U; row < 3U; ++row) {
         product->data[row] = 0.0F;
         for (matrix3_size_t column = 0U; column < 3U; ++column) {
@@ -494,6 +580,8 @@ matrix3_err_t matrix3_print(matrix3_t const* matrix, char const* endline)
         return MATRIX3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(matrix3_print, 0, 36UL);
+
     for (matrix3_size_t row = 0UL; row < 3UL; ++row) {
         printf("[ ");
 
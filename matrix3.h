@@ -46,6 +46,14 @@ matrix3_err_t matrix3_det(matrix3_t const* matrix, matrix3_data_t* det);
 
 matrix3_err_t matrix3_inverse(matrix3_t const* matrix, matrix3_t* inverse);
 
+// Inverts every matrix, even past a singular one, whose inverse is left
+// unwritten. Returns MATRIX3_ERR_SINGULAR if any matrix was singular and
+// stores the index of the first in first_singular unless it is NULL.
+matrix3_err_t matrix3_inverse_batch(matrix3_t const* matrices,
+                                    matrix3_t* inverses,
+                                    matrix3_size_t count,
+                                    matrix3_size_t* first_singular);
+
 matrix3_err_t matrix3_upper_triangular(matrix3_t const* matrix,
                                        matrix3_t* upper_triangular);
 
@@ -0,0 +1,97 @@
+#include "matrix4.h"
+#include <math.h>
+
+// Determinants of the 2x2 minors in the top two rows (s) and the bottom two
+// rows (c); the Laplace expansion along those row pairs gives both the
+// determinant and every cofactor.
+typedef struct {
+    matrix4_data_t s[6U];
+    matrix4_data_t c[6U];
+} matrix4_minors_t;
+
+static inline matrix4_minors_t matrix4_minors(matrix4_t const* matrix)
+{
+    matrix4_data_t const (*m)[4U] = matrix->data;
+    matrix4_minors_t minors;
+
+    minors.s[0U] = m[0U][0U] * m[1U][1U] - m[1U][0U] * m[0U][1U];
+    minors.s[1U] = m[0U][0U] * m[1U][2U] - m[1U][0U] * m[0U][2U];
+    minors.s[2U] = m[0U][0U] * m[1U][3U] - m[1U][0U] * m[0U][3U];
+    minors.s[3U] = m[0U][1U] * m[1U][2U] - m[1U][1U] * m[0U][2U];
+    minors.s[4U] = m[0U][1U] * m[1U][3U] - m[1U][1U] * m[0U][3U];
+    minors.s[5U] = m[0U][2U] * m[1U][3U] - m[1U][2U] * m[0U][3U];
+
+    minors.c[0U] = m[2U][0U] * m[3U][1U] - m[3U][0U] * m[2U][1U];
+    minors.c[1U] = m[2U][0U] * m[3U][2U] - m[3U][0U] * m[2U][2U];
+    minors.c[2U] = m[2U][0U] * m[3U][3U] - m[3U][0U] * m[2U][3U];
+    minors.c[3U] = m[2U][1U] * m[3U][2U] - m[3U][1U] * m[2U][2U];
+    minors.c[4U] = m[2U][1U] * m[3U][3U] - m[3U][1U] * m[2U][3U];
+    minors.c[5U] = m[2U][2U] * m[3U][3U] - m[3U][2U] * m[2U][3U];
+
+    return minors;
+}
+
+static inline matrix4_data_t matrix4_minors_det(matrix4_minors_t const* minors)
+{
+    matrix4_data_t const* s = minors->s;
+    matrix4_data_t const* c = minors->c;
+
+    return s[0U] * c[5U] - s[1U] * c[4U] + s[2U] * c[3U] + s[3U] * c[2U] -
+           s[4U] * c[1U] + s[5U] * c[0U];
+}
+
+static inline matrix4_data_t matrix4_det_unchecked(matrix4_t const* matrix)
+{
+    matrix4_minors_t minors = matrix4_minors(matrix);
+
+    return matrix4_minors_det(&minors);
+}
+
+static inline matrix4_err_t matrix4_inverse_unchecked(matrix4_t const* matrix,
+                                                      matrix4_t* inverse)
+{
+    matrix4_minors_t minors = matrix4_minors(matrix);
+    matrix4_data_t det = matrix4_minors_det(&minors);
+
+    if (fabsf(det) < 1E-6F) {
+        return MATRIX4_ERR_SINGULAR;
+    }
+
+    matrix4_data_t const (*m)[4U] = matrix->data;
+    matrix4_data_t const* s = minors.s;
+    matrix4_data_t const* c = minors.c;
+    matrix4_data_t det_inv = 1.0F / det;
+    matrix4_data_t (*r)[4U] = inverse->data;
+
+    r[0U][0U] = m[1U][1U] * c[5U] - m[1U][2U] * c[4U] + m[1U][3U] * c[3U];
+    r[0U][1U] = -m[0U][1U] * c[5U] + m[0U][2U] * c[4U] - m[0U][3U] * c[3U];
+    r[0U][2U] = m[3U][1U] * s[5U] - m[3U][2U] * s[4U] + m[3U][3U] * s[3U];
+    r[0U][3U] = -m[2U][1U] * s[5U] + m[2U][2U] * s[4U] - m[2U][3U] * s[3U];
+
+    r[1U][0U] = -m[1U][0U] * c[5U] + m[1U][2U] * c[2U] - m[1U][3U] * c[1U];
+    r[1U][1U] = m[0U][0U] * c[5U] - m[0U][2U] * c[2U] + m[0U][3U] * c[1U];
+    r[1U][2U] = -m[3U][0U] * s[5U] + m[3U][2U] * s[2U] - m[3U][3U] * s[1U];
+    r[1U][3U] = m[2U][0U] * s[5U] - m[2U][2U] * s[2U] + m[2U][3U] * s[1U];
+
+    r[2U][0U] = m[1U][0U] * c[4U] - m[1U][1U] * c[2U] + m[1U][3U] * c[0U];
+    r[2U][1U] = -m[0U][0U] * c[4U] + m[0U][1U] * c[2U] - m[0U][3U] * c[0U];
+    r[2U][2U] = m[3U][0U] * s[4U] - m[3U][1U] * s[2U] + m[3U][3U] * s[0U];
+    r[2U][3U] = -m[2U][0U] * s[4U] + m[2U][1U] * s[2U] - m[2U][3U] * s[0U];
+
+    r[3U][0U] = -m[1U][0U] * c[3U] + m[1U][1U] * c[1U] - m[1U][2U] * c[0U];
+    r[3U][1U] = m[0U][0U] * c[3U] - m[0U][1U] * c[1U] + m[0U][2U] * c[0U];
+    r[3U][2U] = -m[3U][0U] * s[3U] + m[3U][1U] * s[1U] - m[3U][2U] * s[0U];
+    r[3U][3U] = m[2U][0U] * s[3U] - m[2U][1U] * s[1U] + m[2U][2U] * s[0U];
+
+    for (matrix4_size_t row = 0UL; row < 4UL; ++row) {
+        for (matrix4_size_t column = 0UL; column < 4UL; ++column) {
+            r[row][column] *= det_inv;
+        }
+    }
+
+    return MATRIX4_ERR_OK;
+}
+
+#define LINALG_FIXED_N 4
+#include "linalg_fixed_impl.h"
+#undef LINALG_FIXED_N
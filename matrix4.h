@@ -0,0 +1,9 @@
+#ifndef LINALG_MATRIX4_H
+#define LINALG_MATRIX4_H
+
+// 4x4 matrices and 4-element vectors, see linalg_fixed.h.
+#define LINALG_FIXED_N 4
+#include "linalg_fixed_decl.h"
+#undef LINALG_FIXED_N
+
+#endif // LINALG_MATRIX4_H
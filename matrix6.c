@@ -0,0 +1,5 @@
+#include "matrix6.h"
+
+#define LINALG_FIXED_N 6
+#include "linalg_fixed_impl.h"
+#undef LINALG_FIXED_N
@@ -0,0 +1,9 @@
+#ifndef LINALG_MATRIX6_H
+#define LINALG_MATRIX6_H
+
+// 6x6 matrices and 6-element vectors, see linalg_fixed.h.
+#define LINALG_FIXED_N 6
+#include "linalg_fixed_decl.h"
+#undef LINALG_FIXED_N
+
+#endif // LINALG_MATRIX6_H
@@ -0,0 +1,5 @@
+#include "matrix9.h"
+
+#define LINALG_FIXED_N 9
+#include "linalg_fixed_impl.h"
+#undef LINALG_FIXED_N
@@ -0,0 +1,9 @@
+#ifndef LINALG_MATRIX9_H
+#define LINALG_MATRIX9_H
+
+// 9x9 matrices and 9-element vectors, see linalg_fixed.h.
+#define LINALG_FIXED_N 9
+#include "linalg_fixed_decl.h"
+#undef LINALG_FIXED_N
+
+#endif // LINALG_MATRIX9_H
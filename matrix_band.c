@@ -0,0 +1,542 @@
+#include "matrix_band.h"
+#include "linalg_profile.h"
+#include <stdbool.h>
+#include <string.h>
+
+static inline matrix_size_t matrix_band_width(matrix_band_t const* band)
+{
+    return band->lower + band->upper + 1UL;
+}
+
+// First column of the band in row.
+static inline matrix_size_t matrix_band_begin(matrix_band_t const* band,
+                                              matrix_size_t row)
+{
+    return row > band->lower ? row - band->lower : 0UL;
+}
+
+// One past the last column of the band in row.
+static inline matrix_size_t matrix_band_end(matrix_band_t const* band,
+                                            matrix_size_t row)
+{
+    return row + band->upper + 1UL < band->size ? row + band->upper + 1UL
+                                                : band->size;
+}
+
+static matrix_err_t matrix_band_resize(matrix_band_t* band,
+                                       matrix_size_t size,
+                                       matrix_size_t lower,
+                                       matrix_size_t upper)
+{
+    if (band->data == NULL || band->size != size || band->lower != lower ||
+        band->upper != upper) {
+        if (band->allocator.allocate == NULL) {
+            return MATRIX_ERR_ALLOC;
+        }
+
+        matrix_data_t* data = band->allocator.allocate(
+            band->allocator.user,
+            sizeof(matrix_data_t) * size * (lower + upper + 1UL));
+        if (data == NULL) {
+            return MATRIX_ERR_ALLOC;
+        }
+
+        if (band->data != NULL && band->allocator.deallocate != NULL) {
+            band->allocator.deallocate(band->allocator.user, band->data);
+        }
+
+        band->data = data;
+        band->size = size;
+        band->lower = lower;
+        band->upper = upper;
+    }
+
+    memset(band->data,
+           0,
+           sizeof(matrix_data_t) * size * (lower + upper + 1UL));
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_band_initialize(matrix_band_t* band,
+                                    matrix_allocator_t const* allocator)
+{
+    if (band == NULL || allocator == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_band_initialize, 0, 0);
+
+    memset(band, 0, sizeof(*band));
+    band->allocator = *allocator;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_band_create(matrix_band_t* band,
+                                matrix_size_t size,
+                                matrix_size_t lower,
+                                matrix_size_t upper)
+{
+    if (band == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_band_create,
+        0,
+        sizeof(matrix_data_t) * size * (lower + upper + 1UL));
+
+    band->data = NULL;
+
+    return matrix_band_resize(band, size, lower, upper);
+}
+
+matrix_err_t matrix_band_delete(matrix_band_t* band)
+{
+    if (band == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_band_delete, 0, 0);
+
+    if (band->data != NULL && band->allocator.deallocate != NULL) {
+        band->allocator.deallocate(band->allocator.user, band->data);
+    }
+
+    band->data = NULL;
+    band->size = 0UL;
+    band->lower = 0UL;
+    band->upper = 0UL;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_band_from_matrix(matrix_t const* matrix,
+                                     matrix_size_t lower,
+                                     matrix_size_t upper,
+                                     matrix_band_t* band)
+{
+    if (matrix == NULL || band == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_band_from_matrix,
+        0,
+        2UL * sizeof(matrix_data_t) * matrix->rows * (lower + upper + 1UL));
+
+    if (matrix->rows != matrix->columns) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_err_t err = matrix_band_resize(band, matrix->rows, lower, upper);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    for (matrix_size_t row = 0UL; row < band->size; ++row) {
+        for (matrix_size_t column = matrix_band_begin(band, row);
+             column < matrix_band_end(band, row);
+             ++column) {
+            MATRIX_BAND_INDEX(band, row, column) =
+                MATRIX_INDEX(matrix, row, column);
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_band_to_matrix(matrix_band_t const* band,
+                                   matrix_t* matrix)
+{
+    if (band == NULL || matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_band_to_matrix,
+                            0,
+                            sizeof(matrix_data_t) * band->size *
+                                (band->size + matrix_band_width(band)));
+
+    matrix_err_t err = matrix_resize_with_zeros(matrix, band->size, band->size);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    for (matrix_size_t row = 0UL; row < band->size; ++row) {
+        for (matrix_size_t column = matrix_band_begin(band, row);
+             column < matrix_band_end(band, row);
+             ++column) {
+            MATRIX_INDEX(matrix, row, column) =
+                MATRIX_BAND_INDEX(band, row, column);
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_band_product(matrix_band_t const* band,
+                                 matrix_t const* matrix,
+                                 matrix_t* product)
+{
+    if (band == NULL || matrix == NULL || product == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    if (product == matrix) {
+        return MATRIX_ERR_FAIL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_band_product,
+        2UL * band->size * matrix_band_width(band) * matrix->columns,
+        sizeof(matrix_data_t) * band->size *
+            (matrix_band_width(band) + 2UL * matrix->columns));
+
+    if (band->size != matrix->rows) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_err_t err = matrix_resize(product, matrix->rows, matrix->columns);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    matrix_size_t columns = matrix->columns;
+
+    for (matrix_size_t row = 0UL; row < band->size; ++row) {
+        matrix_data_t* product_row = &MATRIX_INDEX(product, row, 0UL);
+
+        memset(product_row, 0, sizeof(matrix_data_t) * columns);
+
+        for (matrix_size_t k = matrix_band_begin(band, row);
+             k < matrix_band_end(band, row);
+             ++k) {
+            matrix_data_t value = MATRIX_BAND_INDEX(band, row, k);
+            matrix_data_t const* matrix_row = &MATRIX_INDEX(matrix, k, 0UL);
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                product_row[column] += value * matrix_row[column];
+            }
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_band_lu(matrix_band_t* band)
+{
+    if (band == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_band_lu,
+        2UL * band->size * band->lower * band->upper,
+        2UL * sizeof(matrix_data_t) * band->size * matrix_band_width(band));
+
+    for (matrix_size_t k = 0UL; k < band->size; ++k) {
+        matrix_data_t pivot = MATRIX_BAND_INDEX(band, k, k);
+        if (pivot == 0.0F) {
+            return MATRIX_ERR_SINGULAR;
+        }
+
+        matrix_size_t end = matrix_band_end(band, k);
+        matrix_size_t last_row =
+            k + band->lower < band->size ? k + band->lower + 1UL : band->size;
+
+        for (matrix_size_t row = k + 1UL; row < last_row; ++row) {
+            matrix_data_t multiplier = MATRIX_BAND_INDEX(band, row, k) / pivot;
+            MATRIX_BAND_INDEX(band, row, k) = multiplier;
+
+            // Without pivoting row k never reaches past column k + upper,
+            // which is inside the band of every row below it.
+            for (matrix_size_t column = k + 1UL; column < end; ++column) {
+                MATRIX_BAND_INDEX(band, row, column) -=
+                    multiplier * MATRIX_BAND_INDEX(band, k, column);
+            }
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_band_lu_solve(matrix_band_t const* band, matrix_t* matrix)
+{
+    if (band == NULL || matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_band_lu_solve,
+        2UL * band->size * matrix_band_width(band) * matrix->columns,
+        sizeof(matrix_data_t) * band->size *
+            (matrix_band_width(band) + 2UL * matrix->columns));
+
+    if (band->size != matrix->rows) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_size_t columns = matrix->columns;
+
+    for (matrix_size_t row = 0UL; row < band->size; ++row) {
+        matrix_data_t* solution_row = &MATRIX_INDEX(matrix, row, 0UL);
+
+        for (matrix_size_t k = matrix_band_begin(band, row); k < row; ++k) {
+            matrix_data_t value = MATRIX_BAND_INDEX(band, row, k);
+            matrix_data_t const* source_row = &MATRIX_INDEX(matrix, k, 0UL);
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                solution_row[column] -= value * source_row[column];
+            }
+        }
+    }
+
+    for (matrix_size_t row = band->size; row-- > 0UL;) {
+        matrix_data_t* solution_row = &MATRIX_INDEX(matrix, row, 0UL);
+
+        for (matrix_size_t k = row + 1UL; k < matrix_band_end(band, row);
+             ++k) {
+            matrix_data_t value = MATRIX_BAND_INDEX(band, row, k);
+            matrix_data_t const* source_row = &MATRIX_INDEX(matrix, k, 0UL);
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                solution_row[column] -= value * source_row[column];
+            }
+        }
+
+        matrix_data_t inverse = 1.0F / MATRIX_BAND_INDEX(band, row, row);
+        for (matrix_size_t column = 0UL; column < columns; ++column) {
+            solution_row[column] *= inverse;
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_band_cholesky(matrix_band_t* band)
+{
+    if (band == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_band_cholesky,
+        band->size * band->lower * band->lower,
+        2UL * sizeof(matrix_data_t) * band->size * (band->lower + 1UL));
+
+    if (band->lower != band->upper) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    for (matrix_size_t row = 0UL; row < band->size; ++row) {
+        matrix_size_t begin = matrix_band_begin(band, row);
+
+        for (matrix_size_t column = begin; column <= row; ++column) {
+            matrix_data_t sum = MATRIX_BAND_INDEX(band, row, column);
+
+            // Row column of L starts at or before begin, so the overlap of
+            // the two rows is [begin, column).
+            for (matrix_size_t k = begin; k < column; ++k) {
+                sum -= MATRIX_BAND_INDEX(band, row, k) *
+                       MATRIX_BAND_INDEX(band, column, k);
+            }
+
+            if (column < row) {
+                MATRIX_BAND_INDEX(band, row, column) =
+                    sum / MATRIX_BAND_INDEX(band, column, column);
+            } else if (sum > 0.0F) {
+                MATRIX_BAND_INDEX(band, row, column) = sqrtf(sum);
+            } else {
+                return MATRIX_ERR_SINGULAR;
+            }
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_band_cholesky_solve(matrix_band_t const* band,
+                                        matrix_t* matrix)
+{
+    if (band == NULL || matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_band_cholesky_solve,
+        4UL * band->size * (band->lower + 1UL) * matrix->columns,
+        sizeof(matrix_data_t) * band->size *
+            (band->lower + 1UL + 2UL * matrix->columns));
+
+    if (band->size != matrix->rows) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_size_t columns = matrix->columns;
+
+    for (matrix_size_t row = 0UL; row < band->size; ++row) {
+        matrix_data_t* solution_row = &MATRIX_INDEX(matrix, row, 0UL);
+
+        for (matrix_size_t k = matrix_band_begin(band, row); k < row; ++k) {
+            matrix_data_t value = MATRIX_BAND_INDEX(band, row, k);
+            matrix_data_t const* source_row = &MATRIX_INDEX(matrix, k, 0UL);
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                solution_row[column] -= value * source_row[column];
+            }
+        }
+
+        matrix_data_t inverse = 1.0F / MATRIX_BAND_INDEX(band, row, row);
+        for (matrix_size_t column = 0UL; column < columns; ++column) {
+            solution_row[column] *= inverse;
+        }
+    }
+
+    // L^T X = Y: each finished row is eliminated from the rows above it
+    // through row row of L, which is column row of L^T.
+    for (matrix_size_t row = band->size; row-- > 0UL;) {
+        matrix_data_t* solution_row = &MATRIX_INDEX(matrix, row, 0UL);
+
+        matrix_data_t inverse = 1.0F / MATRIX_BAND_INDEX(band, row, row);
+        for (matrix_size_t column = 0UL; column < columns; ++column) {
+            solution_row[column] *= inverse;
+        }
+
+        for (matrix_size_t k = matrix_band_begin(band, row); k < row; ++k) {
+            matrix_data_t value = MATRIX_BAND_INDEX(band, row, k);
+            matrix_data_t* target_row = &MATRIX_INDEX(matrix, k, 0UL);
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                target_row[column] -= value * solution_row[column];
+            }
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_tridiagonal_solve(matrix_size_t size,
+                                      matrix_data_t const* lower,
+                                      matrix_data_t const* diagonal,
+                                      matrix_data_t const* upper,
+                                      matrix_data_t* rhs,
+                                      matrix_data_t* scratch)
+{
+    if (lower == NULL || diagonal == NULL || upper == NULL || rhs == NULL ||
+        scratch == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_tridiagonal_solve,
+                            8UL * size,
+                            6UL * sizeof(matrix_data_t) * size);
+
+    if (size == 0UL) {
+        return MATRIX_ERR_OK;
+    }
+
+    // scratch[i] is the upper element of row i after elimination, with the
+    // row scaled to a unit diagonal.
+    matrix_data_t previous = 0.0F;
+    matrix_data_t solution = 0.0F;
+
+    for (matrix_size_t row = 0UL; row < size; ++row) {
+        matrix_data_t factor = row > 0UL ? lower[row] : 0.0F;
+        matrix_data_t pivot = diagonal[row] - factor * previous;
+        if (pivot == 0.0F) {
+            return MATRIX_ERR_SINGULAR;
+        }
+
+        matrix_data_t inverse = 1.0F / pivot;
+        previous = row + 1UL < size ? upper[row] * inverse : 0.0F;
+        solution = (rhs[row] - factor * solution) * inverse;
+
+        scratch[row] = previous;
+        rhs[row] = solution;
+    }
+
+    for (matrix_size_t row = size - 1UL; row-- > 0UL;) {
+        rhs[row] -= scratch[row] * rhs[row + 1UL];
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_tridiagonal_solve_batch(matrix_size_t size,
+                                            matrix_size_t count,
+                                            matrix_data_t const* lower,
+                                            matrix_data_t const* diagonal,
+                                            matrix_data_t const* upper,
+                                            matrix_data_t* rhs,
+                                            matrix_data_t* scratch)
+{
+    if (lower == NULL || diagonal == NULL || upper == NULL || rhs == NULL ||
+        scratch == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_tridiagonal_solve_batch,
+                            8UL * size * count,
+                            6UL * sizeof(matrix_data_t) * size * count);
+
+    if (size == 0UL) {
+        return MATRIX_ERR_OK;
+    }
+
+    matrix_size_t zero_pivots = 0UL;
+
+    // The first row has no lower element, so it only scales.
+    for (matrix_size_t system = 0UL; system < count; ++system) {
+        matrix_data_t pivot = diagonal[system];
+        zero_pivots += pivot == 0.0F ? 1UL : 0UL;
+
+        matrix_data_t inverse = 1.0F / pivot;
+        scratch[system] = size > 1UL ? upper[system] * inverse : 0.0F;
+        rhs[system] *= inverse;
+    }
+
+    for (matrix_size_t row = 1UL; row < size; ++row) {
+        matrix_size_t offset = row * count;
+        matrix_data_t const* lower_row = &lower[offset];
+        matrix_data_t const* diagonal_row = &diagonal[offset];
+        matrix_data_t const* upper_row = &upper[offset];
+        matrix_data_t* rhs_row = &rhs[offset];
+        matrix_data_t* scratch_row = &scratch[offset];
+        matrix_data_t const* previous_rhs = &rhs[offset - count];
+        matrix_data_t const* previous_scratch = &scratch[offset - count];
+        bool last = row + 1UL == size;
+
+        for (matrix_size_t system = 0UL; system < count; ++system) {
+            matrix_data_t pivot = diagonal_row[system] -
+                                  lower_row[system] * previous_scratch[system];
+            zero_pivots += pivot == 0.0F ? 1UL : 0UL;
+
+            matrix_data_t inverse = 1.0F / pivot;
+            scratch_row[system] = last ? 0.0F : upper_row[system] * inverse;
+            rhs_row[system] =
+                (rhs_row[system] - lower_row[system] * previous_rhs[system]) *
+                inverse;
+        }
+    }
+
+    // A zero pivot has already spread infinities through its system, so
+    // report it before the back substitution.
+    if (zero_pivots > 0UL) {
+        return MATRIX_ERR_SINGULAR;
+    }
+
+    for (matrix_size_t row = size - 1UL; row-- > 0UL;) {
+        matrix_size_t offset = row * count;
+        matrix_data_t* rhs_row = &rhs[offset];
+        matrix_data_t const* scratch_row = &scratch[offset];
+        matrix_data_t const* next_rhs = &rhs[offset + count];
+
+        for (matrix_size_t system = 0UL; system < count; ++system) {
+            rhs_row[system] -= scratch_row[system] * next_rhs[system];
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
@@ -0,0 +1,103 @@
+#ifndef LINALG_MATRIX_BAND_H
+#define LINALG_MATRIX_BAND_H
+
+#include "matrix.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Element (ROW, COLUMN) of a band matrix, valid for
+// ROW - lower <= COLUMN <= ROW + upper.
+#define MATRIX_BAND_INDEX(BAND, ROW, COLUMN)                             \
+    ((BAND)->data[(ROW) * ((BAND)->lower + (BAND)->upper + 1UL) +        \
+                  (COLUMN) + (BAND)->lower - (ROW)])
+
+// Square size x size matrix with lower sub- and upper super-diagonals. Each
+// row stores its lower + upper + 1 band elements contiguously, so element
+// (r, c) sits at r * (lower + upper + 1) + c - r + lower. Slots that fall
+// outside the matrix in the first and last rows are kept at zero.
+typedef struct {
+    matrix_data_t* data;
+    matrix_size_t size;
+    matrix_size_t lower;
+    matrix_size_t upper;
+    matrix_allocator_t allocator;
+} matrix_band_t;
+
+matrix_err_t matrix_band_initialize(matrix_band_t* band,
+                                    matrix_allocator_t const* allocator);
+
+// Creates a zero band matrix.
+matrix_err_t matrix_band_create(matrix_band_t* band,
+                                matrix_size_t size,
+                                matrix_size_t lower,
+                                matrix_size_t upper);
+
+matrix_err_t matrix_band_delete(matrix_band_t* band);
+
+// Copies the band of a square matrix; elements outside it are not read.
+matrix_err_t matrix_band_from_matrix(matrix_t const* matrix,
+                                     matrix_size_t lower,
+                                     matrix_size_t upper,
+                                     matrix_band_t* band);
+
+matrix_err_t matrix_band_to_matrix(matrix_band_t const* band,
+                                   matrix_t* matrix);
+
+// product = band * matrix. product must not be matrix, which fails with
+// MATRIX_ERR_FAIL.
+matrix_err_t matrix_band_product(matrix_band_t const* band,
+                                 matrix_t const* matrix,
+                                 matrix_t* product);
+
+// Factors band = L U in place without pivoting, so the factors keep the
+// bandwidth of band: the multipliers of the unit lower L replace the lower
+// band and U the diagonal and upper band. Meant for diagonally dominant or
+// positive definite systems such as splines and 1-D discretizations; returns
+// MATRIX_ERR_SINGULAR on a zero pivot. O(size * lower * upper).
+matrix_err_t matrix_band_lu(matrix_band_t* band);
+
+// Overwrites matrix with the solution of L U X = matrix for a band factored
+// by matrix_band_lu. O(size * (lower + upper)) per column of matrix.
+matrix_err_t matrix_band_lu_solve(matrix_band_t const* band, matrix_t* matrix);
+
+// Factors a symmetric positive definite band = L L^T in place. Only the
+// lower band is read and it is replaced by L; the upper band is left as is.
+// lower and upper must be equal. Returns MATRIX_ERR_SINGULAR if band is not
+// positive definite.
+matrix_err_t matrix_band_cholesky(matrix_band_t* band);
+
+// Overwrites matrix with the solution of L L^T X = matrix for a band
+// factored by matrix_band_cholesky.
+matrix_err_t matrix_band_cholesky_solve(matrix_band_t const* band,
+                                        matrix_t* matrix);
+
+// Thomas algorithm for a tridiagonal system of size equations. lower[0] and
+// upper[size - 1] are not read. rhs is overwritten with the solution and
+// scratch holds size elements. The inputs are not modified. Does not pivot;
+// returns MATRIX_ERR_SINGULAR on a zero pivot.
+matrix_err_t matrix_tridiagonal_solve(matrix_size_t size,
+                                      matrix_data_t const* lower,
+                                      matrix_data_t const* diagonal,
+                                      matrix_data_t const* upper,
+                                      matrix_data_t* rhs,
+                                      matrix_data_t* scratch);
+
+// matrix_tridiagonal_solve over count independent systems of the same size
+// in structure-of-arrays layout: element i of system s is at index
+// i * count + s in every array, so each step runs across all systems with
+// unit stride. scratch holds size * count elements.
+matrix_err_t matrix_tridiagonal_solve_batch(matrix_size_t size,
+                                            matrix_size_t count,
+                                            matrix_data_t const* lower,
+                                            matrix_data_t const* diagonal,
+                                            matrix_data_t const* upper,
+                                            matrix_data_t* rhs,
+                                            matrix_data_t* scratch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_MATRIX_BAND_H
@@ -0,0 +1,448 @@
+#include "matrix_batch.h"
+#include "linalg_profile.h"
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MATRIX_BATCH_POSIX
+#include <pthread.h>
+#endif
+
+typedef enum {
+    MATRIX_BATCH_OP_PRODUCT = 0,
+    MATRIX_BATCH_OP_SUM,
+    MATRIX_BATCH_OP_SCALE,
+} matrix_batch_op_t;
+
+// Work on the groups [begin, end) of output.
+typedef struct {
+    matrix_batch_op_t op;
+    matrix_batch_t const* batch1;
+    matrix_batch_t const* batch2;
+    matrix_batch_t* output;
+    matrix_data_t scalar;
+    matrix_size_t begin;
+    matrix_size_t end;
+} matrix_batch_task_t;
+
+// Elements in the allocation, padding included.
+static inline matrix_size_t matrix_batch_length(matrix_batch_t const* batch)
+{
+    return MATRIX_BATCH_GROUPS(batch->count) * MATRIX_BATCH_LANES *
+           batch->rows * batch->columns;
+}
+
+static void matrix_batch_product_range(matrix_batch_task_t const* task)
+{
+    matrix_batch_t const* batch1 = task->batch1;
+    matrix_batch_t const* batch2 = task->batch2;
+    matrix_batch_t* product = task->output;
+    matrix_size_t common = batch1->columns;
+    matrix_size_t columns = product->columns;
+    matrix_data_t sum[MATRIX_BATCH_LANES];
+
+    for (matrix_size_t group = task->begin; group < task->end; ++group) {
+        matrix_data_t const* group1 =
+            &batch1->data[group * batch1->rows * common * MATRIX_BATCH_LANES];
+        matrix_data_t const* group2 =
+            &batch2->data[group * common * columns * MATRIX_BATCH_LANES];
+        matrix_data_t* output =
+            &product->data[group * product->rows * columns *
+                           MATRIX_BATCH_LANES];
+
+        for (matrix_size_t row = 0UL; row < product->rows; ++row) {
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                memset(sum, 0, sizeof(sum));
+
+                for (matrix_size_t k = 0UL; k < common; ++k) {
+                    matrix_data_t const* values1 =
+                        &group1[(row * common + k) * MATRIX_BATCH_LANES];
+                    matrix_data_t const* values2 =
+                        &group2[(k * columns + column) * MATRIX_BATCH_LANES];
+
+                    for (matrix_size_t lane = 0UL; lane < MATRIX_BATCH_LANES;
+                         ++lane) {
+                        sum[lane] += values1[lane] * values2[lane];
+                    }
+                }
+
+                memcpy(&output[(row * columns + column) * MATRIX_BATCH_LANES],
+                       sum,
+                       sizeof(sum));
+            }
+        }
+    }
+}
+
+static void matrix_batch_elementwise_range(matrix_batch_task_t const* task)
+{
+    matrix_batch_t* output = task->output;
+    matrix_size_t group_length =
+        output->rows * output->columns * MATRIX_BATCH_LANES;
+    matrix_size_t begin = task->begin * group_length;
+    matrix_size_t end = task->end * group_length;
+    matrix_data_t const* values1 = task->batch1->data;
+    matrix_data_t* values = output->data;
+
+    if (task->op == MATRIX_BATCH_OP_SUM) {
+        matrix_data_t const* values2 = task->batch2->data;
+
+        for (matrix_size_t index = begin; index < end; ++index) {
+            values[index] = values1[index] + values2[index];
+        }
+    } else {
+        for (matrix_size_t index = begin; index < end; ++index) {
+            values[index] = task->scalar * values1[index];
+        }
+    }
+}
+
+static void matrix_batch_run_range(matrix_batch_task_t const* task)
+{
+    if (task->op == MATRIX_BATCH_OP_PRODUCT) {
+        matrix_batch_product_range(task);
+    } else {
+        matrix_batch_elementwise_range(task);
+    }
+}
+
+#ifdef MATRIX_BATCH_POSIX
+static void* matrix_batch_thread(void* argument)
+{
+    matrix_batch_run_range(argument);
+    return NULL;
+}
+#endif
+
+// Splits the groups into one contiguous range per thread. Threads that fail
+// to start have their range run on the calling thread instead.
+static void matrix_batch_run(matrix_batch_task_t const* task,
+                             matrix_size_t threads)
+{
+    matrix_size_t count = MATRIX_BATCH_GROUPS(task->output->count);
+
+#ifdef MATRIX_BATCH_POSIX
+    if (threads > MATRIX_BATCH_MAX_THREADS) {
+        threads = MATRIX_BATCH_MAX_THREADS;
+    }
+    if (threads > count) {
+        threads = count;
+    }
+#else
+    threads = 1UL;
+#endif
+
+    if (threads <= 1UL) {
+        matrix_batch_task_t range = *task;
+        range.begin = 0UL;
+        range.end = count;
+        matrix_batch_run_range(&range);
+        return;
+    }
+
+#ifdef MATRIX_BATCH_POSIX
+    matrix_batch_task_t ranges[MATRIX_BATCH_MAX_THREADS];
+    pthread_t handles[MATRIX_BATCH_MAX_THREADS];
+    bool started[MATRIX_BATCH_MAX_THREADS];
+
+    for (matrix_size_t thread = 0UL; thread < threads; ++thread) {
+        ranges[thread] = *task;
+        ranges[thread].begin = count * thread / threads;
+        ranges[thread].end = count * (thread + 1UL) / threads;
+    }
+
+    for (matrix_size_t thread = 1UL; thread < threads; ++thread) {
+        started[thread] = pthread_create(&handles[thread],
+                                         NULL,
+                                         matrix_batch_thread,
+                                         &ranges[thread]) == 0;
+    }
+
+    matrix_batch_run_range(&ranges[0UL]);
+
+    for (matrix_size_t thread = 1UL; thread < threads; ++thread) {
+        if (started[thread]) {
+            pthread_join(handles[thread], NULL);
+        } else {
+            matrix_batch_run_range(&ranges[thread]);
+        }
+    }
+#endif
+}
+
+matrix_err_t matrix_batch_initialize(matrix_batch_t* batch,
+                                     matrix_allocator_t const* allocator)
+{
+    if (batch == NULL || allocator == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_batch_initialize, 0, 0);
+
+    memset(batch, 0, sizeof(*batch));
+    batch->allocator = *allocator;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_batch_create(matrix_batch_t* batch,
+                                 matrix_size_t count,
+                                 matrix_size_t rows,
+                                 matrix_size_t columns)
+{
+    if (batch == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_batch_create, 0, 0);
+
+    if (batch->allocator.allocate == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    matrix_size_t groups = MATRIX_BATCH_GROUPS(count);
+    matrix_size_t group_length = rows * columns * MATRIX_BATCH_LANES;
+
+    matrix_data_t* data = batch->allocator.allocate(
+        batch->allocator.user,
+        sizeof(matrix_data_t) * groups * group_length);
+    if (data == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    if (groups > 0UL) {
+        memset(&data[(groups - 1UL) * group_length],
+               0,
+               sizeof(matrix_data_t) * group_length);
+    }
+
+    batch->data = data;
+    batch->count = count;
+    batch->rows = rows;
+    batch->columns = columns;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_batch_delete(matrix_batch_t* batch)
+{
+    if (batch == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_batch_delete, 0, 0);
+
+    if (batch->data != NULL && batch->allocator.deallocate != NULL) {
+        batch->allocator.deallocate(batch->allocator.user, batch->data);
+    }
+
+    batch->data = NULL;
+    batch->count = 0UL;
+    batch->rows = 0UL;
+    batch->columns = 0UL;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_batch_resize(matrix_batch_t* batch,
+                                 matrix_size_t count,
+                                 matrix_size_t rows,
+                                 matrix_size_t columns)
+{
+    if (batch == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_batch_resize, 0, 0);
+
+    if (batch->data != NULL && batch->count == count && batch->rows == rows &&
+        batch->columns == columns) {
+        return MATRIX_ERR_OK;
+    }
+
+    matrix_batch_t resized = *batch;
+    matrix_err_t err = matrix_batch_create(&resized, count, rows, columns);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    matrix_batch_delete(batch);
+    *batch = resized;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_batch_set(matrix_batch_t* batch,
+                              matrix_size_t index,
+                              matrix_t const* matrix)
+{
+    if (batch == NULL || matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_batch_set,
+        0,
+        2UL * sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
+    if (index >= batch->count || matrix->rows != batch->rows ||
+        matrix->columns != batch->columns) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    for (matrix_size_t row = 0UL; row < batch->rows; ++row) {
+        for (matrix_size_t column = 0UL; column < batch->columns; ++column) {
+            MATRIX_BATCH_INDEX(batch, index, row, column) =
+                MATRIX_INDEX(matrix, row, column);
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_batch_get(matrix_batch_t const* batch,
+                              matrix_size_t index,
+                              matrix_t* matrix)
+{
+    if (batch == NULL || matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_batch_get,
+        0,
+        2UL * sizeof(matrix_data_t) * batch->rows * batch->columns);
+
+    if (index >= batch->count) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_err_t err = matrix_resize(matrix, batch->rows, batch->columns);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    for (matrix_size_t row = 0UL; row < batch->rows; ++row) {
+        for (matrix_size_t column = 0UL; column < batch->columns; ++column) {
+            MATRIX_INDEX(matrix, row, column) =
+                MATRIX_BATCH_INDEX(batch, index, row, column);
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_batch_product(matrix_batch_t const* batch1,
+                                  matrix_batch_t const* batch2,
+                                  matrix_batch_t* product,
+                                  matrix_size_t threads)
+{
+    if (batch1 == NULL || batch2 == NULL || product == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    if (product == batch1 || product == batch2) {
+        return MATRIX_ERR_FAIL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_batch_product,
+        2UL * batch1->count * batch1->rows * batch1->columns *
+            batch2->columns,
+        sizeof(matrix_data_t) *
+            (matrix_batch_length(batch1) + matrix_batch_length(batch2) +
+             batch1->count * batch1->rows * batch2->columns));
+
+    if (batch1->count != batch2->count || batch1->columns != batch2->rows) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_err_t err = matrix_batch_resize(product,
+                                           batch1->count,
+                                           batch1->rows,
+                                           batch2->columns);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    matrix_batch_task_t task = {
+        .op = MATRIX_BATCH_OP_PRODUCT,
+        .batch1 = batch1,
+        .batch2 = batch2,
+        .output = product,
+    };
+    matrix_batch_run(&task, threads);
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_batch_sum(matrix_batch_t const* batch1,
+                              matrix_batch_t const* batch2,
+                              matrix_batch_t* sum,
+                              matrix_size_t threads)
+{
+    if (batch1 == NULL || batch2 == NULL || sum == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_batch_sum,
+        matrix_batch_length(batch1),
+        3UL * sizeof(matrix_data_t) * matrix_batch_length(batch1));
+
+    if (batch1->count != batch2->count || batch1->rows != batch2->rows ||
+        batch1->columns != batch2->columns) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_err_t err = matrix_batch_resize(sum,
+                                           batch1->count,
+                                           batch1->rows,
+                                           batch1->columns);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    matrix_batch_task_t task = {
+        .op = MATRIX_BATCH_OP_SUM,
+        .batch1 = batch1,
+        .batch2 = batch2,
+        .output = sum,
+    };
+    matrix_batch_run(&task, threads);
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_batch_scale(matrix_batch_t const* batch,
+                                matrix_data_t scalar,
+                                matrix_batch_t* scale,
+                                matrix_size_t threads)
+{
+    if (batch == NULL || scale == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_batch_scale,
+        matrix_batch_length(batch),
+        2UL * sizeof(matrix_data_t) * matrix_batch_length(batch));
+
+    matrix_err_t err = matrix_batch_resize(scale,
+                                           batch->count,
+                                           batch->rows,
+                                           batch->columns);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    matrix_batch_task_t task = {
+        .op = MATRIX_BATCH_OP_SCALE,
+        .batch1 = batch,
+        .output = scale,
+        .scalar = scalar,
+    };
+    matrix_batch_run(&task, threads);
+
+    return MATRIX_ERR_OK;
+}
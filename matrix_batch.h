@@ -0,0 +1,94 @@
+#ifndef LINALG_MATRIX_BATCH_H
+#define LINALG_MATRIX_BATCH_H
+
+#include "matrix.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MATRIX_BATCH_MAX_THREADS 64UL
+
+// Matrices interleaved per group; a multiple of every SIMD width in use.
+#define MATRIX_BATCH_LANES 16UL
+
+// Number of groups holding COUNT matrices.
+#define MATRIX_BATCH_GROUPS(COUNT) \
+    (((COUNT) + MATRIX_BATCH_LANES - 1UL) / MATRIX_BATCH_LANES)
+
+// Element (ROW, COLUMN) of matrix INDEX in a batch.
+#define MATRIX_BATCH_INDEX(BATCH, INDEX, ROW, COLUMN)                    \
+    ((BATCH)->data[((INDEX) / MATRIX_BATCH_LANES * (BATCH)->rows *      \
+                        (BATCH)->columns +                              \
+                    (ROW) * (BATCH)->columns + (COLUMN)) *              \
+                       MATRIX_BATCH_LANES +                             \
+                   (INDEX) % MATRIX_BATCH_LANES])
+
+// count matrices of the same rows x columns shape in one allocation. The
+// matrices are stored in groups of MATRIX_BATCH_LANES, and within a group
+// the same element of every matrix is contiguous, so the kernels below run
+// their inner loop across the group with unit stride regardless of how small
+// each matrix is, while each group stays in one compact block of memory. The
+// last group is padded with zero matrices.
+typedef struct {
+    matrix_data_t* data;
+    matrix_size_t count;
+    matrix_size_t rows;
+    matrix_size_t columns;
+    matrix_allocator_t allocator;
+} matrix_batch_t;
+
+matrix_err_t matrix_batch_initialize(matrix_batch_t* batch,
+                                     matrix_allocator_t const* allocator);
+
+matrix_err_t matrix_batch_create(matrix_batch_t* batch,
+                                 matrix_size_t count,
+                                 matrix_size_t rows,
+                                 matrix_size_t columns);
+
+matrix_err_t matrix_batch_delete(matrix_batch_t* batch);
+
+// Keeps the allocation when the shape and count do not change.
+matrix_err_t matrix_batch_resize(matrix_batch_t* batch,
+                                 matrix_size_t count,
+                                 matrix_size_t rows,
+                                 matrix_size_t columns);
+
+// Copies matrix into slot index. matrix must have the batch's shape.
+matrix_err_t matrix_batch_set(matrix_batch_t* batch,
+                              matrix_size_t index,
+                              matrix_t const* matrix);
+
+// Resizes matrix and copies slot index into it.
+matrix_err_t matrix_batch_get(matrix_batch_t const* batch,
+                              matrix_size_t index,
+                              matrix_t* matrix);
+
+// The batched kernels split the batch into contiguous ranges over up to
+// threads threads, the calling thread included; 0 and 1 both run on the
+// calling thread only. Outputs are resized like matrix_product's.
+
+// product[i] = batch1[i] * batch2[i]. product must not be an operand, which
+// fails with MATRIX_ERR_FAIL.
+matrix_err_t matrix_batch_product(matrix_batch_t const* batch1,
+                                  matrix_batch_t const* batch2,
+                                  matrix_batch_t* product,
+                                  matrix_size_t threads);
+
+// sum[i] = batch1[i] + batch2[i]. sum may be an operand.
+matrix_err_t matrix_batch_sum(matrix_batch_t const* batch1,
+                              matrix_batch_t const* batch2,
+                              matrix_batch_t* sum,
+                              matrix_size_t threads);
+
+// scale[i] = scalar * batch[i]. scale may be batch.
+matrix_err_t matrix_batch_scale(matrix_batch_t const* batch,
+                                matrix_data_t scalar,
+                                matrix_batch_t* scale,
+                                matrix_size_t threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_MATRIX_BATCH_H
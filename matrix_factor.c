@@ -0,0 +1,551 @@
+#include "matrix_factor.h"
+#include "linalg_profile.h"
+#include <stdbool.h>
+#include <string.h>
+
+static matrix_data_t* matrix_factor_allocate(matrix_t const* matrix,
+                                             matrix_size_t length)
+{
+    if (matrix->allocator.allocate == NULL) {
+        return NULL;
+    }
+
+    return matrix->allocator.allocate(matrix->allocator.user,
+                                      sizeof(matrix_data_t) * length);
+}
+
+static void matrix_factor_deallocate(matrix_t const* matrix,
+                                     matrix_data_t* data)
+{
+    if (matrix->allocator.deallocate == NULL || data == NULL) {
+        return;
+    }
+
+    matrix->allocator.deallocate(matrix->allocator.user, data);
+}
+
+static bool matrix_factor_is_vector(matrix_t const* vector,
+                                    matrix_size_t size)
+{
+    return vector->rows == size && vector->columns == 1UL;
+}
+
+// Solves system * X = rhs for a k x k system and k x columns rhs by
+// Gaussian elimination with partial pivoting. Both are overwritten; X is
+// left in rhs.
+static bool matrix_factor_gauss(matrix_data_t* system,
+                                matrix_data_t* rhs,
+                                matrix_size_t k,
+                                matrix_size_t columns)
+{
+    for (matrix_size_t pivot = 0UL; pivot < k; ++pivot) {
+        matrix_size_t best = pivot;
+        for (matrix_size_t row = pivot + 1UL; row < k; ++row) {
+            if (fabsf(system[row * k + pivot]) >
+                fabsf(system[best * k + pivot])) {
+                best = row;
+            }
+        }
+
+        if (system[best * k + pivot] == 0.0F) {
+            return false;
+        }
+
+        if (best != pivot) {
+            for (matrix_size_t column = 0UL; column < k; ++column) {
+                matrix_data_t swap = system[pivot * k + column];
+                system[pivot * k + column] = system[best * k + column];
+                system[best * k + column] = swap;
+            }
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                matrix_data_t swap = rhs[pivot * columns + column];
+                rhs[pivot * columns + column] = rhs[best * columns + column];
+                rhs[best * columns + column] = swap;
+            }
+        }
+
+        for (matrix_size_t row = pivot + 1UL; row < k; ++row) {
+            matrix_data_t multiplier =
+                system[row * k + pivot] / system[pivot * k + pivot];
+
+            for (matrix_size_t column = pivot + 1UL; column < k; ++column) {
+                system[row * k + column] -=
+                    multiplier * system[pivot * k + column];
+            }
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                rhs[row * columns + column] -=
+                    multiplier * rhs[pivot * columns + column];
+            }
+        }
+    }
+
+    for (matrix_size_t row = k; row-- > 0UL;) {
+        matrix_data_t* solution_row = &rhs[row * columns];
+
+        for (matrix_size_t j = row + 1UL; j < k; ++j) {
+            matrix_data_t value = system[row * k + j];
+            matrix_data_t const* source_row = &rhs[j * columns];
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                solution_row[column] -= value * source_row[column];
+            }
+        }
+
+        matrix_data_t inverse = 1.0F / system[row * k + row];
+        for (matrix_size_t column = 0UL; column < columns; ++column) {
+            solution_row[column] *= inverse;
+        }
+    }
+
+    return true;
+}
+
+matrix_err_t matrix_lu(matrix_t* matrix)
+{
+    if (matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_lu,
+        2UL * matrix->rows * matrix->rows * matrix->rows / 3UL,
+        2UL * sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
+    if (matrix->rows != matrix->columns) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_size_t size = matrix->rows;
+
+    for (matrix_size_t k = 0UL; k < size; ++k) {
+        matrix_data_t pivot = MATRIX_INDEX(matrix, k, k);
+        if (pivot == 0.0F) {
+            return MATRIX_ERR_SINGULAR;
+        }
+
+        matrix_data_t const* pivot_row = &MATRIX_INDEX(matrix, k, 0UL);
+
+        for (matrix_size_t row = k + 1UL; row < size; ++row) {
+            matrix_data_t* target_row = &MATRIX_INDEX(matrix, row, 0UL);
+            matrix_data_t multiplier = target_row[k] / pivot;
+            target_row[k] = multiplier;
+
+            for (matrix_size_t column = k + 1UL; column < size; ++column) {
+                target_row[column] -= multiplier * pivot_row[column];
+            }
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_lu_solve(matrix_t const* lu, matrix_t* matrix)
+{
+    if (lu == NULL || matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_lu_solve,
+        2UL * lu->rows * lu->rows * matrix->columns,
+        sizeof(matrix_data_t) *
+            (lu->rows * lu->columns + 2UL * matrix->rows * matrix->columns));
+
+    if (lu->rows != lu->columns || lu->rows != matrix->rows) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_size_t size = lu->rows;
+    matrix_size_t columns = matrix->columns;
+
+    for (matrix_size_t row = 0UL; row < size; ++row) {
+        matrix_data_t* solution_row = &MATRIX_INDEX(matrix, row, 0UL);
+
+        for (matrix_size_t k = 0UL; k < row; ++k) {
+            matrix_data_t value = MATRIX_INDEX(lu, row, k);
+            matrix_data_t const* source_row = &MATRIX_INDEX(matrix, k, 0UL);
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                solution_row[column] -= value * source_row[column];
+            }
+        }
+    }
+
+    for (matrix_size_t row = size; row-- > 0UL;) {
+        matrix_data_t* solution_row = &MATRIX_INDEX(matrix, row, 0UL);
+
+        for (matrix_size_t k = row + 1UL; k < size; ++k) {
+            matrix_data_t value = MATRIX_INDEX(lu, row, k);
+            matrix_data_t const* source_row = &MATRIX_INDEX(matrix, k, 0UL);
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                solution_row[column] -= value * source_row[column];
+            }
+        }
+
+        matrix_data_t inverse = 1.0F / MATRIX_INDEX(lu, row, row);
+        for (matrix_size_t column = 0UL; column < columns; ++column) {
+            solution_row[column] *= inverse;
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_lu_update(matrix_t* lu,
+                              matrix_t const* u,
+                              matrix_t const* v)
+{
+    if (lu == NULL || u == NULL || v == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_lu_update,
+                            4UL * lu->rows * lu->rows,
+                            2UL * sizeof(matrix_data_t) * lu->rows *
+                                lu->columns);
+
+    matrix_size_t size = lu->rows;
+
+    if (lu->columns != size || !matrix_factor_is_vector(u, size) ||
+        !matrix_factor_is_vector(v, size)) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_data_t* scratch = matrix_factor_allocate(lu, 2UL * size);
+    if (scratch == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    // Eliminating row k of the update leaves a rank-1 update of the trailing
+    // block, with x reduced by column k of L and y by row k of U. Both
+    // reductions run along rows, so the factor is walked once in storage
+    // order. Once row k is done y[k] holds y_k / u_kk, which is all the
+    // later rows need from it.
+    matrix_data_t* x = scratch;
+    matrix_data_t* y = scratch + size;
+    memcpy(x, u->data, sizeof(matrix_data_t) * size);
+    memcpy(y, v->data, sizeof(matrix_data_t) * size);
+
+    matrix_err_t err = MATRIX_ERR_OK;
+
+    for (matrix_size_t row = 0UL; row < size; ++row) {
+        matrix_data_t* lu_row = &MATRIX_INDEX(lu, row, 0UL);
+        matrix_data_t x_row = x[row];
+
+        for (matrix_size_t k = 0UL; k < row; ++k) {
+            x_row -= x[k] * lu_row[k];
+            lu_row[k] += y[k] * x_row;
+        }
+
+        x[row] = x_row;
+
+        matrix_data_t pivot = lu_row[row] + x_row * y[row];
+        if (pivot == 0.0F) {
+            err = MATRIX_ERR_SINGULAR;
+            break;
+        }
+
+        lu_row[row] = pivot;
+        matrix_data_t y_row = y[row] / pivot;
+        y[row] = y_row;
+
+        for (matrix_size_t column = row + 1UL; column < size; ++column) {
+            lu_row[column] += x_row * y[column];
+            y[column] -= y_row * lu_row[column];
+        }
+    }
+
+    matrix_factor_deallocate(lu, scratch);
+
+    return err;
+}
+
+matrix_err_t matrix_cholesky_solve(matrix_t const* lower, matrix_t* matrix)
+{
+    if (lower == NULL || matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_cholesky_solve,
+        2UL * lower->rows * lower->rows * matrix->columns,
+        sizeof(matrix_data_t) * (lower->rows * lower->columns / 2UL +
+                                 2UL * matrix->rows * matrix->columns));
+
+    if (lower->rows != lower->columns || lower->rows != matrix->rows) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_size_t size = lower->rows;
+    matrix_size_t columns = matrix->columns;
+
+    for (matrix_size_t row = 0UL; row < size; ++row) {
+        matrix_data_t* solution_row = &MATRIX_INDEX(matrix, row, 0UL);
+
+        for (matrix_size_t k = 0UL; k < row; ++k) {
+            matrix_data_t value = MATRIX_INDEX(lower, row, k);
+            matrix_data_t const* source_row = &MATRIX_INDEX(matrix, k, 0UL);
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                solution_row[column] -= value * source_row[column];
+            }
+        }
+
+        matrix_data_t inverse = 1.0F / MATRIX_INDEX(lower, row, row);
+        for (matrix_size_t column = 0UL; column < columns; ++column) {
+            solution_row[column] *= inverse;
+        }
+    }
+
+    for (matrix_size_t row = size; row-- > 0UL;) {
+        matrix_data_t* solution_row = &MATRIX_INDEX(matrix, row, 0UL);
+
+        matrix_data_t inverse = 1.0F / MATRIX_INDEX(lower, row, row);
+        for (matrix_size_t column = 0UL; column < columns; ++column) {
+            solution_row[column] *= inverse;
+        }
+
+        for (matrix_size_t k = 0UL; k < row; ++k) {
+            matrix_data_t value = MATRIX_INDEX(lower, row, k);
+            matrix_data_t* target_row = &MATRIX_INDEX(matrix, k, 0UL);
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                target_row[column] -= value * solution_row[column];
+            }
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_cholesky_update(matrix_t* lower, matrix_t const* vector)
+{
+    if (lower == NULL || vector == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_cholesky_update,
+                            2UL * lower->rows * lower->rows,
+                            sizeof(matrix_data_t) * lower->rows *
+                                lower->columns);
+
+    matrix_size_t size = lower->rows;
+
+    if (lower->columns != size || !matrix_factor_is_vector(vector, size)) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_data_t* scratch = matrix_factor_allocate(lower, 2UL * size);
+    if (scratch == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    // Rotation k folds element k of the vector into the diagonal. Row k of L
+    // receives rotations 0 .. k - 1 before it generates its own, so each
+    // row is read and written once, left to right.
+    matrix_data_t* cosines = scratch;
+    matrix_data_t* sines = scratch + size;
+
+    for (matrix_size_t row = 0UL; row < size; ++row) {
+        matrix_data_t* lower_row = &MATRIX_INDEX(lower, row, 0UL);
+        matrix_data_t x = vector->data[row];
+
+        for (matrix_size_t k = 0UL; k < row; ++k) {
+            matrix_data_t value = lower_row[k];
+            lower_row[k] = cosines[k] * value + sines[k] * x;
+            x = cosines[k] * x - sines[k] * value;
+        }
+
+        matrix_data_t diagonal = hypotf(lower_row[row], x);
+        cosines[row] = lower_row[row] / diagonal;
+        sines[row] = x / diagonal;
+        lower_row[row] = diagonal;
+    }
+
+    matrix_factor_deallocate(lower, scratch);
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_cholesky_downdate(matrix_t* lower,
+                                      matrix_t const* vector)
+{
+    if (lower == NULL || vector == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_cholesky_downdate,
+                            3UL * lower->rows * lower->rows,
+                            2UL * sizeof(matrix_data_t) * lower->rows *
+                                lower->columns);
+
+    matrix_size_t size = lower->rows;
+
+    if (lower->columns != size || !matrix_factor_is_vector(vector, size)) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_data_t* scratch = matrix_factor_allocate(lower, 2UL * size);
+    if (scratch == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    // A - x x^T stays positive definite exactly when a = L^-1 x has norm
+    // below one, which is checked before lower is touched (LINPACK dchdd).
+    matrix_data_t* cosines = scratch;
+    matrix_data_t* sines = scratch + size;
+    matrix_data_t norm = 0.0F;
+
+    for (matrix_size_t row = 0UL; row < size; ++row) {
+        matrix_data_t const* lower_row = &MATRIX_INDEX(lower, row, 0UL);
+        matrix_data_t sum = vector->data[row];
+
+        for (matrix_size_t k = 0UL; k < row; ++k) {
+            sum -= lower_row[k] * sines[k];
+        }
+
+        sines[row] = sum / lower_row[row];
+        norm += sines[row] * sines[row];
+    }
+
+    if (!(norm < 1.0F)) {
+        matrix_factor_deallocate(lower, scratch);
+        return MATRIX_ERR_SINGULAR;
+    }
+
+    // Rotations from the last element up zero a against alpha; applying
+    // them to L^T removes x x^T.
+    matrix_data_t alpha = sqrtf(1.0F - norm);
+
+    for (matrix_size_t k = size; k-- > 0UL;) {
+        matrix_data_t scale = alpha + fabsf(sines[k]);
+        matrix_data_t a = alpha / scale;
+        matrix_data_t b = sines[k] / scale;
+        matrix_data_t length = sqrtf(a * a + b * b);
+
+        cosines[k] = a / length;
+        sines[k] = b / length;
+        alpha = scale * length;
+    }
+
+    for (matrix_size_t row = 0UL; row < size; ++row) {
+        matrix_data_t* lower_row = &MATRIX_INDEX(lower, row, 0UL);
+        matrix_data_t x = 0.0F;
+
+        for (matrix_size_t k = row + 1UL; k-- > 0UL;) {
+            matrix_data_t value = lower_row[k];
+            lower_row[k] = cosines[k] * value - sines[k] * x;
+            x = cosines[k] * x + sines[k] * value;
+        }
+    }
+
+    matrix_factor_deallocate(lower, scratch);
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_inverse_update(matrix_t* inverse,
+                                   matrix_t const* u,
+                                   matrix_t const* v)
+{
+    if (inverse == NULL || u == NULL || v == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_inverse_update,
+        6UL * inverse->rows * inverse->rows * u->columns,
+        sizeof(matrix_data_t) * inverse->rows *
+            (3UL * inverse->columns + 2UL * u->columns));
+
+    matrix_size_t size = inverse->rows;
+    matrix_size_t k = u->columns;
+
+    if (inverse->columns != size || u->rows != size || v->rows != size ||
+        v->columns != k) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    if (k == 0UL) {
+        return MATRIX_ERR_OK;
+    }
+
+    matrix_data_t* scratch =
+        matrix_factor_allocate(inverse, 2UL * size * k + k * k);
+    if (scratch == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    // A^-1 - (A^-1 U) (I + V^T A^-1 U)^-1 (V^T A^-1): left is A^-1 U,
+    // right is V^T A^-1 and capacitance the k x k middle term.
+    matrix_data_t* left = scratch;
+    matrix_data_t* right = left + size * k;
+    matrix_data_t* capacitance = right + k * size;
+    memset(scratch, 0, sizeof(matrix_data_t) * (2UL * size * k + k * k));
+
+    for (matrix_size_t row = 0UL; row < size; ++row) {
+        matrix_data_t const* inverse_row = &MATRIX_INDEX(inverse, row, 0UL);
+        matrix_data_t* left_row = &left[row * k];
+
+        for (matrix_size_t j = 0UL; j < size; ++j) {
+            matrix_data_t value = inverse_row[j];
+            matrix_data_t const* u_row = &MATRIX_INDEX(u, j, 0UL);
+
+            for (matrix_size_t column = 0UL; column < k; ++column) {
+                left_row[column] += value * u_row[column];
+            }
+        }
+
+        matrix_data_t const* v_row = &MATRIX_INDEX(v, row, 0UL);
+
+        for (matrix_size_t i = 0UL; i < k; ++i) {
+            matrix_data_t value = v_row[i];
+            matrix_data_t* right_row = &right[i * size];
+
+            for (matrix_size_t column = 0UL; column < size; ++column) {
+                right_row[column] += value * inverse_row[column];
+            }
+        }
+    }
+
+    for (matrix_size_t row = 0UL; row < size; ++row) {
+        matrix_data_t const* v_row = &MATRIX_INDEX(v, row, 0UL);
+        matrix_data_t const* left_row = &left[row * k];
+
+        for (matrix_size_t i = 0UL; i < k; ++i) {
+            for (matrix_size_t column = 0UL; column < k; ++column) {
+                capacitance[i * k + column] += v_row[i] * left_row[column];
+            }
+        }
+    }
+
+    for (matrix_size_t i = 0UL; i < k; ++i) {
+        capacitance[i * k + i] += 1.0F;
+    }
+
+    if (!matrix_factor_gauss(capacitance, right, k, size)) {
+        matrix_factor_deallocate(inverse, scratch);
+        return MATRIX_ERR_SINGULAR;
+    }
+
+    for (matrix_size_t row = 0UL; row < size; ++row) {
+        matrix_data_t* inverse_row = &MATRIX_INDEX(inverse, row, 0UL);
+        matrix_data_t const* left_row = &left[row * k];
+
+        for (matrix_size_t i = 0UL; i < k; ++i) {
+            matrix_data_t value = left_row[i];
+            matrix_data_t const* right_row = &right[i * size];
+
+            for (matrix_size_t column = 0UL; column < size; ++column) {
+                inverse_row[column] -= value * right_row[column];
+            }
+        }
+    }
+
+    matrix_factor_deallocate(inverse, scratch);
+
+    return MATRIX_ERR_OK;
+}
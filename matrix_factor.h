@@ -0,0 +1,59 @@
+#ifndef LINALG_MATRIX_FACTOR_H
+#define LINALG_MATRIX_FACTOR_H
+
+#include "matrix.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Dense factorizations that are kept and modified in place rather than
+// recomputed when the factored matrix changes by a low-rank term. Vectors
+// are size x 1 matrices. The updates take scratch from the allocator of the
+// factor they modify.
+
+// Factors a square matrix = L U in place without pivoting: the multipliers
+// of the unit lower L replace the strictly lower triangle and U the rest.
+// Returns MATRIX_ERR_SINGULAR on a zero pivot. O(size^3).
+matrix_err_t matrix_lu(matrix_t* matrix);
+
+// Overwrites matrix with the solution of L U X = matrix for a factor made by
+// matrix_lu. O(size^2) per column of matrix.
+matrix_err_t matrix_lu_solve(matrix_t const* lu, matrix_t* matrix);
+
+// Turns the factor of A made by matrix_lu into the factor of A + u v^T in
+// O(size^2) (Bennett's algorithm). Returns MATRIX_ERR_SINGULAR if the
+// updated matrix has a zero pivot, in which case lu is left partially
+// updated and must be refactored.
+matrix_err_t matrix_lu_update(matrix_t* lu,
+                              matrix_t const* u,
+                              matrix_t const* v);
+
+// Overwrites matrix with the solution of L L^T X = matrix for a factor made
+// by matrix_lower_triangular.
+matrix_err_t matrix_cholesky_solve(matrix_t const* lower, matrix_t* matrix);
+
+// Turns the factor L of A made by matrix_lower_triangular into the factor
+// of A + vector vector^T with a sweep of Givens rotations. O(size^2).
+matrix_err_t matrix_cholesky_update(matrix_t* lower, matrix_t const* vector);
+
+// Turns the factor L of A into the factor of A - vector vector^T. Returns
+// MATRIX_ERR_SINGULAR and leaves lower untouched if the result would not be
+// positive definite. O(size^2).
+matrix_err_t matrix_cholesky_downdate(matrix_t* lower,
+                                      matrix_t const* vector);
+
+// Turns the explicit inverse of A into the inverse of A + U V^T by the
+// Sherman-Morrison-Woodbury formula, where u and v are size x k. Costs
+// O(size^2 k + k^3) against O(size^3) for a fresh inverse. Returns
+// MATRIX_ERR_SINGULAR and leaves inverse untouched if I + V^T A^-1 U, and so
+// the updated matrix, is singular.
+matrix_err_t matrix_inverse_update(matrix_t* inverse,
+                                   matrix_t const* u,
+                                   matrix_t const* v);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_MATRIX_FACTOR_H
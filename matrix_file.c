@@ -0,0 +1,202 @@
+#include "matrix_file.h"
+#include "linalg_profile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MATRIX_FILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+typedef struct {
+    void* base;
+    size_t length;
+} matrix_file_mapping_t;
+
+uint64_t matrix_file_checksum(uint64_t hash, void const* data, size_t size)
+{
+    unsigned char const* bytes = data;
+
+    size_t index = 0UL;
+    for (; index + sizeof(uint64_t) <= size; index += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, bytes + index, sizeof(word));
+        hash = (hash ^ word) * 0x100000001B3ULL;
+    }
+    for (; index < size; ++index) {
+        hash = (hash ^ bytes[index]) * 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+matrix_err_t matrix_file_validate(matrix_file_header_t const* header,
+                                  uint64_t length)
+{
+    if (header == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    bool magic =
+        memcmp(header->magic, MATRIX_FILE_MAGIC, sizeof(MATRIX_FILE_MAGIC)) ==
+        0;
+    bool valid =
+        magic && header->version == MATRIX_FILE_VERSION &&
+        header->dtype == MATRIX_FILE_DTYPE_FLOAT32 &&
+        header->stride == header->columns &&
+        header->data_offset >= sizeof(*header) &&
+        header->data_offset % sizeof(matrix_data_t) == 0UL &&
+        header->data_offset <= length &&
+        (header->stride == 0UL ||
+         header->rows <= (length - header->data_offset) /
+                             sizeof(matrix_data_t) / header->stride);
+
+    return valid ? MATRIX_ERR_OK : MATRIX_ERR_FORMAT;
+}
+
+matrix_err_t matrix_save(matrix_t const* matrix, char const* path)
+{
+    if (matrix == NULL || path == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_save,
+        0,
+        sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
+    size_t size = sizeof(matrix_data_t) * matrix->rows * matrix->columns;
+
+    matrix_file_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MATRIX_FILE_MAGIC, sizeof(MATRIX_FILE_MAGIC));
+    header.version = MATRIX_FILE_VERSION;
+    header.dtype = MATRIX_FILE_DTYPE_FLOAT32;
+    header.rows = matrix->rows;
+    header.columns = matrix->columns;
+    header.stride = matrix->columns;
+    header.alignment = MATRIX_FILE_ALIGNMENT;
+    header.data_offset = (sizeof(header) + MATRIX_FILE_ALIGNMENT - 1U) /
+                         MATRIX_FILE_ALIGNMENT * MATRIX_FILE_ALIGNMENT;
+    header.checksum =
+        matrix_file_checksum(MATRIX_FILE_CHECKSUM_SEED, matrix->data, size);
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        return MATRIX_ERR_IO;
+    }
+
+    static char const padding[MATRIX_FILE_ALIGNMENT] = {0};
+    size_t padding_size = header.data_offset - sizeof(header);
+
+    bool ok = fwrite(&header, sizeof(header), 1UL, file) == 1UL &&
+              fwrite(padding, 1UL, padding_size, file) == padding_size &&
+              (size == 0UL || fwrite(matrix->data, size, 1UL, file) == 1UL);
+
+    if (fclose(file) != 0 || !ok) {
+        return MATRIX_ERR_IO;
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+#ifdef MATRIX_FILE_MMAP
+
+static matrix_data_t* matrix_file_allocate(void* user, matrix_size_t size)
+{
+    (void)user;
+    (void)size;
+
+    return NULL;
+}
+
+static void matrix_file_deallocate(void* user, matrix_data_t* data)
+{
+    (void)data;
+
+    matrix_file_mapping_t* mapping = user;
+    munmap(mapping->base, mapping->length);
+    free(mapping);
+}
+
+#endif // MATRIX_FILE_MMAP
+
+matrix_err_t matrix_map(matrix_t* matrix, char const* path, bool verify)
+{
+    if (matrix == NULL || path == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_map, 0, 0);
+
+#ifdef MATRIX_FILE_MMAP
+    int descriptor = open(path, O_RDONLY);
+    if (descriptor < 0) {
+        return MATRIX_ERR_IO;
+    }
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 ||
+        (size_t)status.st_size < sizeof(matrix_file_header_t)) {
+        close(descriptor);
+        return MATRIX_ERR_FORMAT;
+    }
+
+    size_t length = (size_t)status.st_size;
+    void* base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (base == MAP_FAILED) {
+        return MATRIX_ERR_IO;
+    }
+
+    matrix_file_header_t header;
+    memcpy(&header, base, sizeof(header));
+
+    if (matrix_file_validate(&header, length) != MATRIX_ERR_OK) {
+        munmap(base, length);
+        return MATRIX_ERR_FORMAT;
+    }
+
+    size_t size = sizeof(matrix_data_t) * header.rows * header.stride;
+    matrix_data_t* data =
+        (matrix_data_t*)((unsigned char*)base + header.data_offset);
+    if (verify &&
+        matrix_file_checksum(MATRIX_FILE_CHECKSUM_SEED, data, size) !=
+            header.checksum) {
+        munmap(base, length);
+        return MATRIX_ERR_FORMAT;
+    }
+
+    matrix_file_mapping_t* mapping = malloc(sizeof(*mapping));
+    if (mapping == NULL) {
+        munmap(base, length);
+        return MATRIX_ERR_ALLOC;
+    }
+    mapping->base = base;
+    mapping->length = length;
+
+    matrix_err_t err = matrix_delete(matrix);
+    if (err != MATRIX_ERR_OK) {
+        free(mapping);
+        munmap(base, length);
+        return err;
+    }
+
+    matrix->data = data;
+    matrix->rows = header.rows;
+    matrix->columns = header.columns;
+    matrix->allocator.user = mapping;
+    matrix->allocator.allocate = matrix_file_allocate;
+    matrix->allocator.deallocate = matrix_file_deallocate;
+
+    return MATRIX_ERR_OK;
+#else
+    (void)verify;
+
+    return MATRIX_ERR_FAIL;
+#endif
+}
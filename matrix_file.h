@@ -0,0 +1,60 @@
+#ifndef LINALG_MATRIX_FILE_H
+#define LINALG_MATRIX_FILE_H
+
+#include "matrix.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MATRIX_FILE_MAGIC "LINALGM"
+#define MATRIX_FILE_VERSION 1U
+#define MATRIX_FILE_ALIGNMENT 64U
+
+typedef enum {
+    MATRIX_FILE_DTYPE_FLOAT32 = 1,
+} matrix_file_dtype_t;
+
+// On-disk header, stored in native byte order and followed by padding up to
+// data_offset. stride is the row pitch in elements; checksum is FNV-1a over
+// the rows * stride data elements.
+typedef struct {
+    char magic[8U];
+    uint32_t version;
+    uint32_t dtype;
+    uint64_t rows;
+    uint64_t columns;
+    uint64_t stride;
+    uint64_t alignment;
+    uint64_t data_offset;
+    uint64_t checksum;
+} matrix_file_header_t;
+
+#define MATRIX_FILE_CHECKSUM_SEED 0xCBF29CE484222325ULL
+
+// Continues an FNV-1a checksum over size bytes. Feeding a buffer in pieces
+// gives the same result as one call as long as every piece but the last is a
+// multiple of eight bytes long.
+uint64_t matrix_file_checksum(uint64_t hash, void const* data, size_t size);
+
+// Checks magic, version, dtype, layout and that the data fits in a file of
+// length bytes. Returns MATRIX_ERR_FORMAT on any mismatch.
+matrix_err_t matrix_file_validate(matrix_file_header_t const* header,
+                                  uint64_t length);
+
+matrix_err_t matrix_save(matrix_t const* matrix, char const* path);
+
+// Maps path read-only and points matrix at the mapped data without copying.
+// The matrix is given an allocator that cannot allocate and whose deallocate
+// unmaps the file, so matrix_delete releases it and resizing fails with
+// MATRIX_ERR_ALLOC. Writing through matrix->data is undefined. verify
+// recomputes the checksum, which touches every page.
+matrix_err_t matrix_map(matrix_t* matrix, char const* path, bool verify);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_MATRIX_FILE_H
@@ -0,0 +1,585 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "matrix_ooc.h"
+#include "linalg_profile.h"
+#include "matrix_file.h"
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MATRIX_OOC_POSIX
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#ifdef MATRIX_OOC_POSIX
+
+#define MATRIX_OOC_CHECKSUM_CHUNK 8192UL
+
+typedef struct {
+    int descriptor;
+    dev_t device;
+    ino_t inode;
+    matrix_file_header_t header;
+} matrix_ooc_file_t;
+
+typedef struct {
+    matrix_data_t* tile1;
+    matrix_data_t* tile2;
+    bool full;
+} matrix_ooc_slot_t;
+
+typedef struct {
+    matrix_ooc_file_t file1;
+    matrix_ooc_file_t file2;
+    matrix_ooc_file_t product;
+    matrix_size_t tile_size;
+    matrix_size_t row_tiles;
+    matrix_size_t column_tiles;
+    matrix_size_t inner_tiles;
+    matrix_ooc_slot_t slots[2U];
+    matrix_data_t* tile;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    matrix_err_t reader_err;
+    bool cancelled;
+    matrix_ooc_stats_t reader_stats;
+    matrix_ooc_stats_t stats;
+} matrix_ooc_context_t;
+
+static double matrix_ooc_seconds(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (double)time.tv_sec + (double)time.tv_nsec * 1E-9;
+}
+
+static matrix_size_t matrix_ooc_min(matrix_size_t a, matrix_size_t b)
+{
+    return a < b ? a : b;
+}
+
+static bool matrix_ooc_pread(int descriptor,
+                             void* buffer,
+                             size_t size,
+                             uint64_t offset)
+{
+    unsigned char* bytes = buffer;
+    while (size > 0UL) {
+        ssize_t count = pread(descriptor, bytes, size, (off_t)offset);
+        if (count <= 0) {
+            return false;
+        }
+        bytes += count;
+        size -= (size_t)count;
+        offset += (uint64_t)count;
+    }
+
+    return true;
+}
+
+static bool matrix_ooc_pwrite(int descriptor,
+                              void const* buffer,
+                              size_t size,
+                              uint64_t offset)
+{
+    unsigned char const* bytes = buffer;
+    while (size > 0UL) {
+        ssize_t count = pwrite(descriptor, bytes, size, (off_t)offset);
+        if (count <= 0) {
+            return false;
+        }
+        bytes += count;
+        size -= (size_t)count;
+        offset += (uint64_t)count;
+    }
+
+    return true;
+}
+
+static uint64_t matrix_ooc_offset(matrix_ooc_file_t const* file,
+                                  matrix_size_t row,
+                                  matrix_size_t column)
+{
+    return file->header.data_offset +
+           sizeof(matrix_data_t) * (row * file->header.stride + column);
+}
+
+// Reads the rows x columns block at (row, column) into a dense tile.
+static bool matrix_ooc_read_tile(matrix_ooc_file_t const* file,
+                                 matrix_size_t row,
+                                 matrix_size_t column,
+                                 matrix_size_t rows,
+                                 matrix_size_t columns,
+                                 matrix_data_t* tile)
+{
+    for (matrix_size_t index = 0UL; index < rows; ++index) {
+        if (!matrix_ooc_pread(file->descriptor,
+                              tile + index * columns,
+                              sizeof(matrix_data_t) * columns,
+                              matrix_ooc_offset(file, row + index, column))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool matrix_ooc_write_tile(matrix_ooc_file_t const* file,
+                                  matrix_size_t row,
+                                  matrix_size_t column,
+                                  matrix_size_t rows,
+                                  matrix_size_t columns,
+                                  matrix_data_t const* tile)
+{
+    for (matrix_size_t index = 0UL; index < rows; ++index) {
+        if (!matrix_ooc_pwrite(file->descriptor,
+                               tile + index * columns,
+                               sizeof(matrix_data_t) * columns,
+                               matrix_ooc_offset(file, row + index, column))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void matrix_ooc_kernel(matrix_data_t const* tile1,
+                              matrix_data_t const* tile2,
+                              matrix_data_t* product,
+                              matrix_size_t rows,
+                              matrix_size_t inner,
+                              matrix_size_t columns)
+{
+    for (matrix_size_t row = 0UL; row < rows; ++row) {
+        matrix_data_t* product_row = product + row * columns;
+
+        for (matrix_size_t index = 0UL; index < inner; ++index) {
+            matrix_data_t value = tile1[row * inner + index];
+            matrix_data_t const* tile2_row = tile2 + index * columns;
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                product_row[column] += value * tile2_row[column];
+            }
+        }
+    }
+}
+
+// Step s multiplies tile (i, k) of the first operand by tile (k, j) of the
+// second, with k running fastest so each output tile completes in turn.
+static void matrix_ooc_step(matrix_ooc_context_t const* context,
+                            size_t step,
+                            matrix_size_t* row_tile,
+                            matrix_size_t* column_tile,
+                            matrix_size_t* inner_tile)
+{
+    *inner_tile = step % context->inner_tiles;
+    *column_tile = (step / context->inner_tiles) % context->column_tiles;
+    *row_tile = step / context->inner_tiles / context->column_tiles;
+}
+
+static void* matrix_ooc_reader(void* user)
+{
+    matrix_ooc_context_t* context = user;
+    matrix_size_t tile_size = context->tile_size;
+    size_t steps =
+        context->row_tiles * context->column_tiles * context->inner_tiles;
+
+    for (size_t step = 0UL; step < steps; ++step) {
+        matrix_ooc_slot_t* slot = &context->slots[step % 2UL];
+
+        pthread_mutex_lock(&context->mutex);
+        while (slot->full && !context->cancelled) {
+            pthread_cond_wait(&context->cond, &context->mutex);
+        }
+        bool cancelled = context->cancelled;
+        pthread_mutex_unlock(&context->mutex);
+        if (cancelled) {
+            break;
+        }
+
+        matrix_size_t row_tile, column_tile, inner_tile;
+        matrix_ooc_step(context, step, &row_tile, &column_tile, &inner_tile);
+
+        matrix_size_t row = row_tile * tile_size;
+        matrix_size_t column = column_tile * tile_size;
+        matrix_size_t inner = inner_tile * tile_size;
+        matrix_size_t rows =
+            matrix_ooc_min(tile_size, context->file1.header.rows - row);
+        matrix_size_t columns =
+            matrix_ooc_min(tile_size, context->file2.header.columns - column);
+        matrix_size_t inners =
+            matrix_ooc_min(tile_size, context->file1.header.columns - inner);
+
+        double start = matrix_ooc_seconds();
+        bool ok = matrix_ooc_read_tile(
+                      &context->file1, row, inner, rows, inners, slot->tile1) &&
+                  matrix_ooc_read_tile(&context->file2,
+                                       inner,
+                                       column,
+                                       inners,
+                                       columns,
+                                       slot->tile2);
+        context->reader_stats.io_seconds += matrix_ooc_seconds() - start;
+        context->reader_stats.bytes_read +=
+            sizeof(matrix_data_t) * inners * (rows + columns);
+
+        pthread_mutex_lock(&context->mutex);
+        if (ok) {
+            slot->full = true;
+        } else {
+            context->reader_err = MATRIX_ERR_IO;
+            context->cancelled = true;
+        }
+        pthread_cond_broadcast(&context->cond);
+        pthread_mutex_unlock(&context->mutex);
+        if (!ok) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static void matrix_ooc_cancel(matrix_ooc_context_t* context)
+{
+    pthread_mutex_lock(&context->mutex);
+    context->cancelled = true;
+    pthread_cond_broadcast(&context->cond);
+    pthread_mutex_unlock(&context->mutex);
+}
+
+static matrix_err_t matrix_ooc_compute(matrix_ooc_context_t* context)
+{
+    matrix_size_t tile_size = context->tile_size;
+    size_t steps =
+        context->row_tiles * context->column_tiles * context->inner_tiles;
+
+    for (size_t step = 0UL; step < steps; ++step) {
+        matrix_ooc_slot_t* slot = &context->slots[step % 2UL];
+
+        pthread_mutex_lock(&context->mutex);
+        while (!slot->full && !context->cancelled) {
+            pthread_cond_wait(&context->cond, &context->mutex);
+        }
+        bool full = slot->full;
+        pthread_mutex_unlock(&context->mutex);
+        if (!full) {
+            return context->reader_err;
+        }
+
+        matrix_size_t row_tile, column_tile, inner_tile;
+        matrix_ooc_step(context, step, &row_tile, &column_tile, &inner_tile);
+
+        matrix_size_t row = row_tile * tile_size;
+        matrix_size_t column = column_tile * tile_size;
+        matrix_size_t inner = inner_tile * tile_size;
+        matrix_size_t rows =
+            matrix_ooc_min(tile_size, context->file1.header.rows - row);
+        matrix_size_t columns =
+            matrix_ooc_min(tile_size, context->file2.header.columns - column);
+        matrix_size_t inners =
+            matrix_ooc_min(tile_size, context->file1.header.columns - inner);
+
+        if (inner_tile == 0UL) {
+            memset(context->tile, 0, sizeof(matrix_data_t) * rows * columns);
+        }
+
+        double start = matrix_ooc_seconds();
+        matrix_ooc_kernel(
+            slot->tile1, slot->tile2, context->tile, rows, inners, columns);
+        context->stats.compute_seconds += matrix_ooc_seconds() - start;
+        context->stats.flops += 2UL * rows * inners * columns;
+
+        pthread_mutex_lock(&context->mutex);
+        slot->full = false;
+        pthread_cond_broadcast(&context->cond);
+        pthread_mutex_unlock(&context->mutex);
+
+        if (inner_tile + 1UL == context->inner_tiles) {
+            start = matrix_ooc_seconds();
+            bool ok = matrix_ooc_write_tile(
+                &context->product, row, column, rows, columns, context->tile);
+            context->stats.io_seconds += matrix_ooc_seconds() - start;
+            if (!ok) {
+                matrix_ooc_cancel(context);
+                return MATRIX_ERR_IO;
+            }
+            context->stats.bytes_written +=
+                sizeof(matrix_data_t) * rows * columns;
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+static matrix_err_t matrix_ooc_open(matrix_ooc_file_t* file, char const* path)
+{
+    file->descriptor = open(path, O_RDONLY);
+    if (file->descriptor < 0) {
+        return MATRIX_ERR_IO;
+    }
+
+    struct stat status;
+    if (fstat(file->descriptor, &status) != 0 ||
+        !matrix_ooc_pread(
+            file->descriptor, &file->header, sizeof(file->header), 0UL)) {
+        return MATRIX_ERR_FORMAT;
+    }
+    file->device = status.st_dev;
+    file->inode = status.st_ino;
+
+    return matrix_file_validate(&file->header, (uint64_t)status.st_size);
+}
+
+static bool matrix_ooc_same(matrix_ooc_file_t const* file,
+                            struct stat const* status)
+{
+    return file->device == status->st_dev && file->inode == status->st_ino;
+}
+
+static matrix_err_t matrix_ooc_create(matrix_ooc_file_t* file,
+                                      char const* path,
+                                      matrix_ooc_file_t const* input1,
+                                      matrix_ooc_file_t const* input2)
+{
+    // O_TRUNC would wipe an input before it is read; device and inode also
+    // catch links and differently spelled paths.
+    struct stat status;
+    if (stat(path, &status) == 0 && (matrix_ooc_same(input1, &status) ||
+                                     matrix_ooc_same(input2, &status))) {
+        return MATRIX_ERR_FAIL;
+    }
+
+    file->descriptor = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file->descriptor < 0) {
+        return MATRIX_ERR_IO;
+    }
+
+    memset(&file->header, 0, sizeof(file->header));
+    memcpy(file->header.magic, MATRIX_FILE_MAGIC, sizeof(MATRIX_FILE_MAGIC));
+    file->header.version = MATRIX_FILE_VERSION;
+    file->header.dtype = MATRIX_FILE_DTYPE_FLOAT32;
+    file->header.rows = input1->header.rows;
+    file->header.columns = input2->header.columns;
+    file->header.stride = input2->header.columns;
+    file->header.alignment = MATRIX_FILE_ALIGNMENT;
+    file->header.data_offset =
+        (sizeof(file->header) + MATRIX_FILE_ALIGNMENT - 1U) /
+        MATRIX_FILE_ALIGNMENT * MATRIX_FILE_ALIGNMENT;
+
+    uint64_t length = file->header.data_offset + sizeof(matrix_data_t) *
+                                                     file->header.rows *
+                                                     file->header.columns;
+    if (ftruncate(file->descriptor, (off_t)length) != 0) {
+        return MATRIX_ERR_IO;
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+// The checksum covers the whole output in file order, which the tiled
+// write-back does not follow, so it is computed in a final streaming pass.
+static matrix_err_t matrix_ooc_finish(matrix_ooc_context_t* context)
+{
+    matrix_ooc_file_t* file = &context->product;
+    uint64_t size =
+        sizeof(matrix_data_t) * file->header.rows * file->header.columns;
+    uint64_t hash = MATRIX_FILE_CHECKSUM_SEED;
+    uint64_t buffer[MATRIX_OOC_CHECKSUM_CHUNK];
+
+    double start = matrix_ooc_seconds();
+    for (uint64_t offset = 0UL; offset < size; offset += sizeof(buffer)) {
+        size_t count = (size_t)(size - offset < sizeof(buffer)
+                                    ? size - offset
+                                    : sizeof(buffer));
+        if (!matrix_ooc_pread(file->descriptor,
+                              buffer,
+                              count,
+                              file->header.data_offset + offset)) {
+            return MATRIX_ERR_IO;
+        }
+        hash = matrix_file_checksum(hash, buffer, count);
+    }
+    file->header.checksum = hash;
+
+    bool ok = matrix_ooc_pwrite(
+        file->descriptor, &file->header, sizeof(file->header), 0UL);
+    context->stats.io_seconds += matrix_ooc_seconds() - start;
+    context->stats.bytes_read += size;
+    context->stats.bytes_written += sizeof(file->header);
+
+    return ok ? MATRIX_ERR_OK : MATRIX_ERR_IO;
+}
+
+static matrix_err_t matrix_ooc_run(matrix_ooc_context_t* context)
+{
+    if (pthread_mutex_init(&context->mutex, NULL) != 0) {
+        return MATRIX_ERR_FAIL;
+    }
+    if (pthread_cond_init(&context->cond, NULL) != 0) {
+        pthread_mutex_destroy(&context->mutex);
+        return MATRIX_ERR_FAIL;
+    }
+
+    pthread_t reader;
+    matrix_err_t err = MATRIX_ERR_FAIL;
+    if (pthread_create(&reader, NULL, matrix_ooc_reader, context) == 0) {
+        err = matrix_ooc_compute(context);
+        pthread_join(reader, NULL);
+    }
+
+    pthread_cond_destroy(&context->cond);
+    pthread_mutex_destroy(&context->mutex);
+
+    context->stats.bytes_read += context->reader_stats.bytes_read;
+    context->stats.io_seconds += context->reader_stats.io_seconds;
+
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    return matrix_ooc_finish(context);
+}
+
+static void matrix_ooc_close(matrix_ooc_file_t* file)
+{
+    if (file->descriptor >= 0) {
+        close(file->descriptor);
+    }
+}
+
+#endif // MATRIX_OOC_POSIX
+
+matrix_err_t matrix_ooc_product(char const* path1,
+                                char const* path2,
+                                char const* product_path,
+                                matrix_size_t tile_size,
+                                matrix_allocator_t const* allocator,
+                                matrix_ooc_stats_t* stats)
+{
+    if (path1 == NULL || path2 == NULL || product_path == NULL ||
+        allocator == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_ooc_product, 0, 0);
+
+#ifdef MATRIX_OOC_POSIX
+    if (tile_size == 0UL || allocator->allocate == NULL ||
+        allocator->deallocate == NULL) {
+        return MATRIX_ERR_FAIL;
+    }
+
+    matrix_ooc_context_t context;
+    memset(&context, 0, sizeof(context));
+    context.file1.descriptor = -1;
+    context.file2.descriptor = -1;
+    context.product.descriptor = -1;
+    context.tile_size = tile_size;
+
+    double start = matrix_ooc_seconds();
+
+    matrix_err_t err = matrix_ooc_open(&context.file1, path1);
+    if (err == MATRIX_ERR_OK) {
+        err = matrix_ooc_open(&context.file2, path2);
+    }
+    if (err == MATRIX_ERR_OK &&
+        context.file1.header.columns != context.file2.header.rows) {
+        err = MATRIX_ERR_DIMENSION;
+    }
+    if (err == MATRIX_ERR_OK) {
+        err = matrix_ooc_create(&context.product,
+                                product_path,
+                                &context.file1,
+                                &context.file2);
+    }
+
+    size_t tile_bytes = sizeof(matrix_data_t) * tile_size * tile_size;
+    matrix_data_t** buffers[] = {
+        &context.slots[0].tile1,
+        &context.slots[0].tile2,
+        &context.slots[1].tile1,
+        &context.slots[1].tile2,
+        &context.tile,
+    };
+    for (size_t index = 0UL;
+         err == MATRIX_ERR_OK && index < sizeof(buffers) / sizeof(*buffers);
+         ++index) {
+        *buffers[index] = allocator->allocate(allocator->user, tile_bytes);
+        if (*buffers[index] == NULL) {
+            err = MATRIX_ERR_ALLOC;
+        }
+    }
+
+    if (err == MATRIX_ERR_OK) {
+        context.row_tiles =
+            (context.file1.header.rows + tile_size - 1UL) / tile_size;
+        context.column_tiles =
+            (context.file2.header.columns + tile_size - 1UL) / tile_size;
+        context.inner_tiles =
+            (context.file1.header.columns + tile_size - 1UL) / tile_size;
+
+        err = matrix_ooc_run(&context);
+    }
+
+    for (size_t index = 0UL; index < sizeof(buffers) / sizeof(*buffers);
+         ++index) {
+        if (*buffers[index] != NULL) {
+            allocator->deallocate(allocator->user, *buffers[index]);
+        }
+    }
+
+    matrix_ooc_close(&context.file1);
+    matrix_ooc_close(&context.file2);
+    matrix_ooc_close(&context.product);
+
+    context.stats.wall_seconds = matrix_ooc_seconds() - start;
+    if (stats != NULL) {
+        memcpy(stats, &context.stats, sizeof(*stats));
+    }
+
+    return err;
+#else
+    (void)tile_size;
+    (void)stats;
+
+    return MATRIX_ERR_FAIL;
+#endif
+}
+
+matrix_err_t matrix_ooc_stats_print(matrix_ooc_stats_t const* stats,
+                                    FILE* stream)
+{
+    if (stats == NULL || stream == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    double io_rate = stats->io_seconds > 0.0
+                         ? (double)(stats->bytes_read + stats->bytes_written) /
+                               stats->io_seconds * 1E-9
+                         : 0.0;
+    double compute_rate = stats->compute_seconds > 0.0
+                              ? (double)stats->flops /
+                                    stats->compute_seconds * 1E-9
+                              : 0.0;
+
+    fprintf(stream,
+            "read %llu B, written %llu B, io %.3f s (%.3f GB/s)\n",
+            (unsigned long long)stats->bytes_read,
+            (unsigned long long)stats->bytes_written,
+            stats->io_seconds,
+            io_rate);
+    fprintf(stream,
+            "flops %llu, compute %.3f s (%.3f GFLOP/s), wall %.3f s\n",
+            (unsigned long long)stats->flops,
+            stats->compute_seconds,
+            compute_rate,
+            stats->wall_seconds);
+
+    return MATRIX_ERR_OK;
+}
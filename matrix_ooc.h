@@ -0,0 +1,42 @@
+#ifndef LINALG_MATRIX_OOC_H
+#define LINALG_MATRIX_OOC_H
+
+#include "matrix.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    uint64_t flops;
+    double io_seconds;
+    double compute_seconds;
+    double wall_seconds;
+} matrix_ooc_stats_t;
+
+// Multiplies two matrix files written by matrix_save into product_path
+// without holding more than five tile_size x tile_size tiles in memory. A
+// reader thread prefetches the next pair of input tiles while the calling
+// thread multiplies the current pair; output tiles are written back as they
+// complete. Tile buffers come from allocator. stats may be NULL.
+// product_path must not name either input file, which fails with
+// MATRIX_ERR_FAIL.
+matrix_err_t matrix_ooc_product(char const* path1,
+                                char const* path2,
+                                char const* product_path,
+                                matrix_size_t tile_size,
+                                matrix_allocator_t const* allocator,
+                                matrix_ooc_stats_t* stats);
+
+matrix_err_t matrix_ooc_stats_print(matrix_ooc_stats_t const* stats,
+                                    FILE* stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_MATRIX_OOC_H
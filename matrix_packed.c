@@ -0,0 +1,533 @@
+#include "matrix_packed.h"
+#include "linalg_profile.h"
+#include <string.h>
+
+static matrix_data_t* matrix_packed_allocate(
+    matrix_allocator_t const* allocator,
+    matrix_size_t size)
+{
+    if (allocator->allocate == NULL) {
+        return NULL;
+    }
+
+    return allocator->allocate(allocator->user,
+                               sizeof(matrix_data_t) *
+                                   MATRIX_PACKED_LENGTH(size));
+}
+
+static void matrix_packed_deallocate(matrix_allocator_t const* allocator,
+                                     matrix_data_t* data)
+{
+    if (allocator->deallocate == NULL || data == NULL) {
+        return;
+    }
+
+    allocator->deallocate(allocator->user, data);
+}
+
+static matrix_err_t matrix_packed_resize(matrix_data_t** data,
+                                         matrix_size_t* size,
+                                         matrix_allocator_t const* allocator,
+                                         matrix_size_t new_size)
+{
+    if (*data != NULL && *size == new_size) {
+        return MATRIX_ERR_OK;
+    }
+
+    matrix_data_t* new_data = matrix_packed_allocate(allocator, new_size);
+    if (new_data == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    matrix_packed_deallocate(allocator, *data);
+
+    *data = new_data;
+    *size = new_size;
+
+    return MATRIX_ERR_OK;
+}
+
+static void matrix_packed_pack(matrix_t const* matrix, matrix_data_t* data)
+{
+    for (matrix_size_t row = 0UL; row < matrix->rows; ++row) {
+        memcpy(&data[MATRIX_PACKED_LENGTH(row)],
+               &MATRIX_INDEX(matrix, row, 0UL),
+               sizeof(matrix_data_t) * (row + 1UL));
+    }
+}
+
+matrix_err_t matrix_sym_initialize(matrix_sym_t* sym,
+                                   matrix_allocator_t const* allocator)
+{
+    if (sym == NULL || allocator == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_sym_initialize, 0, 0);
+
+    memset(sym, 0, sizeof(*sym));
+    sym->allocator = *allocator;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_sym_create(matrix_sym_t* sym, matrix_size_t size)
+{
+    if (sym == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_sym_create, 0, 0);
+
+    matrix_data_t* data = matrix_packed_allocate(&sym->allocator, size);
+    if (data == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    sym->data = data;
+    sym->size = size;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_sym_delete(matrix_sym_t* sym)
+{
+    if (sym == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_sym_delete, 0, 0);
+
+    matrix_packed_deallocate(&sym->allocator, sym->data);
+
+    sym->data = NULL;
+    sym->size = 0UL;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_sym_resize(matrix_sym_t* sym, matrix_size_t size)
+{
+    if (sym == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_sym_resize, 0, 0);
+
+    return matrix_packed_resize(&sym->data,
+                                &sym->size,
+                                &sym->allocator,
+                                size);
+}
+
+matrix_err_t matrix_sym_from_matrix(matrix_t const* matrix, matrix_sym_t* sym)
+{
+    if (matrix == NULL || sym == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_sym_from_matrix,
+        0,
+        2UL * sizeof(matrix_data_t) * MATRIX_PACKED_LENGTH(matrix->rows));
+
+    if (matrix->rows != matrix->columns) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_err_t err = matrix_sym_resize(sym, matrix->rows);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    matrix_packed_pack(matrix, sym->data);
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_sym_to_matrix(matrix_sym_t const* sym, matrix_t* matrix)
+{
+    if (sym == NULL || matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_sym_to_matrix,
+                            0,
+                            sizeof(matrix_data_t) *
+                                (MATRIX_PACKED_LENGTH(sym->size) +
+                                 sym->size * sym->size));
+
+    matrix_err_t err = matrix_resize(matrix, sym->size, sym->size);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    for (matrix_size_t row = 0UL; row < sym->size; ++row) {
+        for (matrix_size_t column = 0UL; column <= row; ++column) {
+            matrix_data_t value = MATRIX_PACKED_INDEX(sym, row, column);
+
+            MATRIX_INDEX(matrix, row, column) = value;
+            MATRIX_INDEX(matrix, column, row) = value;
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_sym_product(matrix_sym_t const* sym,
+                                matrix_t const* matrix,
+                                matrix_t* product)
+{
+    if (sym == NULL || matrix == NULL || product == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    if (product == matrix) {
+        return MATRIX_ERR_FAIL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_sym_product,
+        2UL * sym->size * sym->size * matrix->columns,
+        sizeof(matrix_data_t) * (MATRIX_PACKED_LENGTH(sym->size) +
+                                 2UL * matrix->rows * matrix->columns));
+
+    if (sym->size != matrix->rows) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_err_t err = matrix_resize(product, matrix->rows, matrix->columns);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    matrix_size_t columns = matrix->columns;
+
+    memset(product->data,
+           0,
+           sizeof(matrix_data_t) * product->rows * product->columns);
+
+    // Each stored element below the diagonal is used twice, once for its
+    // own row and once for its mirror, so the packed data is read once.
+    for (matrix_size_t row = 0UL; row < sym->size; ++row) {
+        matrix_data_t const* packed_row = &MATRIX_PACKED_INDEX(sym, row, 0UL);
+        matrix_data_t* product_row = &MATRIX_INDEX(product, row, 0UL);
+        matrix_data_t const* matrix_row = &MATRIX_INDEX(matrix, row, 0UL);
+
+        for (matrix_size_t k = 0UL; k < row; ++k) {
+            matrix_data_t value = packed_row[k];
+            matrix_data_t* product_k = &MATRIX_INDEX(product, k, 0UL);
+            matrix_data_t const* matrix_k = &MATRIX_INDEX(matrix, k, 0UL);
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                product_row[column] += value * matrix_k[column];
+                product_k[column] += value * matrix_row[column];
+            }
+        }
+
+        matrix_data_t diagonal = packed_row[row];
+        for (matrix_size_t column = 0UL; column < columns; ++column) {
+            product_row[column] += diagonal * matrix_row[column];
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_sym_rank_update(matrix_sym_t* sym,
+                                    matrix_data_t scalar,
+                                    matrix_t const* matrix,
+                                    matrix_op_t op)
+{
+    if (sym == NULL || matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    matrix_size_t common =
+        op == MATRIX_OP_TRANSPOSE ? matrix->rows : matrix->columns;
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_sym_rank_update,
+        sym->size * (sym->size + 1UL) * common,
+        sizeof(matrix_data_t) * (2UL * MATRIX_PACKED_LENGTH(sym->size) +
+                                 matrix->rows * matrix->columns));
+
+    if (sym->size !=
+        (op == MATRIX_OP_TRANSPOSE ? matrix->columns : matrix->rows)) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    if (op == MATRIX_OP_TRANSPOSE) {
+        for (matrix_size_t k = 0UL; k < common; ++k) {
+            matrix_data_t const* matrix_k = &MATRIX_INDEX(matrix, k, 0UL);
+
+            for (matrix_size_t row = 0UL; row < sym->size; ++row) {
+                matrix_data_t* packed_row =
+                    &MATRIX_PACKED_INDEX(sym, row, 0UL);
+                matrix_data_t factor = scalar * matrix_k[row];
+
+                for (matrix_size_t column = 0UL; column <= row; ++column) {
+                    packed_row[column] += factor * matrix_k[column];
+                }
+            }
+        }
+
+        return MATRIX_ERR_OK;
+    }
+
+    for (matrix_size_t row = 0UL; row < sym->size; ++row) {
+        matrix_data_t* packed_row = &MATRIX_PACKED_INDEX(sym, row, 0UL);
+        matrix_data_t const* matrix_row = &MATRIX_INDEX(matrix, row, 0UL);
+
+        for (matrix_size_t column = 0UL; column <= row; ++column) {
+            matrix_data_t const* matrix_column =
+                &MATRIX_INDEX(matrix, column, 0UL);
+            matrix_data_t sum = 0.0F;
+
+            for (matrix_size_t k = 0UL; k < common; ++k) {
+                sum += matrix_row[k] * matrix_column[k];
+            }
+
+            packed_row[column] += scalar * sum;
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_sym_cholesky(matrix_sym_t const* sym, matrix_tri_t* tri)
+{
+    if (sym == NULL || tri == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_sym_cholesky,
+        sym->size * sym->size * sym->size / 3UL,
+        2UL * sizeof(matrix_data_t) * MATRIX_PACKED_LENGTH(sym->size));
+
+    matrix_err_t err = matrix_tri_resize(tri, sym->size);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    // Row-oriented (Cholesky-Banachiewicz) so every dot product runs over
+    // two contiguous packed rows.
+    for (matrix_size_t row = 0UL; row < sym->size; ++row) {
+        matrix_data_t* factor_row = &MATRIX_PACKED_INDEX(tri, row, 0UL);
+
+        for (matrix_size_t column = 0UL; column <= row; ++column) {
+            matrix_data_t const* factor_column =
+                &MATRIX_PACKED_INDEX(tri, column, 0UL);
+            matrix_data_t sum = MATRIX_PACKED_INDEX(sym, row, column);
+
+            for (matrix_size_t k = 0UL; k < column; ++k) {
+                sum -= factor_row[k] * factor_column[k];
+            }
+
+            if (column < row) {
+                factor_row[column] = sum / factor_column[column];
+            } else if (sum > 0.0F) {
+                factor_row[column] = sqrtf(sum);
+            } else {
+                return MATRIX_ERR_SINGULAR;
+            }
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_tri_initialize(matrix_tri_t* tri,
+                                   matrix_allocator_t const* allocator)
+{
+    if (tri == NULL || allocator == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_tri_initialize, 0, 0);
+
+    memset(tri, 0, sizeof(*tri));
+    tri->allocator = *allocator;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_tri_create(matrix_tri_t* tri, matrix_size_t size)
+{
+    if (tri == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_tri_create, 0, 0);
+
+    matrix_data_t* data = matrix_packed_allocate(&tri->allocator, size);
+    if (data == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    tri->data = data;
+    tri->size = size;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_tri_delete(matrix_tri_t* tri)
+{
+    if (tri == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_tri_delete, 0, 0);
+
+    matrix_packed_deallocate(&tri->allocator, tri->data);
+
+    tri->data = NULL;
+    tri->size = 0UL;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_tri_resize(matrix_tri_t* tri, matrix_size_t size)
+{
+    if (tri == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_tri_resize, 0, 0);
+
+    return matrix_packed_resize(&tri->data,
+                                &tri->size,
+                                &tri->allocator,
+                                size);
+}
+
+matrix_err_t matrix_tri_from_matrix(matrix_t const* matrix, matrix_tri_t* tri)
+{
+    if (matrix == NULL || tri == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_tri_from_matrix,
+        0,
+        2UL * sizeof(matrix_data_t) * MATRIX_PACKED_LENGTH(matrix->rows));
+
+    if (matrix->rows != matrix->columns) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    matrix_err_t err = matrix_tri_resize(tri, matrix->rows);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    matrix_packed_pack(matrix, tri->data);
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_tri_to_matrix(matrix_tri_t const* tri, matrix_t* matrix)
+{
+    if (tri == NULL || matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_tri_to_matrix,
+                            0,
+                            sizeof(matrix_data_t) *
+                                (MATRIX_PACKED_LENGTH(tri->size) +
+                                 tri->size * tri->size));
+
+    matrix_err_t err = matrix_resize(matrix, tri->size, tri->size);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    for (matrix_size_t row = 0UL; row < tri->size; ++row) {
+        matrix_data_t* matrix_row = &MATRIX_INDEX(matrix, row, 0UL);
+
+        memcpy(matrix_row,
+               &MATRIX_PACKED_INDEX(tri, row, 0UL),
+               sizeof(matrix_data_t) * (row + 1UL));
+        memset(&matrix_row[row + 1UL],
+               0,
+               sizeof(matrix_data_t) * (tri->size - row - 1UL));
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_tri_solve(matrix_tri_t const* tri,
+                              matrix_op_t op,
+                              matrix_t* matrix)
+{
+    if (tri == NULL || matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_tri_solve,
+        tri->size * tri->size * matrix->columns,
+        sizeof(matrix_data_t) * (MATRIX_PACKED_LENGTH(tri->size) +
+                                 2UL * matrix->rows * matrix->columns));
+
+    if (tri->size != matrix->rows) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    for (matrix_size_t row = 0UL; row < tri->size; ++row) {
+        if (MATRIX_PACKED_INDEX(tri, row, row) == 0.0F) {
+            return MATRIX_ERR_SINGULAR;
+        }
+    }
+
+    matrix_size_t columns = matrix->columns;
+
+    if (op == MATRIX_OP_TRANSPOSE) {
+        // L^T X = B: once row r of X is final it is eliminated from every
+        // row above it using packed row r, which holds column r of L^T.
+        for (matrix_size_t row = tri->size; row-- > 0UL;) {
+            matrix_data_t const* packed_row =
+                &MATRIX_PACKED_INDEX(tri, row, 0UL);
+            matrix_data_t* solution_row = &MATRIX_INDEX(matrix, row, 0UL);
+            matrix_data_t inverse = 1.0F / packed_row[row];
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                solution_row[column] *= inverse;
+            }
+
+            for (matrix_size_t k = 0UL; k < row; ++k) {
+                matrix_data_t value = packed_row[k];
+                matrix_data_t* target_row = &MATRIX_INDEX(matrix, k, 0UL);
+
+                for (matrix_size_t column = 0UL; column < columns; ++column) {
+                    target_row[column] -= value * solution_row[column];
+                }
+            }
+        }
+
+        return MATRIX_ERR_OK;
+    }
+
+    for (matrix_size_t row = 0UL; row < tri->size; ++row) {
+        matrix_data_t const* packed_row = &MATRIX_PACKED_INDEX(tri, row, 0UL);
+        matrix_data_t* solution_row = &MATRIX_INDEX(matrix, row, 0UL);
+
+        for (matrix_size_t k = 0UL; k < row; ++k) {
+            matrix_data_t value = packed_row[k];
+            matrix_data_t const* source_row = &MATRIX_INDEX(matrix, k, 0UL);
+
+            for (matrix_size_t column = 0UL; column < columns; ++column) {
+                solution_row[column] -= value * source_row[column];
+            }
+        }
+
+        matrix_data_t inverse = 1.0F / packed_row[row];
+        for (matrix_size_t column = 0UL; column < columns; ++column) {
+            solution_row[column] *= inverse;
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
@@ -0,0 +1,88 @@
+#ifndef LINALG_MATRIX_PACKED_H
+#define LINALG_MATRIX_PACKED_H
+
+#include "matrix.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Both packed types store the lower triangle row by row, so row r starts at
+// r (r + 1) / 2 and is contiguous. Valid only for COLUMN <= ROW.
+#define MATRIX_PACKED_INDEX(PACKED, ROW, COLUMN) \
+    ((PACKED)->data[(ROW) * ((ROW) + 1UL) / 2UL + (COLUMN)])
+
+#define MATRIX_PACKED_LENGTH(SIZE) ((SIZE) * ((SIZE) + 1UL) / 2UL)
+
+// Symmetric size x size matrix holding only its lower triangle.
+typedef struct {
+    matrix_data_t* data;
+    matrix_size_t size;
+    matrix_allocator_t allocator;
+} matrix_sym_t;
+
+// Lower triangular size x size matrix. Upper triangular factors are used as
+// the transpose of a lower one through matrix_op_t.
+typedef struct {
+    matrix_data_t* data;
+    matrix_size_t size;
+    matrix_allocator_t allocator;
+} matrix_tri_t;
+
+matrix_err_t matrix_sym_initialize(matrix_sym_t* sym,
+                                   matrix_allocator_t const* allocator);
+
+matrix_err_t matrix_sym_create(matrix_sym_t* sym, matrix_size_t size);
+
+matrix_err_t matrix_sym_delete(matrix_sym_t* sym);
+
+matrix_err_t matrix_sym_resize(matrix_sym_t* sym, matrix_size_t size);
+
+// Packs the lower triangle of a square matrix; the upper one is not read.
+matrix_err_t matrix_sym_from_matrix(matrix_t const* matrix, matrix_sym_t* sym);
+
+matrix_err_t matrix_sym_to_matrix(matrix_sym_t const* sym, matrix_t* matrix);
+
+// product = sym * matrix. product must not be matrix, which fails with
+// MATRIX_ERR_FAIL.
+matrix_err_t matrix_sym_product(matrix_sym_t const* sym,
+                                matrix_t const* matrix,
+                                matrix_t* product);
+
+// sym += scalar * matrix * matrix^T, or scalar * matrix^T * matrix for
+// MATRIX_OP_TRANSPOSE.
+matrix_err_t matrix_sym_rank_update(matrix_sym_t* sym,
+                                    matrix_data_t scalar,
+                                    matrix_t const* matrix,
+                                    matrix_op_t op);
+
+// Factors sym = L L^T into tri. Returns MATRIX_ERR_SINGULAR if sym is not
+// positive definite.
+matrix_err_t matrix_sym_cholesky(matrix_sym_t const* sym, matrix_tri_t* tri);
+
+matrix_err_t matrix_tri_initialize(matrix_tri_t* tri,
+                                   matrix_allocator_t const* allocator);
+
+matrix_err_t matrix_tri_create(matrix_tri_t* tri, matrix_size_t size);
+
+matrix_err_t matrix_tri_delete(matrix_tri_t* tri);
+
+matrix_err_t matrix_tri_resize(matrix_tri_t* tri, matrix_size_t size);
+
+// Packs the lower triangle of a square matrix; the upper one is not read.
+matrix_err_t matrix_tri_from_matrix(matrix_t const* matrix, matrix_tri_t* tri);
+
+// Unpacks with zeros above the diagonal.
+matrix_err_t matrix_tri_to_matrix(matrix_tri_t const* tri, matrix_t* matrix);
+
+// Overwrites matrix with the solution X of op(tri) X = matrix by forward or
+// back substitution. Returns MATRIX_ERR_SINGULAR on a zero diagonal element.
+matrix_err_t matrix_tri_solve(matrix_tri_t const* tri,
+                              matrix_op_t op,
+                              matrix_t* matrix);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_MATRIX_PACKED_H
@@ -0,0 +1,212 @@
+#include "matrix_sparse.h"
+#include "linalg_profile.h"
+#include <string.h>
+
+// Values come first in the allocation, padded so the index arrays after
+// them are aligned.
+static matrix_size_t matrix_csr_values_length(matrix_size_t nonzeros)
+{
+    matrix_size_t ratio = sizeof(matrix_size_t) / sizeof(matrix_data_t);
+
+    return (nonzeros + ratio - 1UL) / ratio * ratio;
+}
+
+matrix_err_t matrix_csr_initialize(matrix_csr_t* csr,
+                                   matrix_allocator_t const* allocator)
+{
+    if (csr == NULL || allocator == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_csr_initialize, 0, 0);
+
+    memset(csr, 0, sizeof(*csr));
+    csr->allocator = *allocator;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_csr_create(matrix_csr_t* csr,
+                               matrix_size_t rows,
+                               matrix_size_t columns,
+                               matrix_size_t nonzeros)
+{
+    if (csr == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    matrix_size_t values_length = matrix_csr_values_length(nonzeros);
+    matrix_size_t bytes = sizeof(matrix_data_t) * values_length +
+                          sizeof(matrix_size_t) * (rows + 1UL + nonzeros);
+
+    LINALG_PROFILE_FUNCTION(matrix_csr_create, 0, bytes);
+
+    if (csr->allocator.allocate == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    matrix_data_t* data = csr->allocator.allocate(csr->allocator.user, bytes);
+    if (data == NULL) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    memset(data, 0, bytes);
+
+    csr->data = data;
+    csr->row_offsets = (matrix_size_t*)(void*)(data + values_length);
+    csr->column_indices = csr->row_offsets + rows + 1UL;
+    csr->rows = rows;
+    csr->columns = columns;
+    csr->nonzeros = nonzeros;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_csr_delete(matrix_csr_t* csr)
+{
+    if (csr == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(matrix_csr_delete, 0, 0);
+
+    if (csr->data != NULL && csr->allocator.deallocate != NULL) {
+        csr->allocator.deallocate(csr->allocator.user, csr->data);
+    }
+
+    csr->data = NULL;
+    csr->column_indices = NULL;
+    csr->row_offsets = NULL;
+    csr->rows = 0UL;
+    csr->columns = 0UL;
+    csr->nonzeros = 0UL;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_csr_from_matrix(matrix_t const* matrix, matrix_csr_t* csr)
+{
+    if (matrix == NULL || csr == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_csr_from_matrix,
+        0,
+        2UL * sizeof(matrix_data_t) * matrix->rows * matrix->columns);
+
+    matrix_size_t nonzeros = 0UL;
+    for (matrix_size_t index = 0UL; index < matrix->rows * matrix->columns;
+         ++index) {
+        nonzeros += matrix->data[index] != 0.0F ? 1UL : 0UL;
+    }
+
+    // Built aside so that csr survives a failed allocation.
+    matrix_csr_t temp;
+    matrix_csr_initialize(&temp, &csr->allocator);
+
+    matrix_err_t err =
+        matrix_csr_create(&temp, matrix->rows, matrix->columns, nonzeros);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    matrix_size_t entry = 0UL;
+
+    for (matrix_size_t row = 0UL; row < matrix->rows; ++row) {
+        temp.row_offsets[row] = entry;
+
+        for (matrix_size_t column = 0UL; column < matrix->columns; ++column) {
+            matrix_data_t value = MATRIX_INDEX(matrix, row, column);
+
+            if (value != 0.0F) {
+                temp.data[entry] = value;
+                temp.column_indices[entry] = column;
+                ++entry;
+            }
+        }
+    }
+
+    temp.row_offsets[matrix->rows] = entry;
+
+    matrix_csr_delete(csr);
+    *csr = temp;
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_csr_to_matrix(matrix_csr_t const* csr, matrix_t* matrix)
+{
+    if (csr == NULL || matrix == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_csr_to_matrix,
+        0,
+        sizeof(matrix_data_t) * csr->rows * csr->columns +
+            (sizeof(matrix_data_t) + sizeof(matrix_size_t)) * csr->nonzeros);
+
+    matrix_err_t err = matrix_resize(matrix, csr->rows, csr->columns);
+    if (err != MATRIX_ERR_OK) {
+        return err;
+    }
+
+    memset(matrix->data,
+           0,
+           sizeof(matrix_data_t) * csr->rows * csr->columns);
+
+    for (matrix_size_t row = 0UL; row < csr->rows; ++row) {
+        for (matrix_size_t entry = csr->row_offsets[row];
+             entry < csr->row_offsets[row + 1UL];
+             ++entry) {
+            MATRIX_INDEX(matrix, row, csr->column_indices[entry]) =
+                csr->data[entry];
+        }
+    }
+
+    return MATRIX_ERR_OK;
+}
+
+matrix_err_t matrix_csr_vector_product(matrix_csr_t const* csr,
+                                       vector_t const* vector,
+                                       vector_t* product)
+{
+    if (csr == NULL || vector == NULL || product == NULL) {
+        return MATRIX_ERR_NULL;
+    }
+
+    if (product == vector) {
+        return MATRIX_ERR_FAIL;
+    }
+
+    LINALG_PROFILE_FUNCTION(
+        matrix_csr_vector_product,
+        2UL * csr->nonzeros,
+        (sizeof(matrix_data_t) + sizeof(matrix_size_t)) * csr->nonzeros +
+            sizeof(vector_data_t) * (csr->rows + csr->columns));
+
+    if (csr->columns != vector->size) {
+        return MATRIX_ERR_DIMENSION;
+    }
+
+    if (vector_resize(product, csr->rows) != VECTOR_ERR_OK) {
+        return MATRIX_ERR_ALLOC;
+    }
+
+    vector_data_t const* x = vector->data;
+
+    for (matrix_size_t row = 0UL; row < csr->rows; ++row) {
+        matrix_data_t sum = 0.0F;
+
+        for (matrix_size_t entry = csr->row_offsets[row];
+             entry < csr->row_offsets[row + 1UL];
+             ++entry) {
+            sum += csr->data[entry] * x[csr->column_indices[entry]];
+        }
+
+        product->data[row] = sum;
+    }
+
+    return MATRIX_ERR_OK;
+}
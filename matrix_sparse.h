@@ -0,0 +1,52 @@
+#ifndef LINALG_MATRIX_SPARSE_H
+#define LINALG_MATRIX_SPARSE_H
+
+#include "matrix.h"
+#include "vector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Compressed sparse row matrix. The entries of row r are
+// data[row_offsets[r] .. row_offsets[r + 1]) with their columns in
+// column_indices, sorted in increasing order within each row. Values,
+// offsets and indices share one allocation that starts at data.
+typedef struct {
+    matrix_data_t* data;
+    matrix_size_t* column_indices;
+    matrix_size_t* row_offsets;
+    matrix_size_t rows;
+    matrix_size_t columns;
+    matrix_size_t nonzeros;
+    matrix_allocator_t allocator;
+} matrix_csr_t;
+
+matrix_err_t matrix_csr_initialize(matrix_csr_t* csr,
+                                   matrix_allocator_t const* allocator);
+
+// Creates a matrix with room for nonzeros entries and every row empty, to
+// be filled in through row_offsets, column_indices and data.
+matrix_err_t matrix_csr_create(matrix_csr_t* csr,
+                               matrix_size_t rows,
+                               matrix_size_t columns,
+                               matrix_size_t nonzeros);
+
+matrix_err_t matrix_csr_delete(matrix_csr_t* csr);
+
+// Copies the nonzero elements of a dense matrix.
+matrix_err_t matrix_csr_from_matrix(matrix_t const* matrix, matrix_csr_t* csr);
+
+matrix_err_t matrix_csr_to_matrix(matrix_csr_t const* csr, matrix_t* matrix);
+
+// product = csr * vector. product is resized and must not be vector, which
+// fails with MATRIX_ERR_FAIL.
+matrix_err_t matrix_csr_vector_product(matrix_csr_t const* csr,
+                                       vector_t const* vector,
+                                       vector_t* product);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_MATRIX_SPARSE_H
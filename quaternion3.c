@@ -1,4 +1,6 @@
 #include "quaternion3.h"
+#include "linalg_profile.h"
+#include "linalg_rsqrt.h"
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
@@ -9,6 +11,8 @@ quaternion3_err_t quaternion3_fill_with_zeros(quaternion3_t* quaternion)
         return QUATERNION3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(quaternion3_fill_with_zeros, 0, 16UL);
+
     memset(quaternion, 0, sizeof(*quaternion));
 
     return QUATERNION3_ERR_OK;
@@ -24,6 +28,8 @@ quaternion3_err_t quaternion3_fill_with_elements(quaternion3_t* quaternion,
         return QUATERNION3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(quaternion3_fill_with_elements, 0, 16UL);
+
     quaternion->w = w;
     quaternion->x = x;
     quaternion->y = y;
@@ -40,6 +46,8 @@ quaternion3_err_t quaternion3_sum(quaternion3_t const* quaternion1,
         return QUATERNION3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(quaternion3_sum, 4UL, 48UL);
+
     sum->w = quaternion1->w + quaternion2->w;
     sum->x = quaternion1->x + quaternion2->x;
     sum->y = quaternion1->y + quaternion2->y;
@@ -56,6 +64,8 @@ quaternion3_err_t quaternion3_difference(quaternion3_t const* quaternion1,
         return QUATERNION3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(quaternion3_difference, 4UL, 48UL);
+
     difference->w = quaternion1->w - quaternion2->w;
     difference->x = quaternion1->x - quaternion2->x;
     difference->y = quaternion1->y - quaternion2->y;
@@ -72,6 +82,8 @@ quaternion3_err_t quaternion3_hamilton(quaternion3_t const* quaternion1,
         return QUATERNION3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(quaternion3_hamilton, 28UL, 48UL);
+
     hamilton->w =
         quaternion1->w * quaternion2->w - quaternion1->x * quaternion2->x -
         quaternion1->y * quaternion2->y - quaternion1->z * quaternion2->z;
@@ -99,6 +111,8 @@ quaternion3_err_t quaternion3_scale(quaternion3_t const* quaternion,
         return QUATERNION3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(quaternion3_scale, 4UL, 32UL);
+
     scale->w = quaternion->w * scalar;
     scale->x = quaternion->x * scalar;
     scale->y = quaternion->y * scalar;
@@ -114,6 +128,8 @@ quaternion3_err_t quaternion3_conjugate(quaternion3_t const* quaternion,
         return QUATERNION3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(quaternion3_conjugate, 3UL, 32UL);
+
     conjugate->w = quaternion->w;
     conjugate->x = -quaternion->x;
     conjugate->y = -quaternion->y;
@@ -129,6 +145,8 @@ quaternion3_err_t quaternion3_inverse(quaternion3_t const* quaternion,
         return QUATERNION3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(quaternion3_inverse, 11UL, 32UL);
+
     quaternion3_data_t mag_sq =
         quaternion->w * quaternion->w + quaternion->x * quaternion->x +
         quaternion->y * quaternion->y + quaternion->z * quaternion->z;
@@ -149,18 +167,18 @@ quaternion3_err_t quaternion3_inverse(quaternion3_t const* quaternion,
     return QUATERNION3_ERR_OK;
 }
 
-quaternion3_err_t quaternion3_normalized(quaternion3_t const* quaternion,
-                                         quaternion3_t* normalized)
+// Also the fallback of the fast paths for squared magnitudes that are zero,
+// subnormal or not finite, where the reciprocal square root estimate breaks
+// down.
+static quaternion3_err_t quaternion3_normalized_precise(
+    quaternion3_t const* quaternion,
+    quaternion3_t* normalized)
 {
-    if (quaternion == NULL || normalized == NULL) {
-        return QUATERNION3_ERR_NULL;
-    }
-
     quaternion3_data_t mag =
         sqrtf(quaternion->w * quaternion->w + quaternion->x * quaternion->x +
               quaternion->y * quaternion->y + quaternion->z * quaternion->z);
 
-    if (mag == 0) {
+    if (mag == 0.0F) {
         return QUATERNION3_ERR_FAIL;
     }
 
@@ -172,6 +190,92 @@ quaternion3_err_t quaternion3_normalized(quaternion3_t const* quaternion,
     return QUATERNION3_ERR_OK;
 }
 
+quaternion3_err_t quaternion3_normalized(quaternion3_t const* quaternion,
+                                         quaternion3_t* normalized)
+{
+    if (quaternion == NULL || normalized == NULL) {
+        return QUATERNION3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(quaternion3_normalized, 12UL, 32UL);
+
+#ifdef LINALG_FAST_NORMALIZE
+    return quaternion3_normalized_fast(quaternion, normalized);
+#else
+    return quaternion3_normalized_precise(quaternion, normalized);
+#endif
+}
+
+quaternion3_err_t quaternion3_normalized_fast(quaternion3_t const* quaternion,
+                                              quaternion3_t* normalized)
+{
+    if (quaternion == NULL || normalized == NULL) {
+        return QUATERNION3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(quaternion3_normalized_fast, 14UL, 32UL);
+
+    quaternion3_data_t mag_sq =
+        quaternion->w * quaternion->w + quaternion->x * quaternion->x +
+        quaternion->y * quaternion->y + quaternion->z * quaternion->z;
+
+    if (!isnormal(mag_sq)) {
+        return quaternion3_normalized_precise(quaternion, normalized);
+    }
+
+    quaternion3_data_t mag_inv = linalg_rsqrt(mag_sq);
+
+    normalized->w = quaternion->w * mag_inv;
+    normalized->x = quaternion->x * mag_inv;
+    normalized->y = quaternion->y * mag_inv;
+    normalized->z = quaternion->z * mag_inv;
+
+    return QUATERNION3_ERR_OK;
+}
+
+quaternion3_err_t quaternion3_normalized_fast_batch(
+    quaternion3_t const* quaternions,
+    quaternion3_t* normalized,
+    quaternion3_size_t count)
+{
+    if (quaternions == NULL || normalized == NULL) {
+        return QUATERNION3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(quaternion3_normalized_fast_batch,
+                            14UL * count,
+                            32UL * count);
+
+    quaternion3_err_t result = QUATERNION3_ERR_OK;
+
+    for (quaternion3_size_t index = 0UL; index < count; ++index) {
+        quaternion3_t const* quaternion = &quaternions[index];
+
+        quaternion3_data_t mag_sq =
+            quaternion->w * quaternion->w + quaternion->x * quaternion->x +
+            quaternion->y * quaternion->y + quaternion->z * quaternion->z;
+
+        if (!isnormal(mag_sq)) {
+            if (quaternion3_normalized_precise(quaternion,
+                                               &normalized[index]) !=
+                QUATERNION3_ERR_OK) {
+                normalized[index] = *quaternion;
+                result = QUATERNION3_ERR_FAIL;
+            }
+            continue;
+        }
+
+        quaternion3_data_t mag_inv = linalg_rsqrt(mag_sq);
+
+        normalized[index].w = quaternion->w * mag_inv;
+        normalized[index].x = quaternion->x * mag_inv;
+        normalized[index].y = quaternion->y * mag_inv;
+        normalized[index].z = quaternion->z * mag_inv;
+    }
+
+    return result;
+}
+
 quaternion3_err_t quaternion3_magnitude(quaternion3_t const* quaternion,
                                         quaternion3_data_t* magnitude)
 {
@@ -179,6 +283,8 @@ quaternion3_err_t quaternion3_magnitude(quaternion3_t const* quaternion,
         return QUATERNION3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(quaternion3_magnitude, 8UL, 20UL);
+
     *magnitude =
         sqrtf(quaternion->w * quaternion->w + quaternion->x * quaternion->x +
               quaternion->y * quaternion->y + quaternion->z * quaternion->z);
@@ -194,6 +300,8 @@ quaternion3_err_t quaternion3_dot(quaternion3_t const* quaternion1,
         return QUATERNION3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(quaternion3_dot, 7UL, 36UL);
+
     *dot = quaternion1->w * quaternion2->w + quaternion1->x * quaternion2->x +
            quaternion1->y * quaternion2->y + quaternion1->z * quaternion2->z;
 
@@ -1,6 +1,7 @@
 #ifndef LINALG_QUATERNION3_H
 #define LINALG_QUATERNION3_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -8,6 +9,7 @@ extern "C" {
 #endif
 
 typedef float quaternion3_data_t;
+typedef size_t quaternion3_size_t;
 
 typedef enum {
     QUATERNION3_ERR_OK = 0,
@@ -55,6 +57,19 @@ quaternion3_err_t quaternion3_inverse(quaternion3_t const* quaternion,
 quaternion3_err_t quaternion3_normalized(quaternion3_t const* quaternion,
                                          quaternion3_t* normalized);
 
+// Approximate variants using a hardware reciprocal square root with one
+// Newton-Raphson step, see linalg_rsqrt.h for the error bound. A squared
+// magnitude that is subnormal or not finite takes the precise path instead.
+// The batch variant copies zero quaternions through unchanged and reports
+// QUATERNION3_ERR_FAIL after processing the whole array.
+quaternion3_err_t quaternion3_normalized_fast(quaternion3_t const* quaternion,
+                                              quaternion3_t* normalized);
+
+quaternion3_err_t quaternion3_normalized_fast_batch(
+    quaternion3_t const* quaternions,
+    quaternion3_t* normalized,
+    quaternion3_size_t count);
+
 quaternion3_err_t quaternion3_magnitude(quaternion3_t const* quaternion,
                                         quaternion3_data_t* magnitude);
 
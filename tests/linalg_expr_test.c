@@ -0,0 +1,71 @@
+#include "linalg.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static matrix_data_t* test_matrix_allocate(void* user, matrix_size_t size)
+{
+    (void)user;
+
+    return malloc(size);
+}
+
+static void test_matrix_deallocate(void* user, matrix_data_t* data)
+{
+    (void)user;
+
+    free(data);
+}
+
+static matrix_allocator_t const test_matrix_allocator = {
+    .user = NULL,
+    .allocate = test_matrix_allocate,
+    .deallocate = test_matrix_deallocate,
+};
+
+// A leaf resized after the expression was built must be rejected rather
+// than read with the shape it had when it was added.
+static int test_resized_leaf(void)
+{
+    matrix_t leaf;
+    matrix_t result;
+    linalg_expr_t expr;
+    linalg_expr_id_t leaf_id;
+    linalg_expr_id_t sum_id;
+    int failures = 0;
+
+    matrix_initialize(&leaf, &test_matrix_allocator);
+    matrix_initialize(&result, &test_matrix_allocator);
+    linalg_expr_initialize(&expr, &test_matrix_allocator);
+
+    if (matrix_create_with_zeros(&leaf, 2UL, 2UL) != MATRIX_ERR_OK ||
+        linalg_expr_matrix(&expr, &leaf, &leaf_id) != LINALG_EXPR_ERR_OK ||
+        linalg_expr_sum(&expr, leaf_id, leaf_id, &sum_id) !=
+            LINALG_EXPR_ERR_OK) {
+        fprintf(stderr, "test_resized_leaf: setup failed\n");
+        ++failures;
+    } else if (linalg_expr_evaluate(&expr, sum_id, &result) !=
+               LINALG_EXPR_ERR_OK) {
+        fprintf(stderr, "test_resized_leaf: evaluation failed\n");
+        ++failures;
+    } else if (matrix_resize(&leaf, 1UL, 1UL) != MATRIX_ERR_OK) {
+        fprintf(stderr, "test_resized_leaf: resize failed\n");
+        ++failures;
+    } else if (linalg_expr_evaluate(&expr, sum_id, &result) !=
+               LINALG_EXPR_ERR_DIMENSION) {
+        fprintf(stderr, "test_resized_leaf: resized leaf was accepted\n");
+        ++failures;
+    }
+
+    linalg_expr_deinitialize(&expr);
+    matrix_delete(&result);
+    matrix_delete(&leaf);
+
+    return failures;
+}
+
+int main(void)
+{
+    int failures = test_resized_leaf();
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,4 +1,5 @@
 #include "transform3.h"
+#include "linalg_profile.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -12,6 +13,8 @@ transform3_err_t transform3_fill_with_arrays(
         return TRANSFORM3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(transform3_fill_with_arrays, 0, 96UL);
+
     if (matrix3_fill_with_array(&transform->rotation, rotation_array) !=
         MATRIX3_ERR_OK) {
         return TRANSFORM3_ERR_FAIL;
@@ -31,6 +34,8 @@ transform3_err_t transform3_fill_with_zeros(transform3_t* transform)
         return TRANSFORM3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(transform3_fill_with_zeros, 0, 48UL);
+
     if (matrix3_fill_with_zeros(&transform->rotation) != MATRIX3_ERR_OK) {
         return TRANSFORM3_ERR_FAIL;
     }
@@ -50,6 +55,8 @@ transform3_err_t transform3_compose(transform3_t const* transform1,
         return TRANSFORM3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(transform3_compose, 63UL, 144UL);
+
     matrix3_t rotated_rotation;
     if (matrix3_product(&transform1->rotation,
                         &transform2->rotation,
@@ -84,6 +91,8 @@ transform3_err_t transform3_inverse(transform3_t const* transform,
         return TRANSFORM3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(transform3_inverse, 60UL, 96UL);
+
     matrix3_t rotation_inv;
     if (matrix3_inverse(&transform->rotation, &rotation_inv) !=
         MATRIX3_ERR_OK) {
@@ -109,6 +118,79 @@ transform3_err_t transform3_inverse(transform3_t const* transform,
     return TRANSFORM3_ERR_OK;
 }
 
+transform3_err_t transform3_rigid_inverse(transform3_t const* transform,
+                                          transform3_t* inverse)
+{
+    if (transform == NULL || inverse == NULL) {
+        return TRANSFORM3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(transform3_rigid_inverse, 18UL, 96UL);
+
+    matrix3_t rotation_inv;
+    if (matrix3_transpose(&transform->rotation, &rotation_inv) !=
+        MATRIX3_ERR_OK) {
+        return TRANSFORM3_ERR_FAIL;
+    }
+
+    vector3_t rotated_translation;
+    if (matrix3_vector_product(&rotation_inv,
+                               &transform->translation,
+                               &rotated_translation) != MATRIX3_ERR_OK) {
+        return TRANSFORM3_ERR_FAIL;
+    }
+
+    vector3_t inv_translation;
+    if (vector3_negated(&rotated_translation, &inv_translation) !=
+        VECTOR3_ERR_OK) {
+        return TRANSFORM3_ERR_FAIL;
+    }
+
+    inverse->rotation = rotation_inv;
+    inverse->translation = inv_translation;
+
+    return TRANSFORM3_ERR_OK;
+}
+
+transform3_err_t transform3_rigid_inverse_batch(transform3_t const* transforms,
+                                                transform3_t* inverses,
+                                                transform3_size_t count)
+{
+    if (transforms == NULL || inverses == NULL) {
+        return TRANSFORM3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(transform3_rigid_inverse_batch,
+                            18UL * count,
+                            96UL * count);
+
+    for (transform3_size_t index = 0UL; index < count; ++index) {
+        transform3_t const* transform = &transforms[index];
+        transform3_t inverse;
+
+        for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+            for (transform3_size_t column = 0UL; column < 3UL; ++column) {
+                inverse.rotation.data[row][column] =
+                    transform->rotation.data[column][row];
+            }
+        }
+
+        for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+            inverse.translation.data[row] =
+                -(inverse.rotation.data[row][0U] *
+                      transform->translation.data[0U] +
+                  inverse.rotation.data[row][1U] *
+                      transform->translation.data[1U] +
+                  inverse.rotation.data[row][2U] *
+                      transform->translation.data[2U]);
+        }
+
+        inverses[index] = inverse;
+    }
+
+    return TRANSFORM3_ERR_OK;
+}
+
 transform3_err_t transform3_vector_transformation(transform3_t const* transform,
                                                   vector3_t const* vector,
                                                   vector3_t* transformation)
@@ -117,6 +199,8 @@ transform3_err_t transform3_vector_transformation(transform3_t const* transform,
         return TRANSFORM3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(transform3_vector_transformation, 18UL, 72UL);
+
     if (matrix3_vector_product(&transform->rotation, vector, transformation) !=
         MATRIX3_ERR_OK) {
         return TRANSFORM3_ERR_FAIL;
@@ -137,6 +221,8 @@ transform3_err_t transform3_print(transform3_t const* transform,
         return TRANSFORM3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(transform3_print, 0, 48UL);
+
     printf("Rotation: %s", endline);
     matrix3_print(&transform->rotation, endline);
 
@@ -3,12 +3,15 @@
 
 #include "matrix3.h"
 #include "vector3.h"
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+typedef size_t transform3_size_t;
+
 typedef enum {
     TRANSFORM3_ERR_OK = 0,
     TRANSFORM3_ERR_FAIL,
@@ -34,6 +37,15 @@ transform3_err_t transform3_compose(transform3_t const* transform1,
 transform3_err_t transform3_inverse(transform3_t const* transform,
                                     transform3_t* inverse);
 
+transform3_err_t transform3_rigid_inverse(transform3_t const* transform,
+                                          transform3_t* inverse);
+
+// Never fails on the transforms themselves: a rigid inverse only needs the
+// rotation transposed, so every element is always written.
+transform3_err_t transform3_rigid_inverse_batch(transform3_t const* transforms,
+                                                transform3_t* inverses,
+                                                transform3_size_t count);
+
 transform3_err_t transform3_vector_transformation(transform3_t const* transform,
                                                   vector3_t const* vector,
                                                   vector3_t* transformation);
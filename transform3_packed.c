@@ -0,0 +1,397 @@
+#include "transform3_packed.h"
+#include "linalg_profile.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define TRANSFORM3_PACKED_SSE
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TRANSFORM3_PACKED_NEON
+#endif
+
+transform3_err_t transform3_packed_from_transform(
+    transform3_t const* transform,
+    transform3_packed_t* packed)
+{
+    if (transform == NULL || packed == NULL) {
+        return TRANSFORM3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(transform3_packed_from_transform, 0, 96UL);
+
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        for (transform3_size_t column = 0UL; column < 3UL; ++column) {
+            packed->data[row][column] = transform->rotation.data[row][column];
+        }
+
+        packed->data[row][3U] = transform->translation.data[row];
+    }
+
+    return TRANSFORM3_ERR_OK;
+}
+
+transform3_err_t transform3_packed_to_transform(
+    transform3_packed_t const* packed,
+    transform3_t* transform)
+{
+    if (packed == NULL || transform == NULL) {
+        return TRANSFORM3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(transform3_packed_to_transform, 0, 96UL);
+
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        for (transform3_size_t column = 0UL; column < 3UL; ++column) {
+            transform->rotation.data[row][column] = packed->data[row][column];
+        }
+
+        transform->translation.data[row] = packed->data[row][3U];
+    }
+
+    return TRANSFORM3_ERR_OK;
+}
+
+transform3_err_t transform3_packed_compose(transform3_packed_t const* transform1,
+                                           transform3_packed_t const* transform2,
+                                           transform3_packed_t* compose)
+{
+    if (transform1 == NULL || transform2 == NULL || compose == NULL) {
+        return TRANSFORM3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(transform3_packed_compose, 63UL, 144UL);
+
+#if defined(TRANSFORM3_PACKED_SSE)
+    __m128 const row0 = _mm_load_ps(transform2->data[0U]);
+    __m128 const row1 = _mm_load_ps(transform2->data[1U]);
+    __m128 const row2 = _mm_load_ps(transform2->data[2U]);
+    __m128 const mask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+    __m128 rows[3U];
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        __m128 const a = _mm_load_ps(transform1->data[row]);
+
+        __m128 sum = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)),
+                                row0);
+        sum = _mm_add_ps(
+            sum,
+            _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), row1));
+        sum = _mm_add_ps(
+            sum,
+            _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), row2));
+
+        rows[row] = _mm_add_ps(sum, _mm_and_ps(a, mask));
+    }
+
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        _mm_store_ps(compose->data[row], rows[row]);
+    }
+#elif defined(TRANSFORM3_PACKED_NEON)
+    float32x4_t const row0 = vld1q_f32(transform2->data[0U]);
+    float32x4_t const row1 = vld1q_f32(transform2->data[1U]);
+    float32x4_t const row2 = vld1q_f32(transform2->data[2U]);
+
+    float32x4_t rows[3U];
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        float32x4_t const a = vld1q_f32(transform1->data[row]);
+
+        float32x4_t sum = vmulq_n_f32(row0, vgetq_lane_f32(a, 0));
+        sum = vmlaq_n_f32(sum, row1, vgetq_lane_f32(a, 1));
+        sum = vmlaq_n_f32(sum, row2, vgetq_lane_f32(a, 2));
+
+        rows[row] = vsetq_lane_f32(vgetq_lane_f32(sum, 3) +
+                                       vgetq_lane_f32(a, 3),
+                                   sum,
+                                   3);
+    }
+
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        vst1q_f32(compose->data[row], rows[row]);
+    }
+#else
+    transform3_packed_t result;
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        for (transform3_size_t column = 0UL; column < 4UL; ++column) {
+            result.data[row][column] =
+                transform1->data[row][0U] * transform2->data[0U][column] +
+                transform1->data[row][1U] * transform2->data[1U][column] +
+                transform1->data[row][2U] * transform2->data[2U][column];
+        }
+
+        result.data[row][3U] += transform1->data[row][3U];
+    }
+
+    *compose = result;
+#endif
+
+    return TRANSFORM3_ERR_OK;
+}
+
+transform3_err_t transform3_packed_inverse(transform3_packed_t const* transform,
+                                           transform3_packed_t* inverse)
+{
+    if (transform == NULL || inverse == NULL) {
+        return TRANSFORM3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(transform3_packed_inverse, 60UL, 96UL);
+
+#if defined(TRANSFORM3_PACKED_SSE)
+    __m128 const a = _mm_load_ps(transform->data[0U]);
+    __m128 const b = _mm_load_ps(transform->data[1U]);
+    __m128 const c = _mm_load_ps(transform->data[2U]);
+
+    __m128 const a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 const b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 const c_yzx = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+
+    __m128 cofactor0 = _mm_sub_ps(_mm_mul_ps(b, c_yzx), _mm_mul_ps(b_yzx, c));
+    __m128 cofactor1 = _mm_sub_ps(_mm_mul_ps(c, a_yzx), _mm_mul_ps(c_yzx, a));
+    __m128 cofactor2 = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+    cofactor0 = _mm_shuffle_ps(cofactor0, cofactor0, _MM_SHUFFLE(3, 0, 2, 1));
+    cofactor1 = _mm_shuffle_ps(cofactor1, cofactor1, _MM_SHUFFLE(3, 0, 2, 1));
+    cofactor2 = _mm_shuffle_ps(cofactor2, cofactor2, _MM_SHUFFLE(3, 0, 2, 1));
+
+    __m128 const det_terms = _mm_mul_ps(a, cofactor0);
+    transform3_packed_data_t const det =
+        _mm_cvtss_f32(det_terms) +
+        _mm_cvtss_f32(
+            _mm_shuffle_ps(det_terms, det_terms, _MM_SHUFFLE(1, 1, 1, 1))) +
+        _mm_cvtss_f32(
+            _mm_shuffle_ps(det_terms, det_terms, _MM_SHUFFLE(2, 2, 2, 2)));
+
+    if (fabsf(det) < 1E-6F) {
+        return TRANSFORM3_ERR_FAIL;
+    }
+
+    __m128 const det_inv = _mm_set1_ps(1.0F / det);
+    cofactor0 = _mm_mul_ps(cofactor0, det_inv);
+    cofactor1 = _mm_mul_ps(cofactor1, det_inv);
+    cofactor2 = _mm_mul_ps(cofactor2, det_inv);
+
+    __m128 translation = _mm_mul_ps(
+        cofactor0,
+        _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)));
+    translation = _mm_add_ps(
+        translation,
+        _mm_mul_ps(cofactor1, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3))));
+    translation = _mm_add_ps(
+        translation,
+        _mm_mul_ps(cofactor2, _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3))));
+    translation = _mm_sub_ps(_mm_setzero_ps(), translation);
+
+    __m128 row3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(cofactor0, cofactor1, cofactor2, row3);
+
+    __m128 const mask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+    cofactor0 = _mm_or_ps(
+        cofactor0,
+        _mm_and_ps(
+            _mm_shuffle_ps(translation, translation, _MM_SHUFFLE(0, 0, 0, 0)),
+            mask));
+    cofactor1 = _mm_or_ps(
+        cofactor1,
+        _mm_and_ps(
+            _mm_shuffle_ps(translation, translation, _MM_SHUFFLE(1, 1, 1, 1)),
+            mask));
+    cofactor2 = _mm_or_ps(
+        cofactor2,
+        _mm_and_ps(
+            _mm_shuffle_ps(translation, translation, _MM_SHUFFLE(2, 2, 2, 2)),
+            mask));
+
+    _mm_store_ps(inverse->data[0U], cofactor0);
+    _mm_store_ps(inverse->data[1U], cofactor1);
+    _mm_store_ps(inverse->data[2U], cofactor2);
+#else
+    transform3_packed_data_t const(*m)[4U] = transform->data;
+
+    transform3_packed_data_t cofactors[3U][3U] = {
+        {m[1U][1U] * m[2U][2U] - m[1U][2U] * m[2U][1U],
+         m[1U][2U] * m[2U][0U] - m[1U][0U] * m[2U][2U],
+         m[1U][0U] * m[2U][1U] - m[1U][1U] * m[2U][0U]},
+        {m[2U][1U] * m[0U][2U] - m[2U][2U] * m[0U][1U],
+         m[2U][2U] * m[0U][0U] - m[2U][0U] * m[0U][2U],
+         m[2U][0U] * m[0U][1U] - m[2U][1U] * m[0U][0U]},
+        {m[0U][1U] * m[1U][2U] - m[0U][2U] * m[1U][1U],
+         m[0U][2U] * m[1U][0U] - m[0U][0U] * m[1U][2U],
+         m[0U][0U] * m[1U][1U] - m[0U][1U] * m[1U][0U]},
+    };
+
+    transform3_packed_data_t const det = m[0U][0U] * cofactors[0U][0U] +
+                                         m[0U][1U] * cofactors[0U][1U] +
+                                         m[0U][2U] * cofactors[0U][2U];
+
+    if (fabsf(det) < 1E-6F) {
+        return TRANSFORM3_ERR_FAIL;
+    }
+
+    transform3_packed_data_t const det_inv = 1.0F / det;
+
+    transform3_packed_t result;
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        for (transform3_size_t column = 0UL; column < 3UL; ++column) {
+            result.data[row][column] = cofactors[column][row] * det_inv;
+        }
+    }
+
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        result.data[row][3U] = -(result.data[row][0U] * m[0U][3U] +
+                                 result.data[row][1U] * m[1U][3U] +
+                                 result.data[row][2U] * m[2U][3U]);
+    }
+
+    *inverse = result;
+#endif
+
+    return TRANSFORM3_ERR_OK;
+}
+
+transform3_err_t transform3_packed_rigid_inverse(
+    transform3_packed_t const* transform,
+    transform3_packed_t* inverse)
+{
+    if (transform == NULL || inverse == NULL) {
+        return TRANSFORM3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(transform3_packed_rigid_inverse, 18UL, 96UL);
+
+#if defined(TRANSFORM3_PACKED_SSE)
+    __m128 row0 = _mm_load_ps(transform->data[0U]);
+    __m128 row1 = _mm_load_ps(transform->data[1U]);
+    __m128 row2 = _mm_load_ps(transform->data[2U]);
+
+    __m128 translation = _mm_mul_ps(
+        row0,
+        _mm_shuffle_ps(row0, row0, _MM_SHUFFLE(3, 3, 3, 3)));
+    translation = _mm_add_ps(
+        translation,
+        _mm_mul_ps(row1, _mm_shuffle_ps(row1, row1, _MM_SHUFFLE(3, 3, 3, 3))));
+    translation = _mm_add_ps(
+        translation,
+        _mm_mul_ps(row2, _mm_shuffle_ps(row2, row2, _MM_SHUFFLE(3, 3, 3, 3))));
+    translation = _mm_sub_ps(_mm_setzero_ps(), translation);
+
+    __m128 row3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+    __m128 const mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    row0 = _mm_or_ps(
+        _mm_and_ps(row0, mask),
+        _mm_andnot_ps(
+            mask,
+            _mm_shuffle_ps(translation, translation, _MM_SHUFFLE(0, 0, 0, 0))));
+    row1 = _mm_or_ps(
+        _mm_and_ps(row1, mask),
+        _mm_andnot_ps(
+            mask,
+            _mm_shuffle_ps(translation, translation, _MM_SHUFFLE(1, 1, 1, 1))));
+    row2 = _mm_or_ps(
+        _mm_and_ps(row2, mask),
+        _mm_andnot_ps(
+            mask,
+            _mm_shuffle_ps(translation, translation, _MM_SHUFFLE(2, 2, 2, 2))));
+
+    _mm_store_ps(inverse->data[0U], row0);
+    _mm_store_ps(inverse->data[1U], row1);
+    _mm_store_ps(inverse->data[2U], row2);
+#elif defined(TRANSFORM3_PACKED_NEON)
+    float32x4_t const row0 = vld1q_f32(transform->data[0U]);
+    float32x4_t const row1 = vld1q_f32(transform->data[1U]);
+    float32x4_t const row2 = vld1q_f32(transform->data[2U]);
+
+    float32x4_t translation = vmulq_n_f32(row0, vgetq_lane_f32(row0, 3));
+    translation = vmlaq_n_f32(translation, row1, vgetq_lane_f32(row1, 3));
+    translation = vmlaq_n_f32(translation, row2, vgetq_lane_f32(row2, 3));
+    translation = vnegq_f32(translation);
+
+    transform3_packed_t result;
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        for (transform3_size_t column = 0UL; column < 3UL; ++column) {
+            result.data[row][column] = transform->data[column][row];
+        }
+    }
+
+    result.data[0U][3U] = vgetq_lane_f32(translation, 0);
+    result.data[1U][3U] = vgetq_lane_f32(translation, 1);
+    result.data[2U][3U] = vgetq_lane_f32(translation, 2);
+
+    *inverse = result;
+#else
+    transform3_packed_t result;
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        for (transform3_size_t column = 0UL; column < 3UL; ++column) {
+            result.data[row][column] = transform->data[column][row];
+        }
+    }
+
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        result.data[row][3U] = -(result.data[row][0U] * transform->data[0U][3U] +
+                                 result.data[row][1U] * transform->data[1U][3U] +
+                                 result.data[row][2U] * transform->data[2U][3U]);
+    }
+
+    *inverse = result;
+#endif
+
+    return TRANSFORM3_ERR_OK;
+}
+
+transform3_err_t transform3_packed_vector_transformation(
+    transform3_packed_t const* transform,
+    vector3_t const* vector,
+    vector3_t* transformation)
+{
+    if (transform == NULL || vector == NULL || transformation == NULL) {
+        return TRANSFORM3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(transform3_packed_vector_transformation,
+                            18UL,
+                            72UL);
+
+#if defined(TRANSFORM3_PACKED_SSE)
+    __m128 const point =
+        _mm_setr_ps(vector->data[0U], vector->data[1U], vector->data[2U], 1.0F);
+
+    __m128 row0 = _mm_mul_ps(_mm_load_ps(transform->data[0U]), point);
+    __m128 row1 = _mm_mul_ps(_mm_load_ps(transform->data[1U]), point);
+    __m128 row2 = _mm_mul_ps(_mm_load_ps(transform->data[2U]), point);
+    __m128 row3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+    alignas(16) transform3_packed_data_t result[4U];
+    _mm_store_ps(result,
+                 _mm_add_ps(_mm_add_ps(row0, row1), _mm_add_ps(row2, row3)));
+#elif defined(TRANSFORM3_PACKED_NEON)
+    float32x4_t const point = vsetq_lane_f32(
+        1.0F,
+        vld1q_f32((transform3_packed_data_t const[4U]){vector->data[0U],
+                                                       vector->data[1U],
+                                                       vector->data[2U],
+                                                       0.0F}),
+        3);
+
+    transform3_packed_data_t result[4U] = {
+        vaddvq_f32(vmulq_f32(vld1q_f32(transform->data[0U]), point)),
+        vaddvq_f32(vmulq_f32(vld1q_f32(transform->data[1U]), point)),
+        vaddvq_f32(vmulq_f32(vld1q_f32(transform->data[2U]), point)),
+        0.0F,
+    };
+#else
+    transform3_packed_data_t result[4U];
+    for (transform3_size_t row = 0UL; row < 3UL; ++row) {
+        result[row] = transform->data[row][0U] * vector->data[0U] +
+                      transform->data[row][1U] * vector->data[1U] +
+                      transform->data[row][2U] * vector->data[2U] +
+                      transform->data[row][3U];
+    }
+#endif
+
+    memcpy(transformation->data, result, sizeof(transformation->data));
+
+    return TRANSFORM3_ERR_OK;
+}
@@ -0,0 +1,51 @@
+#ifndef LINALG_TRANSFORM3_PACKED_H
+#define LINALG_TRANSFORM3_PACKED_H
+
+#include "transform3.h"
+#include "vector3.h"
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRANSFORM3_PACKED_INDEX(TRANSFORM, ROW, COLUMN) \
+    ((TRANSFORM)->data[(ROW)][(COLUMN)])
+
+typedef float transform3_packed_data_t;
+
+typedef struct {
+    alignas(16) transform3_packed_data_t data[3U][4U];
+} transform3_packed_t;
+
+transform3_err_t transform3_packed_from_transform(
+    transform3_t const* transform,
+    transform3_packed_t* packed);
+
+transform3_err_t transform3_packed_to_transform(
+    transform3_packed_t const* packed,
+    transform3_t* transform);
+
+transform3_err_t transform3_packed_compose(transform3_packed_t const* transform1,
+                                           transform3_packed_t const* transform2,
+                                           transform3_packed_t* compose);
+
+transform3_err_t transform3_packed_inverse(transform3_packed_t const* transform,
+                                           transform3_packed_t* inverse);
+
+transform3_err_t transform3_packed_rigid_inverse(
+    transform3_packed_t const* transform,
+    transform3_packed_t* inverse);
+
+transform3_err_t transform3_packed_vector_transformation(
+    transform3_packed_t const* transform,
+    vector3_t const* vector,
+    vector3_t* transformation);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINALG_TRANSFORM3_PACKED_H
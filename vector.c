@@ -1,4 +1,6 @@
 #include "vector.h"
+#include "linalg_profile.h"
+#include "linalg_reduce.h"
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
@@ -10,7 +12,7 @@ static vector_data_t* vector_allocate(vector_t const* vector,
         return NULL;
     }
 
-    return vector->allocator.allocate(size);
+    return vector->allocator.allocate(vector->allocator.user, size);
 }
 
 static void vector_deallocate(vector_t const* vector, vector_data_t* data)
@@ -19,7 +21,7 @@ static void vector_deallocate(vector_t const* vector, vector_data_t* data)
         return;
     }
 
-    vector->allocator.deallocate(data);
+    vector->allocator.deallocate(vector->allocator.user, data);
 }
 
 vector_err_t vector_initialize(vector_t* vector,
@@ -29,6 +31,8 @@ vector_err_t vector_initialize(vector_t* vector,
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_initialize, 0, 0);
+
     memset(vector, 0, sizeof(*vector));
     memcpy(&vector->allocator, allocator, sizeof(*allocator));
 
@@ -41,6 +45,8 @@ vector_err_t vector_deinitialize(vector_t* vector)
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_deinitialize, 0, 0);
+
     memset(vector, 0, sizeof(*vector));
 
     return VECTOR_ERR_OK;
@@ -61,6 +67,8 @@ vector_err_t vector_create(vector_t* vector, vector_size_t size)
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_create, 0, 0);
+
     vector_data_t* data = vector_allocate(vector, sizeof(vector_data_t) * size);
     if (data == NULL) {
         return VECTOR_ERR_ALLOC;
@@ -78,6 +86,10 @@ vector_err_t vector_create_with_zeros(vector_t* vector, vector_size_t size)
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_create_with_zeros,
+                            0,
+                            sizeof(vector_data_t) * size);
+
     vector_err_t err = vector_create(vector, size);
     if (err != VECTOR_ERR_OK) {
         return err;
@@ -94,6 +106,10 @@ vector_err_t vector_create_with_array(vector_t* vector,
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_create_with_array,
+                            0,
+                            2UL * sizeof(vector_data_t) * size);
+
     vector_err_t err = vector_create(vector, size);
     if (err != VECTOR_ERR_OK) {
         return err;
@@ -108,6 +124,8 @@ vector_err_t vector_delete(vector_t* vector)
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_delete, 0, 0);
+
     if (vector->data != NULL) {
         vector_deallocate(vector, vector->data);
     }
@@ -124,6 +142,8 @@ vector_err_t vector_resize(vector_t* vector, vector_size_t size)
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_resize, 0, 0);
+
     if (vector->data != NULL && vector->size == size) {
         return VECTOR_ERR_OK;
     }
@@ -149,6 +169,10 @@ vector_err_t vector_resize_with_zeros(vector_t* vector, vector_size_t size)
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_resize_with_zeros,
+                            0,
+                            sizeof(vector_data_t) * size);
+
     vector_err_t err = vector_resize(vector, size);
     if (err != VECTOR_ERR_OK) {
         return err;
@@ -165,6 +189,10 @@ vector_err_t vector_resize_with_array(vector_t* vector,
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_resize_with_array,
+                            0,
+                            2UL * sizeof(vector_data_t) * size);
+
     vector_err_t err = vector_resize(vector, size);
     if (err != VECTOR_ERR_OK) {
         return err;
@@ -179,6 +207,10 @@ vector_err_t vector_fill_with_zeros(vector_t* vector)
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_fill_with_zeros,
+                            0,
+                            sizeof(vector_data_t) * vector->size);
+
     memset(vector->data, 0, sizeof(vector_data_t) * vector->size);
 
     return VECTOR_ERR_OK;
@@ -191,6 +223,10 @@ vector_err_t vector_fill_with_array(vector_t* vector,
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_fill_with_array,
+                            0,
+                            2UL * sizeof(vector_data_t) * vector->size);
+
     memcpy(vector->data, array, sizeof(vector_data_t) * vector->size);
 
     return VECTOR_ERR_OK;
@@ -202,6 +238,10 @@ vector_err_t vector_copy(vector_t const* source, vector_t* destination)
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_copy,
+                            0,
+                            2UL * sizeof(vector_data_t) * source->size);
+
     vector_err_t err = vector_resize(destination, source->size);
     if (err != VECTOR_ERR_OK) {
         return err;
@@ -220,6 +260,8 @@ vector_err_t vector_move(vector_t* source, vector_t* destination)
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_move, 0, 0);
+
     vector_err_t err = vector_delete(destination);
     if (err != VECTOR_ERR_OK) {
         return err;
@@ -242,6 +284,10 @@ vector_err_t vector_sum(vector_t const* vector1,
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_sum,
+                            vector1->size,
+                            3UL * sizeof(vector_data_t) * vector1->size);
+
     if (vector1->size != vector2->size) {
         return VECTOR_ERR_DIMENSION;
     }
@@ -267,6 +313,10 @@ vector_err_t vector_difference(vector_t const* vector1,
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_difference,
+                            vector1->size,
+                            3UL * sizeof(vector_data_t) * vector1->size);
+
     if (vector1->size != vector2->size) {
         return VECTOR_ERR_DIMENSION;
     }
@@ -292,6 +342,10 @@ vector_err_t vector_scale(vector_t const* vector,
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_scale,
+                            vector->size,
+                            2UL * sizeof(vector_data_t) * vector->size);
+
     vector_err_t err = vector_resize(scale, vector->size);
     if (err != VECTOR_ERR_OK) {
         return err;
@@ -312,15 +366,58 @@ vector_err_t vector_dot(vector_t const* vector1,
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_dot,
+                            2UL * vector1->size,
+                            2UL * sizeof(vector_data_t) * vector1->size);
+
     if (vector1->size != vector2->size) {
         return VECTOR_ERR_DIMENSION;
     }
 
+#ifdef LINALG_REDUCTION_DEFAULT_NAIVE
     *dot = 0.0F;
 
     for (vector_size_t index = 0UL; index < vector1->size; ++index) {
         *dot += VECTOR_INDEX(vector1, index) * VECTOR_INDEX(vector2, index);
     }
+#else
+    *dot = linalg_reduce_dot(LINALG_REDUCTION_DEFAULT,
+                             vector1->data,
+                             1UL,
+                             vector2->data,
+                             1UL,
+                             vector1->size,
+                             1UL);
+#endif
+
+    return VECTOR_ERR_OK;
+}
+
+vector_err_t vector_dot_reduced(vector_t const* vector1,
+                                vector_t const* vector2,
+                                linalg_reduction_t reduction,
+                                vector_size_t threads,
+                                vector_data_t* dot)
+{
+    if (vector1 == NULL || vector2 == NULL || dot == NULL) {
+        return VECTOR_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(vector_dot_reduced,
+                            2UL * vector1->size,
+                            2UL * sizeof(vector_data_t) * vector1->size);
+
+    if (vector1->size != vector2->size) {
+        return VECTOR_ERR_DIMENSION;
+    }
+
+    *dot = linalg_reduce_dot(reduction,
+                             vector1->data,
+                             1UL,
+                             vector2->data,
+                             1UL,
+                             vector1->size,
+                             threads);
 
     return VECTOR_ERR_OK;
 }
@@ -332,6 +429,8 @@ vector_err_t vector_cross(vector_t const* vector1,
     if (vector1 == NULL || vector2 == NULL || cross == NULL) {
     }
 
+    LINALG_PROFILE_FUNCTION(vector_cross, 9UL, 9UL * sizeof(vector_data_t));
+
     if (vector1->size != 3UL || vector2->size != 3UL) {
         return VECTOR_ERR_DIMENSION;
     }
@@ -360,6 +459,10 @@ vector_err_t vector_print(vector_t const* vector, char const* endline)
         return VECTOR_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector_print,
+                            0,
+                            sizeof(vector_data_t) * vector->size);
+
     printf("[ ");
 
     for (vector_size_t index = 0UL; index < vector->size; ++index) {
@@ -1,6 +1,7 @@
 #ifndef LINALG_VECTOR_H
 #define LINALG_VECTOR_H
 
+#include "linalg_reduce.h"
 #include <stddef.h>
 #include <stdint.h>
 
@@ -19,12 +20,15 @@ typedef enum {
     VECTOR_ERR_NULL,
     VECTOR_ERR_DIMENSION,
     VECTOR_ERR_ALLOC,
+    VECTOR_ERR_IO,
+    VECTOR_ERR_FORMAT,
 } vector_err_t;
 
-typedef vector_data_t* (*vector_allocate_t)(vector_size_t);
-typedef void (*vector_deallocate_t)(vector_data_t*);
+typedef vector_data_t* (*vector_allocate_t)(void*, vector_size_t);
+typedef void (*vector_deallocate_t)(void*, vector_data_t*);
 
 typedef struct {
+    void* user;
     vector_allocate_t allocate;
     vector_deallocate_t deallocate;
 } vector_allocator_t;
@@ -83,6 +87,14 @@ vector_err_t vector_dot(vector_t const* vector1,
                         vector_t const* vector2,
                         vector_data_t* dot);
 
+// vector_dot with an explicit reduction, run on up to threads threads. For
+// pairwise and compensated reductions the result does not depend on threads.
+vector_err_t vector_dot_reduced(vector_t const* vector1,
+                                vector_t const* vector2,
+                                linalg_reduction_t reduction,
+                                vector_size_t threads,
+                                vector_data_t* dot);
+
 vector_err_t vector_cross(vector_t const* vector1,
                           vector_t const* vector2,
                           vector_t* cross);
@@ -1,4 +1,7 @@
 #include "vector3.h"
+#include "linalg_profile.h"
+#include "linalg_reduce.h"
+#include "linalg_rsqrt.h"
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
@@ -9,6 +12,8 @@ vector3_err_t vector3_fill_with_zeros(vector3_t* vector)
         return VECTOR3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector3_fill_with_zeros, 0, 12UL);
+
     memset(vector->data, 0, sizeof(vector->data));
 
     return VECTOR3_ERR_OK;
@@ -21,6 +26,8 @@ vector3_err_t vector3_fill_with_array(vector3_t* vector,
         return VECTOR3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector3_fill_with_array, 0, 24UL);
+
     memcpy(vector->data, array, sizeof(*array));
 
     return VECTOR3_ERR_OK;
@@ -34,8 +41,10 @@ vector3_err_t vector3_sum(vector3_t const* vector1,
         return VECTOR3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector3_sum, 3UL, 36UL);
+
     for (vector3_size_t index = 0UL; index < 3UL; ++index) {
-        sum->data[index] = vector1->data[index] * vector2->data[index];
+        sum->data[index] = vector1->data[index] + vector2->data[index];
     }
 
     return VECTOR3_ERR_OK;
@@ -49,8 +58,10 @@ vector3_err_t vector3_difference(vector3_t const* vector1,
         return VECTOR3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector3_difference, 3UL, 36UL);
+
     for (vector3_size_t index = 0UL; index < 3UL; ++index) {
-        difference->data[index] = vector1->data[index] * vector2->data[index];
+        difference->data[index] = vector1->data[index] - vector2->data[index];
     }
 
     return VECTOR3_ERR_OK;
@@ -64,6 +75,8 @@ vector3_err_t vector3_scale(vector3_t const* vector,
         return VECTOR3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector3_scale, 3UL, 24UL);
+
     for (vector3_size_t index = 0UL; index < 3UL; ++index) {
         scale->data[index] = scalar * vector->data[index];
     }
@@ -79,10 +92,22 @@ vector3_err_t vector3_dot(vector3_t const* vector1,
         return VECTOR3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector3_dot, 5UL, 28UL);
+
+#ifdef LINALG_REDUCTION_DEFAULT_NAIVE
     *dot = 0.0F;
     for (vector3_size_t index = 0UL; index < 3UL; ++index) {
         *dot += vector1->data[index] * vector2->data[index];
     }
+#else
+    *dot = linalg_reduce_dot(LINALG_REDUCTION_DEFAULT,
+                             vector1->data,
+                             1UL,
+                             vector2->data,
+                             1UL,
+                             3UL,
+                             1UL);
+#endif
 
     return VECTOR3_ERR_OK;
 }
@@ -95,6 +120,8 @@ vector3_err_t vector3_cross(vector3_t const* vector1,
         return VECTOR3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector3_cross, 9UL, 36UL);
+
     cross->data[0U] = vector1->data[1U] * vector2->data[2U] -
                       vector1->data[2U] * vector2->data[1U];
     cross->data[1U] = vector1->data[2U] * vector2->data[0U] -
@@ -112,6 +139,8 @@ vector3_err_t vector3_magnitude(vector3_t const* vector,
         return VECTOR3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector3_magnitude, 6UL, 16UL);
+
     vector3_data_t dot;
     vector3_err_t err = vector3_dot(vector, vector, &dot);
     if (err != VECTOR3_ERR_OK) {
@@ -123,12 +152,12 @@ vector3_err_t vector3_magnitude(vector3_t const* vector,
     return VECTOR3_ERR_OK;
 }
 
-vector3_err_t vector3_normalized(vector3_t const* vector, vector3_t* normalized)
+// Also the fallback of the fast paths for squared magnitudes that are zero,
+// subnormal or not finite, where the reciprocal square root estimate breaks
+// down.
+static vector3_err_t vector3_normalized_precise(vector3_t const* vector,
+                                                vector3_t* normalized)
 {
-    if (vector == NULL || normalized == NULL) {
-        return VECTOR3_ERR_NULL;
-    }
-
     vector3_data_t magnitude;
     vector3_err_t err = vector3_magnitude(vector, &magnitude);
     if (err != VECTOR3_ERR_OK) {
@@ -146,12 +175,95 @@ vector3_err_t vector3_normalized(vector3_t const* vector, vector3_t* normalized)
     return VECTOR3_ERR_OK;
 }
 
+vector3_err_t vector3_normalized(vector3_t const* vector, vector3_t* normalized)
+{
+    if (vector == NULL || normalized == NULL) {
+        return VECTOR3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(vector3_normalized, 9UL, 24UL);
+
+#ifdef LINALG_FAST_NORMALIZE
+    return vector3_normalized_fast(vector, normalized);
+#else
+    return vector3_normalized_precise(vector, normalized);
+#endif
+}
+
+vector3_err_t vector3_normalized_fast(vector3_t const* vector,
+                                      vector3_t* normalized)
+{
+    if (vector == NULL || normalized == NULL) {
+        return VECTOR3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(vector3_normalized_fast, 11UL, 24UL);
+
+    vector3_data_t dot = vector->data[0U] * vector->data[0U] +
+                         vector->data[1U] * vector->data[1U] +
+                         vector->data[2U] * vector->data[2U];
+
+    if (!isnormal(dot)) {
+        return vector3_normalized_precise(vector, normalized);
+    }
+
+    vector3_data_t magnitude_inv = linalg_rsqrt(dot);
+
+    for (vector3_size_t index = 0UL; index < 3UL; ++index) {
+        normalized->data[index] = vector->data[index] * magnitude_inv;
+    }
+
+    return VECTOR3_ERR_OK;
+}
+
+vector3_err_t vector3_normalized_fast_batch(vector3_t const* vectors,
+                                            vector3_t* normalized,
+                                            vector3_size_t count)
+{
+    if (vectors == NULL || normalized == NULL) {
+        return VECTOR3_ERR_NULL;
+    }
+
+    LINALG_PROFILE_FUNCTION(vector3_normalized_fast_batch,
+                            11UL * count,
+                            24UL * count);
+
+    vector3_err_t result = VECTOR3_ERR_OK;
+
+    for (vector3_size_t index = 0UL; index < count; ++index) {
+        vector3_t const* vector = &vectors[index];
+
+        vector3_data_t dot = vector->data[0U] * vector->data[0U] +
+                             vector->data[1U] * vector->data[1U] +
+                             vector->data[2U] * vector->data[2U];
+
+        if (!isnormal(dot)) {
+            if (vector3_normalized_precise(vector, &normalized[index]) !=
+                VECTOR3_ERR_OK) {
+                normalized[index] = *vector;
+                result = VECTOR3_ERR_FAIL;
+            }
+            continue;
+        }
+
+        vector3_data_t magnitude_inv = linalg_rsqrt(dot);
+
+        normalized[index].data[0U] = vector->data[0U] * magnitude_inv;
+        normalized[index].data[1U] = vector->data[1U] * magnitude_inv;
+        normalized[index].data[2U] = vector->data[2U] * magnitude_inv;
+    }
+
+    return result;
+}
+
 vector3_err_t vector3_negated(vector3_t const* vector, vector3_t* negated)
 {
     if (vector == NULL || negated == NULL) {
         return VECTOR3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector3_negated, 3UL, 24UL);
+
     for (vector3_size_t index = 0UL; index < 3UL; ++index) {
         negated->data[index] = -vector->data[index];
     }
@@ -165,6 +277,8 @@ vector3_err_t vector3_print(vector3_t const* vector, char const* endline)
         return VECTOR3_ERR_NULL;
     }
 
+    LINALG_PROFILE_FUNCTION(vector3_print, 0, 12UL);
+
     printf("[ ");
 
     for (vector3_size_t index = 0UL; index < 3UL; ++index) {
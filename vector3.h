@@ -51,6 +51,18 @@
     vector3_err_t vector3_normalized(vector3_t const* vector,
                                     vector3_t* normalized);
 
+    // Approximate variants using a hardware reciprocal square root with one
+    // Newton-Raphson step, see linalg_rsqrt.h for the error bound. A squared
+    // magnitude that is subnormal or not finite takes the precise path
+    // instead. The batch variant copies zero vectors through unchanged and
+    // reports VECTOR3_ERR_FAIL after processing the whole array.
+    vector3_err_t vector3_normalized_fast(vector3_t const* vector,
+                                        vector3_t* normalized);
+
+    vector3_err_t vector3_normalized_fast_batch(vector3_t const* vectors,
+                                                vector3_t* normalized,
+                                                vector3_size_t count);
+
     vector3_err_t vector3_magnitude(vector3_t const* vector,
                                     vector3_data_t* magnitude);
 